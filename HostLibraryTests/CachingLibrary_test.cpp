@@ -32,10 +32,13 @@
 #include <Tensile/ContractionProblemPredicates.hpp>
 #include <Tensile/ContractionProblemProperties.hpp>
 #include <Tensile/ContractionSolution.hpp>
+#include <Tensile/Debug.hpp>
 #include <Tensile/Distance.hpp>
 #include <Tensile/ExactLogicLibrary.hpp>
 #include <Tensile/MasterSolutionLibrary.hpp>
+#include <Tensile/SolutionCacheFile.hpp>
 
+#include <cstdio>
 #include <memory>
 #include <random>
 
@@ -87,6 +90,186 @@ TEST(Cache, Threaded)
     }
 }
 
+namespace
+{
+    // Key whose fingerprint deliberately collides for different ids.
+    struct CollidingKey
+    {
+        int fingerprint;
+        int id;
+
+        bool operator==(CollidingKey const& rhs) const
+        {
+            return fingerprint == rhs.fingerprint && id == rhs.id;
+        }
+    };
+} // namespace
+
+namespace Tensile
+{
+    template <>
+    struct CacheKeyTraits<CollidingKey>
+    {
+        static size_t hash(CollidingKey const& key)
+        {
+            return key.fingerprint;
+        }
+
+        static bool fingerprintEqual(CollidingKey const& lhs, CollidingKey const& rhs)
+        {
+            return lhs.fingerprint == rhs.fingerprint;
+        }
+
+        static size_t heapBytes(CollidingKey const& key)
+        {
+            return 0;
+        }
+    };
+} // namespace Tensile
+
+TEST(Cache, FingerprintCollision)
+{
+    using namespace Tensile;
+
+    CacheMap<int, CollidingKey> cache(-1);
+
+    cache.add(1, CollidingKey{7, 1});
+    EXPECT_EQ(1, cache.find(CollidingKey{7, 1}));
+    EXPECT_EQ(-1, cache.find(CollidingKey{7, 2}));
+
+    cache.add(2, CollidingKey{7, 2});
+    EXPECT_EQ(1, cache.find(CollidingKey{7, 1}));
+    EXPECT_EQ(2, cache.find(CollidingKey{7, 2}));
+    EXPECT_EQ(-1, cache.find(CollidingKey{7, 3}));
+}
+
+TEST(Cache, Growth)
+{
+    using namespace Tensile;
+
+    CacheMap<int, int> cache(-1);
+
+    for(int i = 0; i < 10000; i++)
+        cache.add(i * 2, i);
+
+    for(int i = 0; i < 10000; i++)
+        EXPECT_EQ(i * 2, cache.find(i));
+
+    EXPECT_EQ(-1, cache.find(10000));
+}
+
+TEST(Cache, BoundedEntries)
+{
+    using namespace Tensile;
+
+    CacheMap<int, int> cache(-1, 100);
+
+    for(int i = 0; i < 100; i++)
+        cache.add(i * 2, i);
+
+    EXPECT_EQ(100, cache.size());
+    EXPECT_EQ(0, cache.evictions());
+
+    // Referenced entries get a second chance.
+    EXPECT_EQ(10, cache.find(5));
+
+    for(int i = 100; i < 150; i++)
+        cache.add(i * 2, i);
+
+    EXPECT_EQ(100, cache.size());
+    EXPECT_EQ(50, cache.evictions());
+
+    EXPECT_EQ(-1, cache.find(0));
+    EXPECT_EQ(10, cache.find(5));
+    EXPECT_EQ(-1, cache.find(6));
+    EXPECT_EQ(298, cache.find(149));
+}
+
+TEST(Cache, BoundedBytes)
+{
+    using namespace Tensile;
+
+    size_t const maxBytes = 16 * 1024;
+
+    CacheMap<int, int> cache(-1, 0, maxBytes);
+
+    for(int i = 0; i < 10000; i++)
+        cache.add(i, i);
+
+    EXPECT_GT(cache.size(), 0);
+    EXPECT_LT(cache.size(), maxBytes / sizeof(int));
+    EXPECT_GT(cache.evictions(), 0);
+    EXPECT_EQ(9999, cache.find(9999));
+}
+
+TEST(Cache, ParseSize)
+{
+    using namespace Tensile;
+
+    auto parse = [](char const* text, size_t& entries, size_t& bytes) {
+        entries = bytes = 7;
+        return Debug::ParseSolutionCacheSize(text, entries, bytes);
+    };
+
+    size_t entries, bytes;
+
+    EXPECT_TRUE(parse("4096", entries, bytes));
+    EXPECT_EQ(entries, 4096);
+    EXPECT_EQ(bytes, 7);
+
+    // Decimal, even with a leading zero.
+    EXPECT_TRUE(parse("010", entries, bytes));
+    EXPECT_EQ(entries, 10);
+
+    EXPECT_TRUE(parse("256M", entries, bytes));
+    EXPECT_EQ(entries, 7);
+    EXPECT_EQ(bytes, size_t(256) << 20);
+
+    EXPECT_TRUE(parse("2k", entries, bytes));
+    EXPECT_EQ(bytes, 2048);
+
+    EXPECT_TRUE(parse("1G", entries, bytes));
+    EXPECT_EQ(bytes, size_t(1) << 30);
+
+    for(char const* text : {"", "0x100", "-5", "+5", " 5", "5 ", "5KB", "5T", "M", "5MK",
+                            "99999999999999999999", "99999999999999999G"})
+    {
+        EXPECT_FALSE(parse(text, entries, bytes)) << text;
+        EXPECT_EQ(entries, 7) << text;
+        EXPECT_EQ(bytes, 7) << text;
+    }
+}
+
+TEST(Cache, ThreadedBounded)
+{
+    using namespace Tensile;
+    CacheMap<int, int> cache(-1, 8);
+
+#pragma omp parallel num_threads(32)
+    {
+        int seed = 0;
+#ifdef _OPENMP
+        seed = omp_get_thread_num();
+#endif
+        std::uniform_int_distribution<int> dist(0, 100);
+        std::mt19937                       rng(seed);
+
+        for(int i = 0; i < 10000; i++)
+        {
+            int key   = dist(rng);
+            int value = key + 1;
+
+            int lookup = cache.find(key);
+            if(lookup != -1)
+                EXPECT_EQ(lookup, value);
+
+            cache.add(value, key);
+        }
+    }
+
+    EXPECT_LE(cache.size(), 8);
+}
+
 TEST(Hashing, TensorDescriptor)
 {
     using namespace Tensile;
@@ -233,6 +416,23 @@ TEST(Hashing, ContractionProblem)
     EXPECT_EQ(std::hash<ContractionProblem>()(m), std::hash<ContractionProblem>()(n));
 }
 
+TEST(Hashing, ContractionProblemFingerprint)
+{
+    using namespace Tensile;
+
+    ContractionProblem a = ContractionProblem::GEMM(false, true, 5, 7, 9, 5, 5, 5, 3.0, false, 5);
+    ContractionProblem b = ContractionProblem::GEMM(false, true, 5, 7, 9, 5, 5, 5, 3.0, false, 5);
+    ContractionProblem c = ContractionProblem::GEMM(false, true, 5, 7, 9, 7, 5, 5, 3.0, false, 5);
+    ContractionProblem d = ContractionProblem::GEMM(true, true, 5, 7, 9, 5, 5, 5, 3.0, false, 5);
+
+    EXPECT_EQ(a.fingerprint(), b.fingerprint());
+    EXPECT_NE(a.fingerprint(), c.fingerprint());
+    EXPECT_NE(a.fingerprint(), d.fingerprint());
+
+    b.setWorkspaceSize(1024);
+    EXPECT_NE(a.fingerprint(), b.fingerprint());
+}
+
 TEST(Hashing, AMDGPU)
 {
     using namespace Tensile;
@@ -398,6 +598,94 @@ TEST(CachingLibrary, Simple)
     EXPECT_EQ(theSolution3, theSolution3_cached);
 }
 
+TEST(CachingLibrary, PersistentCache)
+{
+    using namespace Tensile;
+
+    auto Solution0 = std::make_shared<ContractionSolution>();
+    auto Solution1 = std::make_shared<ContractionSolution>();
+
+    Solution0->index = 0;
+    Solution1->index = 1;
+
+    SolutionMap<ContractionSolution> map({{0, Solution0}, {1, Solution1}});
+
+    auto resolve = [&map](SolutionCacheFile::Record const& record,
+                          AMDGPU const&) -> std::shared_ptr<ContractionSolution> {
+        auto iter = map.find(record.solutionIndex);
+        return iter == map.end() ? nullptr : iter->second;
+    };
+
+    AMDGPU gpu;
+
+    auto Problem0 = ContractionProblem::GEMM(false, false, 4, 4, 4, 4, 4, 4, 1.2, false, 1);
+    auto Problem1 = ContractionProblem::GEMM(false, false, 6, 6, 6, 6, 6, 6, 1.2, false, 1);
+
+    std::string filename = ::testing::TempDir() + "CachingLibrary_PersistentCache.dat";
+    std::remove(filename.c_str());
+
+    {
+        CachingLibrary<ContractionProblem> lib(
+            std::make_shared<SingleContractionLibrary>(Solution1));
+        lib.setPersistentCache(std::make_shared<SolutionCacheFile>(filename, 42), resolve);
+
+        EXPECT_EQ(Solution1, lib.findBestSolution(Problem0, gpu));
+        EXPECT_TRUE(lib.persistentCacheDirty());
+    }
+
+    // Nothing is written until the cache is saved.
+    EXPECT_EQ(0, SolutionCacheFile(filename, 42).size());
+
+    {
+        CachingLibrary<ContractionProblem> lib(
+            std::make_shared<SingleContractionLibrary>(Solution1));
+        lib.setPersistentCache(std::make_shared<SolutionCacheFile>(filename, 42), resolve);
+
+        EXPECT_EQ(Solution1, lib.findBestSolution(Problem0, gpu));
+        EXPECT_TRUE(lib.savePersistentCache());
+        EXPECT_FALSE(lib.persistentCacheDirty());
+    }
+
+    {
+        SolutionCacheFile file(filename, 42);
+        EXPECT_EQ(1, file.size());
+
+        auto record = file.find(Problem0.fingerprint(), gpu);
+        ASSERT_NE(nullptr, record);
+        EXPECT_EQ(1, record->solutionIndex);
+        EXPECT_EQ(-1, record->placeholder);
+        EXPECT_EQ(nullptr, file.find(Problem1.fingerprint(), gpu));
+    }
+
+    {
+        // The file's selection wins over the sub-library's.
+        CachingLibrary<ContractionProblem> lib(
+            std::make_shared<SingleContractionLibrary>(Solution0));
+        lib.setPersistentCache(std::make_shared<SolutionCacheFile>(filename, 42), resolve);
+
+        EXPECT_EQ(Solution1, lib.findBestSolution(Problem0, gpu));
+        EXPECT_EQ(Solution0, lib.findBestSolution(Problem1, gpu));
+        EXPECT_TRUE(lib.savePersistentCache());
+        EXPECT_EQ(2, SolutionCacheFile(filename, 42).size());
+    }
+
+    {
+        // A file written for a different library is ignored.
+        CachingLibrary<ContractionProblem> lib(
+            std::make_shared<SingleContractionLibrary>(Solution0));
+        lib.setPersistentCache(std::make_shared<SolutionCacheFile>(filename, 43), resolve);
+
+        EXPECT_EQ(0, lib.persistentCache()->size());
+        EXPECT_EQ(Solution0, lib.findBestSolution(Problem0, gpu));
+        EXPECT_TRUE(lib.savePersistentCache());
+    }
+
+    EXPECT_EQ(0, SolutionCacheFile(filename, 42).size());
+    EXPECT_EQ(1, SolutionCacheFile(filename, 43).size());
+
+    std::remove(filename.c_str());
+}
+
 TEST(CachingLibrary, FlagsDiff)
 {
     // This test is to ensure that the CachingLibrary differentiates between
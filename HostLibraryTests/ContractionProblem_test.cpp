@@ -27,6 +27,7 @@
 #include <gtest/gtest.h>
 
 #include <Tensile/ContractionProblem.hpp>
+#include <Tensile/ContractionProblemProperties.hpp>
 
 #include <cstddef>
 
@@ -156,6 +157,93 @@ TEST(ContractionProblem, FromOperationIdentifier)
     EXPECT_EQ(mirrorProblem.operationIdentifier(), identifier);
 }
 
+TEST(ContractionProblem, InternedOperation)
+{
+    auto nn      = ContractionProblem::GEMM(false, false, 4, 4, 4, 4, 4, 4, 1.5, false, 2);
+    auto nnLarge = ContractionProblem::GEMM(false, false, 64, 32, 16, 64, 16, 64, 1.5, false, 5);
+    auto nt      = ContractionProblem::GEMM(false, true, 4, 4, 4, 4, 4, 4, 1.5, false, 2);
+
+    EXPECT_EQ(nn.operationId(), nnLarge.operationId());
+    EXPECT_NE(nn.operationId(), nt.operationId());
+    EXPECT_EQ(&nn.operationIdentifier(), &nnLarge.operationIdentifier());
+    EXPECT_EQ(ContractionProblem::OperationId(nt.operationIdentifier()), nt.operationId());
+
+    // Problems with different structures that name the same operation share it.
+    auto nnNoBeta = ContractionProblem::GEMM(false, false, 4, 4, 4, 4, 4, 4, 0.0, false, 2);
+    EXPECT_EQ(nn.operationId(), nnNoBeta.operationId());
+
+    // An id handed out before any problem has the operation is kept by it.
+    std::string identifier = "Contraction_l_AlikC_BljkC_Cijk_Dijk";
+    uint32_t    id         = ContractionProblem::OperationId(identifier);
+
+    std::vector<size_t> sizes{5, 6, 4, 2};
+    std::vector<size_t> empty;
+    auto                problem = ContractionProblem::FromIndexSizes(identifier,
+                                                      sizes,
+                                                      DataType::ComplexFloat,
+                                                      empty,
+                                                      DataType::ComplexFloat,
+                                                      empty,
+                                                      DataType::ComplexFloat,
+                                                      empty,
+                                                      DataType::ComplexFloat,
+                                                      empty,
+                                                      2.0);
+    EXPECT_EQ(problem.operationId(), id);
+    EXPECT_EQ(problem.operationIdentifier(), identifier);
+    EXPECT_EQ(problem.aNames(), "lik");
+    EXPECT_EQ(problem.bNames(), "ljk");
+    EXPECT_EQ(problem.sumNames(), "l");
+
+    ContractionProblem defaulted;
+    EXPECT_EQ(defaulted.operationId(), 0);
+    EXPECT_EQ(defaulted.operationIdentifier(), "");
+}
+
+TEST(ContractionProblem, View)
+{
+    auto problem = ContractionProblem::GEMM(true, false, 17, 23, 31, 40, 40, 20, 1.0, false, 3);
+
+    ContractionProblemView view(problem);
+
+    std::vector<std::shared_ptr<Property<ContractionProblem>>> properties
+        = {std::make_shared<Contraction::FreeSizeA>(),
+           std::make_shared<Contraction::FreeSizeB>(),
+           std::make_shared<Contraction::BatchSize>(),
+           std::make_shared<Contraction::BoundSize>()};
+    for(size_t index = 0; index < 3; index++)
+    {
+        auto strideA = std::make_shared<Contraction::AStride>();
+        auto strideD = std::make_shared<Contraction::DStride>();
+
+        strideA->index = strideD->index = index;
+        properties.insert(properties.end(), {strideA, strideD});
+    }
+
+    for(auto const& property : properties)
+    {
+        int value = ContractionProblemView::PropertyValue(*property);
+        ASSERT_GE(value, 0) << property->toString();
+        EXPECT_EQ(view.get(value), (*property)(problem)) << property->toString();
+    }
+
+    // Each value is computed once, however many times it is read.
+    size_t computed = view.computeCount();
+    for(auto const& property : properties)
+        view.get(ContractionProblemView::PropertyValue(*property));
+    EXPECT_EQ(view.computeCount(), computed);
+
+    ContractionProblemView unshared(problem, false);
+    unshared.get(ContractionProblemView::Size0);
+    unshared.get(ContractionProblemView::Size0);
+    EXPECT_EQ(unshared.computeCount(), 2);
+
+    // Indices past the end of a run are read from the problem.
+    Contraction::FreeSizeA outOfRange;
+    outOfRange.index = ContractionProblemView::MaxIndex;
+    EXPECT_EQ(ContractionProblemView::PropertyValue(outOfRange), -1);
+}
+
 #if 0
 TEST(ContractionProblem, Simple)
 {
@@ -33,6 +33,7 @@
 #include <Tensile/ContractionProblemProperties.hpp>
 #include <Tensile/Distance.hpp>
 #include <Tensile/ExactLogicLibrary.hpp>
+#include <Tensile/PredicateProgram.hpp>
 
 using namespace Tensile;
 
@@ -218,3 +219,122 @@ TEST(ContractionSelectionLibraryTest, TransposeSelection)
     mlib.solutions = map;
     mlib.library   = lib;
 }
+
+TEST(ContractionSelectionLibraryTest, BatchedSelection)
+{
+    AMDGPU v20(AMDGPU::Processor::gfx906, 60, "AMD Radeon Vega 7");
+    AMDGPU v10(AMDGPU::Processor::gfx900, 64, "AMD Radeon Vega Frontier Edition");
+
+    auto regionSolution  = std::make_shared<ContractionSolution>();
+    auto NTSolution      = std::make_shared<ContractionSolution>();
+    auto genericSolution = std::make_shared<ContractionSolution>();
+
+    // M in [6000, 8000) on gfx906 -> regionSolution
+    using SizeInRange = Predicates::Contraction::SizeInRange;
+    using Range       = Predicates::Contraction::Range;
+
+    ContractionProblemPredicate isRegion(std::make_shared<SizeInRange>(0, Range{6000, 8000}));
+    auto                        regionLib = std::make_shared<ContractionProblemSelectionLibrary>(
+        std::initializer_list<ContractionProblemSelectionLibrary::Row>{
+            {isRegion, std::make_shared<SingleContractionLibrary>(regionSolution)}});
+
+    // NT problems -> NTSolution, everything else falls through.
+    auto mapLib      = std::make_shared<ContractionProblemMapLibrary>();
+    mapLib->property = std::make_shared<Contraction::OperationIdentifier>();
+    mapLib->map["Contraction_l_Ailk_Bjlk_Cijk_Dijk"]
+        = std::make_shared<SingleContractionLibrary>(NTSolution);
+
+    auto isV20 = std::make_shared<Predicates::IsSubclass<Hardware, AMDGPU>>(
+        std::make_shared<Predicates::GPU::ProcessorEqual>(AMDGPU::Processor::gfx906));
+    HardwarePredicate allHardware(std::make_shared<Predicates::True<Hardware>>());
+
+    ContractionHardwareSelectionLibrary lib(
+        {{HardwarePredicate(isV20), regionLib},
+         {allHardware, mapLib},
+         {allHardware, std::make_shared<SingleContractionLibrary>(genericSolution)}});
+
+    std::vector<ContractionProblem> problems{
+        ContractionProblem::GEMM(false, false, 7000, 6500, 1000, 7000, 1000, 7000, 1.0, false, 1),
+        ContractionProblem::GEMM(false, true, 4, 4, 4, 4, 4, 4, 1.2, false, 1),
+        ContractionProblem::GEMM(false, false, 5000, 2000, 1000, 5000, 1000, 5000, 1.0, false, 1),
+        ContractionProblem::GEMM(false, true, 7000, 4, 4, 7000, 4, 7000, 1.2, false, 1)};
+
+    for(AMDGPU const* gpu : {&v20, &v10})
+    {
+        std::vector<size_t>                               indices{0, 1, 2, 3};
+        std::vector<std::shared_ptr<ContractionSolution>> solutions(problems.size());
+        std::vector<double> fitness(problems.size(), std::numeric_limits<double>::max());
+
+        lib.findBestSolutions(problems, indices, *gpu, solutions, fitness);
+
+        for(size_t i = 0; i < problems.size(); i++)
+            EXPECT_EQ(solutions[i], lib.findBestSolution(problems[i], *gpu)) << i;
+    }
+
+    std::vector<std::shared_ptr<ContractionSolution>> solutions(4);
+    std::vector<double>                               fitness(4);
+    lib.findBestSolutions(problems, {0, 1, 2, 3}, v20, solutions, fitness);
+
+    EXPECT_EQ(solutions[0], regionSolution);
+    EXPECT_EQ(solutions[1], NTSolution);
+    EXPECT_EQ(solutions[2], genericSolution);
+    EXPECT_EQ(solutions[3], regionSolution);
+
+    // Only the named entries are written.
+    solutions.assign(4, nullptr);
+    lib.findBestSolutions(problems, {1}, v10, solutions, fitness);
+
+    EXPECT_EQ(solutions[0], nullptr);
+    EXPECT_EQ(solutions[1], NTSolution);
+    EXPECT_EQ(solutions[2], nullptr);
+}
+
+TEST(ContractionSelectionLibraryTest, CompiledRowPredicate)
+{
+    using namespace Predicates::Contraction;
+
+    auto problem = ContractionProblem::GEMM(false, false, 8, 8, 32, 8, 32, 8, 1.0, false, 1);
+    ContractionProblemView view(problem);
+    AMDGPU                 gpu;
+
+    ProblemPredicate<ContractionProblem> row(std::make_shared<SizeMultiple>(0, 8));
+    EXPECT_TRUE(row.program.compiledFrom(row.value.get()));
+    EXPECT_TRUE(row(view, gpu));
+
+    // A value assigned after construction is evaluated as a tree.
+    row.value = std::make_shared<SizeMultiple>(0, 16);
+    EXPECT_FALSE(row.program.compiledFrom(row.value.get()));
+    EXPECT_FALSE(row(view, gpu));
+    EXPECT_EQ(row(view, gpu), row(problem, gpu));
+}
+
+TEST(ContractionSelectionLibraryTest, CompiledRowsInAllAndBatchedLookups)
+{
+    using namespace Predicates::Contraction;
+
+    auto problem = ContractionProblem::GEMM(false, false, 8, 8, 32, 8, 32, 8, 1.0, false, 1);
+
+    AMDGPU gpu;
+    auto   rowSolution = std::make_shared<ContractionSolution>();
+    auto   predicate   = std::make_shared<SizeMultiple>(0, 8);
+
+    ContractionProblemSelectionLibrary lib;
+    lib.rows.push_back(std::make_pair(ProblemPredicate<ContractionProblem>(predicate),
+                                      std::make_shared<SingleContractionLibrary>(rowSolution)));
+
+    // The program keeps the divisor it was compiled with, so a change to the
+    // tree shows which of the two a lookup evaluated.
+    predicate->value = 16;
+    ASSERT_FALSE((*predicate)(problem));
+
+    auto all = lib.findAllSolutions(problem, gpu);
+    EXPECT_EQ(all.size(), 1u);
+    EXPECT_EQ(all.count(rowSolution), 1u);
+
+    std::vector<ContractionProblem>                   problems{problem, problem};
+    std::vector<std::shared_ptr<ContractionSolution>> solutions(problems.size());
+    std::vector<double>                               fitness(problems.size());
+    lib.findBestSolutions(problems, {0, 1}, gpu, solutions, fitness);
+    EXPECT_EQ(solutions[0], rowSolution);
+    EXPECT_EQ(solutions[1], rowSolution);
+}
@@ -34,6 +34,9 @@
 #include <Tensile/DecisionTreeLibrary.hpp>
 #include <Tensile/ExactLogicLibrary.hpp>
 
+#include <cmath>
+#include <random>
+
 using namespace Tensile;
 using namespace DecisionTree;
 
@@ -161,6 +164,78 @@ TEST(DecisionTree, MultiStepPrediction)
     EXPECT_EQ(test_tree.predict(test_input2), false); // Expected: start->1->false
 }
 
+TEST(DecisionTree, CompiledPrediction)
+{
+    std::mt19937                          rng(17);
+    std::uniform_real_distribution<float> value(0.f, 1000.f);
+
+    // Random valid trees, with children after their parents and some nodes
+    // reachable along several paths.
+    std::vector<DTree> trees;
+    for(int t = 0; t < 37; t++)
+    {
+        int               size = 1 + rng() % 12;
+        std::vector<Node> nodes;
+        for(int i = 0; i < size; i++)
+        {
+            int next[2];
+            for(int& n : next)
+            {
+                int pick = rng() % 4;
+                if(pick == 0 || i + 1 == size)
+                    n = IDX_RETURN_FALSE;
+                else if(pick == 1)
+                    n = IDX_RETURN_TRUE;
+                else
+                    n = i + 1 + rng() % (size - i - 1);
+            }
+            nodes.push_back({int(rng() % 3), std::floor(value(rng)), next[0], next[1]});
+        }
+        trees.emplace_back(nodes);
+    }
+
+    CompiledForest compiled;
+    ASSERT_TRUE(compiled.compile(trees, 3));
+    ASSERT_EQ(compiled.size(), trees.size());
+
+    for(int i = 0; i < 1000; i++)
+    {
+        // Whole numbers, so keys often equal thresholds.
+        Key key{{std::floor(value(rng)), std::floor(value(rng)), std::floor(value(rng))}};
+
+        for(size_t t = 0; t < trees.size(); t++)
+            EXPECT_EQ(compiled.predict(t, key), trees[t].predict(key));
+
+        for(size_t first = 0; first < trees.size(); first += CompiledForest::BlockSize)
+        {
+            size_t   count = std::min(CompiledForest::BlockSize, trees.size() - first);
+            uint32_t block = compiled.predictBlock(first, count, key);
+            for(size_t t = 0; t < count; t++)
+                EXPECT_EQ(bool(block & (1u << t)), trees[first + t].predict(key));
+        }
+    }
+}
+
+TEST(DecisionTree, CompiledInvalidTrees)
+{
+    CompiledForest compiled;
+
+    std::vector<DTree> empty{DTree{{}}};
+    EXPECT_FALSE(compiled.compile(empty, 3));
+    EXPECT_EQ(compiled.size(), 0);
+
+    std::vector<DTree> childOOB{DTree{{{0, 700.f, IDX_RETURN_TRUE, 7}}}};
+    EXPECT_FALSE(compiled.compile(childOOB, 3));
+
+    std::vector<DTree> circular{
+        DTree{{{0, 700.f, 1, IDX_RETURN_TRUE}, {0, 700.f, 0, IDX_RETURN_TRUE}}}};
+    EXPECT_FALSE(compiled.compile(circular, 3));
+
+    std::vector<DTree> featureOOB{DTree{{{3, 700.f, IDX_RETURN_FALSE, IDX_RETURN_TRUE}}}};
+    EXPECT_FALSE(compiled.compile(featureOOB, 3));
+    EXPECT_EQ(compiled.size(), 0);
+}
+
 /*
  * Tests for libraries.
  */
@@ -243,6 +318,39 @@ TEST(DecisionTree, DecisionTreeLibrary)
     EXPECT_EQ(dtreelib->findBestSolution(Problem0, gpu), Solution0);
     EXPECT_EQ(dtreelib->findBestSolution(Problem1, gpu), Solution1);
     EXPECT_EQ(dtreelib->findBestSolution(Problem2, gpu), Solution3); // No match, goes to fallback
+
+    // Same results from the compiled forest.
+    ASSERT_TRUE(forest->compile());
+    EXPECT_EQ(dtreelib->findBestSolution(Problem0, gpu), Solution0);
+    EXPECT_EQ(dtreelib->findBestSolution(Problem1, gpu), Solution1);
+    EXPECT_EQ(dtreelib->findBestSolution(Problem2, gpu), Solution3);
+
+    // A tree whose library rejects the problem passes it on to the next one.
+    Solution0->problemPredicate = std::make_shared<Predicates::Contraction::SizeMultiple>(0, 100);
+    Solution0->problemProgram   = {};
+    auto Problem3
+        = ContractionProblem::GEMM(false, false, 850, 800, 800, 850, 800, 850, 1.0, false, 1);
+    EXPECT_EQ(dtreelib->findBestSolution(Problem3, gpu), Solution1);
+
+    // Batched lookups match single ones, from both the compiled and plain forest.
+    std::vector<ContractionProblem> problems{Problem0, Problem1, Problem2, Problem3, Problem0};
+    std::vector<size_t>             indices{0, 1, 2, 3};
+
+    for(bool compiled : {true, false})
+    {
+        if(!compiled)
+            forest->compiled.clear();
+
+        std::vector<std::shared_ptr<ContractionSolution>> solutions(problems.size());
+        std::vector<double>                               fitness(problems.size(), 0.0);
+        dtreelib->findBestSolutions(problems, indices, gpu, solutions, fitness);
+
+        EXPECT_EQ(solutions[0], Solution0) << compiled;
+        EXPECT_EQ(solutions[1], Solution1) << compiled;
+        EXPECT_EQ(solutions[2], Solution3) << compiled;
+        EXPECT_EQ(solutions[3], Solution1) << compiled;
+        EXPECT_EQ(solutions[4], nullptr) << compiled;
+    }
 }
 
 TEST(DecisionTree, DecisionTreeMultiLibrary)
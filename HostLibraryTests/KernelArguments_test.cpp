@@ -276,3 +276,71 @@ TEST(KernelArguments, Iterator)
     EXPECT_EQ(testIt, args.begin());
     EXPECT_THROW(auto a = static_cast<char>(testIt), std::bad_cast);
 }
+
+TEST(KernelArguments, Reset)
+{
+    KernelArguments args(false);
+
+    for(uint32_t i = 0; i < 3; i++)
+        args.append<uint32_t>("x", i);
+    args.append<uint64_t>("y", 7);
+    EXPECT_EQ(args.size(), 3 * sizeof(uint32_t) + 4 + sizeof(uint64_t));
+
+    // Refilling after a reset gives the same bytes as a fresh object.
+    args.reset(true);
+    EXPECT_EQ(args.size(), 0);
+
+    KernelArguments fresh(true);
+    for(auto* a : {&args, &fresh})
+    {
+        a->append<uint16_t>("s", 3);
+        a->append<double>("d", 2.5);
+    }
+    ASSERT_EQ(args.size(), fresh.size());
+    EXPECT_EQ(memcmp(args.data(), fresh.data(), args.size()), 0);
+
+    // Arguments past the inline storage move to the heap and keep their values.
+    args.reset(false);
+    size_t count = KernelArguments::InlineBytes / sizeof(uint64_t) + 5;
+    for(uint64_t i = 0; i < count; i++)
+        args.append<uint64_t>("v", i);
+
+    ASSERT_EQ(args.size(), count * sizeof(uint64_t));
+    auto values = static_cast<uint64_t const*>(args.data());
+    for(uint64_t i = 0; i < count; i++)
+        EXPECT_EQ(values[i], i);
+
+    args.reset(false);
+    args.append<uint32_t>("x", 9);
+    EXPECT_EQ(args.size(), sizeof(uint32_t));
+    EXPECT_EQ(*static_cast<uint32_t const*>(args.data()), 9);
+}
+
+TEST(KernelArguments, Overwrite)
+{
+    KernelArguments args(true);
+
+    args.append<uint32_t>("x", 1);
+    args.append<double>("y", 2.0);
+    args.append<uint16_t>("z", 3);
+
+    EXPECT_EQ(args.offset("x"), 0);
+    EXPECT_EQ(args.offset("y"), 8);
+    EXPECT_EQ(args.offset("z"), 16);
+    EXPECT_EQ(args.offset("w"), -1);
+
+    args.overwrite<double>(args.offset("y"), 4.5);
+    EXPECT_THROW(args.overwrite<uint32_t>(args.offset("z"), 5), std::runtime_error);
+
+    double y;
+    memcpy(&y, static_cast<uint8_t const*>(args.data()) + 8, sizeof(y));
+    EXPECT_EQ(y, 4.5);
+
+    std::ostringstream msg;
+    msg << args;
+    EXPECT_NE(msg.str().find("(4.5)"), std::string::npos) << msg.str();
+
+    KernelArguments unlogged(false);
+    unlogged.append<uint32_t>("x", 1);
+    EXPECT_THROW(unlogged.offset("x"), std::runtime_error);
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <Tensile/MagicNumber.hpp>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+using namespace Tensile;
+
+namespace
+{
+    // Division as the kernels do it with an algorithm 2 magic number.
+    uint32_t DivideAlg2(uint32_t n, MagicNumber magic)
+    {
+        uint32_t q = (uint64_t(n) * magic.value) >> 32;
+        if(magic.shift & 0x80000000)
+            return (((n - q) >> 1) + q) >> ((magic.shift & 0x7FFFFFFF) - 1);
+        return q >> magic.shift;
+    }
+
+    std::vector<uint32_t> RandomDivisors(size_t count)
+    {
+        std::mt19937                            rng(17);
+        std::uniform_int_distribution<uint32_t> small(1, 4096);
+        std::uniform_int_distribution<uint32_t> large(4097, 1u << 30);
+        std::uniform_int_distribution<int>      pick(0, 3);
+
+        std::vector<uint32_t> rv;
+        for(size_t i = 0; i < count; i++)
+            rv.push_back(pick(rng) ? small(rng) : large(rng));
+        return rv;
+    }
+}
+
+TEST(MagicNumber, Constexpr)
+{
+    static_assert(MagicNumberAlg2(0).value == 0, "Dividing by 0 gives 0.");
+
+    constexpr MagicNumber seven = MagicNumberAlg2(7);
+    EXPECT_EQ(DivideAlg2(100, seven), 14);
+    EXPECT_EQ(DivideAlg2(0xFFFFFFFF, seven), 0xFFFFFFFFu / 7);
+}
+
+TEST(MagicNumber, MatchesUncached)
+{
+    auto divisors = RandomDivisors(20000);
+    for(uint32_t x = 1; x < 2 * MagicNumberTableSize; x++)
+        divisors.push_back(x);
+
+    // Twice, so the second pass reads values cached by the first.
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(uint32_t x : divisors)
+        {
+            auto alg1 = CachedMagicNumber(1, x);
+            auto alg2 = CachedMagicNumber(2, x);
+
+            ASSERT_EQ(alg1.value, MagicNumberAlg1(x).value) << x;
+            ASSERT_EQ(alg1.shift, MagicNumberAlg1(x).shift) << x;
+            ASSERT_EQ(alg2.value, MagicNumberAlg2(x).value) << x;
+            ASSERT_EQ(alg2.shift, MagicNumberAlg2(x).shift) << x;
+        }
+    }
+
+    EXPECT_EQ(CachedMagicNumber(2, 0).value, 0);
+    EXPECT_THROW(CachedMagicNumber(3, 7), std::runtime_error);
+}
+
+TEST(MagicNumber, Divides)
+{
+    std::mt19937                            rng(5);
+    std::uniform_int_distribution<uint32_t> dividend;
+
+    for(uint32_t d : RandomDivisors(2000))
+    {
+        auto magic = CachedMagicNumber(2, d);
+        for(int i = 0; i < 50; i++)
+        {
+            uint32_t n = dividend(rng);
+            ASSERT_EQ(DivideAlg2(n, magic), n / d) << n << " / " << d;
+        }
+    }
+}
+
+TEST(MagicNumber, Performance)
+{
+    // A dynamic-shape workload: a few hundred distinct sizes, each seen many times.
+    auto distinct = RandomDivisors(200);
+
+    std::mt19937                          rng(3);
+    std::uniform_int_distribution<size_t> pick(0, distinct.size() - 1);
+
+    std::vector<uint32_t> divisors;
+    for(int i = 0; i < 1000000; i++)
+        divisors.push_back(distinct[pick(rng)]);
+
+    uint64_t sum[2] = {0, 0};
+
+    auto start = std::chrono::steady_clock::now();
+    for(uint32_t x : divisors)
+        sum[0] += MagicNumberAlg2(x).value;
+    std::chrono::duration<double> uncached = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for(uint32_t x : divisors)
+        sum[1] += CachedMagicNumber(2, x).value;
+    std::chrono::duration<double> cached = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(sum[0], sum[1]);
+
+    std::cout << "uncached: " << uncached.count() << " s, cached: " << cached.count() << " s"
+              << std::endl;
+}
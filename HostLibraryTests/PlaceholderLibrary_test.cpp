@@ -0,0 +1,275 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <Tensile/ContractionLibrary.hpp>
+#include <Tensile/PlaceholderLibrary.hpp>
+#include <Tensile/SolutionCacheFile.hpp>
+#include <Tensile/Tensile.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace Tensile;
+
+namespace
+{
+    std::string solutionDocument(std::string const& name, int index)
+    {
+        return concatenate("solutions:\n"
+                           "  - name: ",
+                           name,
+                           "\n"
+                           "    sizeMapping:\n"
+                           "      globalAccumulation: 0\n"
+                           "      workspaceSizePerElemC: 0\n"
+                           "      workGroup: [1,2,3]\n"
+                           "      macroTile: [1,2,3]\n"
+                           "      threadTile: [1,2,3]\n"
+                           "      depthU: 8\n"
+                           "      globalSplitU: 1\n"
+                           "      staggerStrideShift: 3\n"
+                           "      staggerU: 32\n"
+                           "      workGroupMapping: 8\n"
+                           "      sourceKernel: false\n"
+                           "      persistentKernel: 0\n"
+                           "      persistentKernelAlongBatch: false\n"
+                           "    index: ",
+                           index,
+                           "\n"
+                           "    hardwarePredicate: { type: TruePred }\n"
+                           "    problemPredicate:  { type: TruePred }\n"
+                           "    debugKernel: false\n"
+                           "    problemType:\n"
+                           "      operationIdentifier: foo\n"
+                           "      highPrecisionAccumulate: false\n"
+                           "      useBeta: true\n"
+                           "      aType: Float\n"
+                           "      bType: Float\n"
+                           "      cType: Float\n"
+                           "      dType: Float\n"
+                           "library:\n"
+                           "  type: Single\n"
+                           "  index: ",
+                           index,
+                           "\n");
+    }
+
+    /**
+     * Writes a lazy master library with two placeholders: one for problems
+     * with an even M dimension and one for all others.
+     */
+    class PlaceholderLibraryTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::string masterDocument
+                = "solutions: []\n"
+                  "library:\n"
+                  "  type: Problem\n"
+                  "  rows:\n"
+                  "    - predicate: { type: Free0SizeMultiple, index: 0, value: 2 }\n"
+                  "      library: { type: Placeholder, value: TensileLibrary_PlaceholderEven }\n"
+                  "    - predicate: { type: TruePred }\n"
+                  "      library: { type: Placeholder, value: TensileLibrary_PlaceholderAny }\n";
+
+            write(master, masterDocument);
+            write(directory + "TensileLibrary_PlaceholderEven.yaml", solutionDocument("even", 0));
+            write(directory + "TensileLibrary_PlaceholderAny.yaml", solutionDocument("any", 1));
+        }
+
+        void TearDown() override
+        {
+            std::remove(master.c_str());
+            std::remove((directory + "TensileLibrary_PlaceholderEven.yaml").c_str());
+            std::remove((directory + "TensileLibrary_PlaceholderAny.yaml").c_str());
+        }
+
+        static void write(std::string const& filename, std::string const& contents)
+        {
+            std::ofstream out(filename, std::ios::trunc);
+            out << contents;
+        }
+
+        std::shared_ptr<MasterContractionLibrary>
+            load(std::vector<LazyLoadingInit> const& preload) const
+        {
+            return std::dynamic_pointer_cast<MasterContractionLibrary>(
+                LoadLibraryFilePreload<ContractionProblem>(master, preload));
+        }
+
+        static size_t solutionCount(MasterContractionLibrary const& library)
+        {
+            std::lock_guard<std::mutex> guard(library.solutionsGuard);
+            return library.solutions.size();
+        }
+
+        std::string directory = ::testing::TempDir();
+        std::string master    = directory + "TensileLibrary_lazy_PlaceholderTest.yaml";
+
+        AMDGPU             hardware;
+        ContractionProblem even
+            = ContractionProblem::GEMM(false, false, 4, 4, 4, 4, 4, 4, 1.5, false, 2);
+        ContractionProblem odd
+            = ContractionProblem::GEMM(false, false, 5, 4, 4, 5, 4, 5, 1.5, false, 2);
+    };
+}
+
+TEST_F(PlaceholderLibraryTest, LoadOnSelection)
+{
+    auto library = load({});
+    ASSERT_NE(library, nullptr);
+    EXPECT_EQ(solutionCount(*library), 0);
+
+    auto solution = library->findBestSolution(even, hardware);
+    ASSERT_NE(solution, nullptr);
+    EXPECT_EQ(solution->name(), "even");
+    EXPECT_EQ(solutionCount(*library), 1);
+
+    solution = library->findBestSolution(odd, hardware);
+    ASSERT_NE(solution, nullptr);
+    EXPECT_EQ(solution->name(), "any");
+    EXPECT_EQ(solutionCount(*library), 2);
+}
+
+TEST_F(PlaceholderLibraryTest, Preload)
+{
+    auto library = load({LazyLoadingInit::All});
+    ASSERT_NE(library, nullptr);
+    EXPECT_EQ(solutionCount(*library), 2);
+
+    auto solution = library->findBestSolution(odd, hardware);
+    ASSERT_NE(solution, nullptr);
+    EXPECT_EQ(solution->name(), "any");
+}
+
+TEST_F(PlaceholderLibraryTest, BackgroundPreload)
+{
+    auto library = load({LazyLoadingInit::AllBackground});
+    ASSERT_NE(library, nullptr);
+
+    library->waitForPreload();
+    EXPECT_EQ(solutionCount(*library), 2);
+
+    auto solution = library->findBestSolution(even, hardware);
+    ASSERT_NE(solution, nullptr);
+    EXPECT_EQ(solution->name(), "even");
+    EXPECT_EQ(solution->codeObjectFilename.load(), "TensileLibrary_PlaceholderEven.co");
+}
+
+TEST_F(PlaceholderLibraryTest, SelectionDuringBackgroundPreload)
+{
+    for(int iteration = 0; iteration < 10; iteration++)
+    {
+        auto library = load({LazyLoadingInit::AllBackground});
+        ASSERT_NE(library, nullptr);
+
+        std::vector<std::string> names(8);
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < names.size(); i++)
+            threads.emplace_back([&, i]() {
+                auto solution = library->findBestSolution(i % 2 ? odd : even, hardware);
+                if(solution)
+                    names[i] = solution->name();
+            });
+
+        for(auto& thread : threads)
+            thread.join();
+
+        for(size_t i = 0; i < names.size(); i++)
+            EXPECT_EQ(names[i], i % 2 ? "any" : "even");
+    }
+}
+
+TEST_F(PlaceholderLibraryTest, BackgroundPreloadMissingFile)
+{
+    std::remove((directory + "TensileLibrary_PlaceholderAny.yaml").c_str());
+
+    auto library = load({LazyLoadingInit::AllBackground});
+    ASSERT_NE(library, nullptr);
+
+    EXPECT_THROW(library->waitForPreload(), std::runtime_error);
+    EXPECT_NO_THROW(library->waitForPreload());
+    EXPECT_EQ(solutionCount(*library), 1);
+    EXPECT_THROW(library->findBestSolution(odd, hardware), std::runtime_error);
+}
+
+TEST_F(PlaceholderLibraryTest, PersistentCache)
+{
+    std::string filename = directory + "PlaceholderLibrary_PersistentCache.dat";
+    std::remove(filename.c_str());
+
+    uint64_t hash = 0;
+    {
+        auto library = load({});
+        ASSERT_NE(library, nullptr);
+        ASSERT_TRUE(library->usePersistentCache(filename));
+
+        auto solution = library->findBestSolution(even, hardware);
+        ASSERT_NE(solution, nullptr);
+        EXPECT_EQ(solution->name(), "even");
+        EXPECT_TRUE(library->savePersistentCache());
+
+        auto cache
+            = std::dynamic_pointer_cast<CachingLibrary<ContractionProblem>>(library->library);
+        ASSERT_NE(cache, nullptr);
+        hash = cache->persistentCache()->libraryHash();
+    }
+
+    SolutionCacheFile::Record record;
+    {
+        SolutionCacheFile file(filename, hash);
+        ASSERT_NE(file.find(even.fingerprint(), hardware), nullptr);
+
+        record = *file.find(even.fingerprint(), hardware);
+        EXPECT_EQ(record.solutionIndex, 0);
+        EXPECT_EQ(record.placeholder, 0);
+    }
+
+    // Point the record at the other placeholder's solution, so that a hit
+    // can be told apart from a lookup through the library.
+    record.solutionIndex = 1;
+    record.placeholder   = 1;
+    ASSERT_TRUE(SolutionCacheFile::Write(filename, hash, {record}));
+
+    {
+        auto library = load({});
+        ASSERT_NE(library, nullptr);
+        ASSERT_TRUE(library->usePersistentCache(filename));
+
+        auto solution = library->findBestSolution(even, hardware);
+        ASSERT_NE(solution, nullptr);
+        EXPECT_EQ(solution->name(), "any");
+        EXPECT_EQ(solution->codeObjectFilename.load(), "TensileLibrary_PlaceholderAny.co");
+        EXPECT_EQ(solutionCount(*library), 1);
+    }
+
+    std::remove(filename.c_str());
+}
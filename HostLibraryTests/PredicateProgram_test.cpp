@@ -0,0 +1,306 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <Tensile/ContractionProblemPredicates.hpp>
+#include <Tensile/ContractionSolution.hpp>
+#include <Tensile/PredicateProgram.hpp>
+
+#include <random>
+
+using namespace Tensile;
+using namespace Tensile::Predicates;
+
+using ProblemPredicate = std::shared_ptr<Predicate<ContractionProblem>>;
+
+namespace
+{
+    std::vector<ContractionProblem> RandomProblems(std::mt19937& rng, size_t count)
+    {
+        std::uniform_int_distribution<size_t> size(1, 64);
+        std::uniform_int_distribution<size_t> pad(0, 4);
+        std::uniform_int_distribution<int>    coin(0, 1);
+
+        std::vector<ContractionProblem> rv;
+        for(size_t i = 0; i < count; i++)
+        {
+            bool   transA = coin(rng);
+            bool   transB = coin(rng);
+            size_t m      = size(rng);
+            size_t n      = size(rng);
+            size_t k      = size(rng);
+            size_t lda    = (transA ? k : m) + pad(rng);
+            size_t ldb    = (transB ? n : k) + pad(rng);
+            size_t ldc    = m + pad(rng);
+            size_t batch  = 1 + pad(rng);
+
+            auto problem = ContractionProblem::GEMM(
+                transA, transB, m, n, k, lda, ldb, ldc, 1.0, false, batch);
+
+            problem.setHighPrecisionAccumulate(coin(rng));
+            problem.setDeterministicMode(coin(rng));
+            problem.setKernelLanguage(coin(rng) ? KernelLanguage::Assembly
+                                                : KernelLanguage::Source);
+            problem.setArithmeticUnit(coin(rng) ? ArithmeticUnit::MFMA : ArithmeticUnit::VALU);
+            problem.setWorkspaceSize(size(rng) * size(rng) * size(rng) * pad(rng));
+
+            rv.push_back(problem);
+        }
+
+        return rv;
+    }
+
+    ProblemPredicate RandomLeaf(std::mt19937& rng, std::string const& operationIdentifier)
+    {
+        using namespace Contraction;
+
+        std::uniform_int_distribution<size_t> index(0, 3);
+        std::uniform_int_distribution<size_t> value(1, 64);
+        std::uniform_int_distribution<size_t> multiple(1, 4);
+        std::uniform_int_distribution<int>    coin(0, 1);
+        std::uniform_int_distribution<int>    kind(0, 24);
+
+        switch(kind(rng))
+        {
+        case 0:
+            return std::make_shared<Free0SizeMultiple>(index(rng) % 1, multiple(rng));
+        case 1:
+            return std::make_shared<Free1SizeMultiple>(index(rng) % 1, multiple(rng));
+        case 2:
+            return std::make_shared<BatchSizeMultiple>(0, multiple(rng));
+        case 3:
+            return std::make_shared<BatchSizeEqual>(0, multiple(rng));
+        case 4:
+            return std::make_shared<BoundSizeMultiple>(coin(rng) ? -1 : 0, multiple(rng));
+        case 5:
+            return std::make_shared<SizeEqual>(index(rng), value(rng));
+        case 6:
+            return std::make_shared<SizeGreaterThan>(index(rng), value(rng));
+        case 7:
+            return std::make_shared<SizeLessThan>(index(rng), value(rng));
+        case 8:
+            return std::make_shared<SizeMultiple>(index(rng), multiple(rng));
+        case 9:
+        {
+            size_t min = value(rng);
+            return std::make_shared<SizeInRange>(index(rng), Range{min, min + value(rng)});
+        }
+        case 10:
+            return std::make_shared<LeadingFree0SizesGreaterOrEqual>(value(rng));
+        case 11:
+            return std::make_shared<LeadingFree1SizesGreaterOrEqual>(value(rng));
+        case 12:
+            return std::make_shared<StrideAEqual>(0, 1);
+        case 13:
+            return std::make_shared<StrideCEqual>(1, value(rng));
+        case 14:
+            return std::make_shared<LDCEqualsLDD>();
+        case 15:
+            return std::make_shared<HighPrecisionAccumulateEqual>(coin(rng));
+        case 16:
+            return std::make_shared<KernelLanguageCompatible>(
+                coin(rng) ? KernelLanguage::Assembly : KernelLanguage::Any);
+        case 17:
+            return std::make_shared<DeterministicModeEqual>(coin(rng));
+        case 18:
+            return std::make_shared<ArithmeticUnitCompatible>(coin(rng) ? ArithmeticUnit::MFMA
+                                                                        : ArithmeticUnit::Any);
+        case 19:
+        {
+            auto rv   = std::make_shared<TypesEqual>();
+            rv->value = {DataType::Float,
+                         DataType::Float,
+                         DataType::Float,
+                         coin(rng) ? DataType::Float : DataType::Half};
+            return rv;
+        }
+        case 20:
+        {
+            auto rv   = std::make_shared<OperationIdentifierEqual>();
+            rv->value = coin(rng) ? operationIdentifier : "Contraction_l_Ailk_Bjlk_Cijk_Dijk";
+            return rv;
+        }
+        case 21:
+            return std::make_shared<BufferLoadOffsetLimitCheck>(BufferLoadCheckPacket{
+                value(rng), value(rng), value(rng) << 20, value(rng) << 20});
+        case 22:
+        {
+            auto rv   = std::make_shared<WorkspaceCheck>();
+            rv->value = multiple(rng);
+            return rv;
+        }
+        case 23:
+            return std::make_shared<GlobalSplitUCheckMinK>(value(rng));
+        default:
+            // No compiled form; evaluated by calling the object.
+            return std::make_shared<CDStridesEqual>();
+        }
+    }
+
+    ProblemPredicate
+        RandomPredicate(std::mt19937& rng, std::string const& operationIdentifier, int depth)
+    {
+        std::uniform_int_distribution<int> kind(0, depth > 0 ? 5 : 0);
+        std::uniform_int_distribution<int> terms(0, 4);
+
+        switch(kind(rng))
+        {
+        case 1:
+        case 2:
+        {
+            std::vector<ProblemPredicate> values;
+            for(int n = terms(rng); n > 0; n--)
+                values.push_back(RandomPredicate(rng, operationIdentifier, depth - 1));
+            return std::make_shared<And<ContractionProblem>>(values);
+        }
+        case 3:
+        {
+            std::vector<ProblemPredicate> values;
+            for(int n = terms(rng); n > 0; n--)
+                values.push_back(RandomPredicate(rng, operationIdentifier, depth - 1));
+            return std::make_shared<Or<ContractionProblem>>(values);
+        }
+        case 4:
+            return std::make_shared<Not<ContractionProblem>>(
+                RandomPredicate(rng, operationIdentifier, depth - 1));
+        default:
+            return RandomLeaf(rng, operationIdentifier);
+        }
+    }
+}
+
+TEST(PredicateProgramTest, MatchesTree)
+{
+    std::mt19937 rng(12345);
+
+    auto problems = RandomProblems(rng, 64);
+
+    size_t accepted = 0;
+    size_t rejected = 0;
+    for(int i = 0; i < 500; i++)
+    {
+        auto predicate = RandomPredicate(rng, problems[0].operationIdentifier(), 4);
+        auto program   = Contraction::Program::Compile(predicate);
+
+        ASSERT_TRUE(program.compiledFrom(predicate.get()));
+
+        for(auto const& problem : problems)
+        {
+            ContractionProblemView view(problem);
+
+            bool expected = (*predicate)(problem);
+            ASSERT_EQ(program(view), expected) << *predicate << std::endl << problem;
+
+            // Values read by a previous program are reused.
+            ASSERT_EQ(program(view), expected);
+
+            if(expected)
+                accepted++;
+            else
+                rejected++;
+        }
+    }
+
+    EXPECT_GT(accepted, 0);
+    EXPECT_GT(rejected, 0);
+}
+
+TEST(PredicateProgramTest, Structure)
+{
+    using namespace Contraction;
+
+    ProblemPredicate sizes = std::make_shared<And<ContractionProblem>>(
+        std::vector<ProblemPredicate>{std::make_shared<SizeMultiple>(0, 4),
+                                      std::make_shared<True<ContractionProblem>>(),
+                                      std::make_shared<SizeGreaterThan>(3, 16)});
+    auto program = Program::Compile(sizes);
+    EXPECT_EQ(program.size(), 2);
+    EXPECT_EQ(program.callCount(), 0);
+
+    // Indices without a value of their own are left to the predicate.
+    size_t           index = ContractionProblemView::MaxSizeIndex;
+    ProblemPredicate wide  = std::make_shared<Or<ContractionProblem>>(
+        std::vector<ProblemPredicate>{std::make_shared<SizeEqual>(index, 1),
+                                      std::make_shared<SizeMultiple>(0, 0),
+                                      std::make_shared<CDStridesEqual>()});
+    program = Program::Compile(wide);
+    EXPECT_EQ(program.size(), 3);
+    EXPECT_EQ(program.callCount(), 3);
+
+    EXPECT_FALSE(Program().compiledFrom(nullptr));
+    EXPECT_FALSE(Program::Compile(nullptr).compiledFrom(nullptr));
+    EXPECT_FALSE(program.compiledFrom(sizes.get()));
+
+    auto problem = ContractionProblem::GEMM(false, false, 8, 8, 32, 8, 32, 8, 1.0, false, 1);
+    ContractionProblemView view(problem);
+    EXPECT_TRUE(Program::Compile(sizes)(view));
+    EXPECT_FALSE(Program::Compile(std::make_shared<And<ContractionProblem>>(
+        std::vector<ProblemPredicate>{std::make_shared<SizeMultiple>(0, 16)}))(view));
+    EXPECT_TRUE(Program::Compile(std::make_shared<And<ContractionProblem>>())(view));
+    EXPECT_FALSE(Program::Compile(std::make_shared<Or<ContractionProblem>>())(view));
+}
+
+TEST(PredicateProgramTest, Solution)
+{
+    using namespace Contraction;
+
+    auto problem = ContractionProblem::GEMM(false, false, 8, 8, 32, 8, 32, 8, 1.0, false, 1);
+    ContractionProblemView view(problem);
+
+    ContractionSolution solution;
+    solution.problemPredicate = std::make_shared<SizeMultiple>(0, 16);
+    solution.problemProgram   = Program::Compile(std::make_shared<SizeMultiple>(0, 8));
+
+    // A program compiled from another predicate is ignored.
+    EXPECT_FALSE(solution.checkProblemPredicate(view));
+
+    solution.problemProgram = Program::Compile(solution.problemPredicate);
+    EXPECT_FALSE(solution.checkProblemPredicate(view));
+
+    solution.problemPredicate = std::make_shared<SizeMultiple>(0, 8);
+    EXPECT_TRUE(solution.checkProblemPredicate(view));
+}
+
+TEST(PredicateProgramTest, HoldsSource)
+{
+    using namespace Contraction;
+
+    // The program keeps its predicate alive, so no later predicate can take its address.
+    for(int i = 0; i < 100; i++)
+    {
+        ProblemPredicate predicate = std::make_shared<SizeMultiple>(0, 16);
+        auto             program   = Program::Compile(predicate);
+        auto const*      source    = predicate.get();
+
+        predicate.reset();
+        ProblemPredicate replacement = std::make_shared<SizeMultiple>(0, 8);
+
+        EXPECT_TRUE(program.compiledFrom(source));
+        EXPECT_FALSE(program.compiledFrom(replacement.get()));
+    }
+}
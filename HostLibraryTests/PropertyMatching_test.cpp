@@ -0,0 +1,210 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <Tensile/ContractionLibrary.hpp>
+#include <Tensile/Distance.hpp>
+#include <Tensile/PropertyMatching.hpp>
+
+#include <random>
+
+using namespace Tensile;
+
+template <typename Distance>
+struct PropertyMatchingTest : public ::testing::Test
+{
+    using Key   = std::array<int64_t, 4>;
+    using Value = std::shared_ptr<ContractionSolution>;
+    using Table = Matching::DistanceMatchingTable<Key, ContractionProblem, Value, Value, Distance>;
+    using Entry = typename Table::Entry;
+
+    std::mt19937 rng{42};
+
+    // Small key ranges so that duplicate keys, equal distances and equal
+    // speeds all occur.
+    Key randomKey()
+    {
+        std::uniform_int_distribution<int64_t> dist(1, 40);
+        return {dist(rng) * 64, dist(rng) * 64, dist(rng) % 4 + 1, dist(rng) * 32};
+    }
+
+    template <typename MyTable = Table>
+    MyTable makeTable(size_t rows)
+    {
+        std::uniform_int_distribution<int> speed(1, 5);
+
+        MyTable table;
+        for(size_t i = 0; i < rows; i++)
+        {
+            auto solution   = std::make_shared<ContractionSolution>();
+            solution->index = i;
+            table.table.push_back(Entry{randomKey(), solution, double(speed(rng))});
+        }
+
+        // Same order as deserialization.
+        std::sort(table.table.begin(), table.table.end(), [](Entry const& a, Entry const& b) {
+            return a.key < b.key || (a.key == b.key && a.speed > b.speed);
+        });
+
+        return table;
+    }
+};
+
+using Distances = ::testing::Types<Matching::EuclideanDistance<std::array<int64_t, 4>>,
+                                   Matching::ManhattanDistance<std::array<int64_t, 4>>,
+                                   Matching::RatioDistance<std::array<int64_t, 4>>>;
+
+TYPED_TEST_SUITE(PropertyMatchingTest, Distances);
+
+TYPED_TEST(PropertyMatchingTest, ColumnSearchMatchesRowSearch)
+{
+    using Value = typename TestFixture::Value;
+
+    // Some rows have no usable solution, so the search has to skip them.
+    auto transform = [](Value value) -> Value { return value->index % 7 == 0 ? nullptr : value; };
+
+    for(size_t rows : {1, 3, 50, 5000})
+    {
+        auto table = this->makeTable(rows);
+
+        std::vector<std::tuple<Value, double>> expected;
+        std::vector<typename TestFixture::Key> keys;
+        for(int i = 0; i < 2000; i++)
+        {
+            keys.push_back(this->randomKey());
+            expected.push_back(
+                table.template findBestKeyMatch_BinSearch<false>(keys.back(), transform));
+        }
+
+        table.buildColumns();
+        ASSERT_EQ(table.columns.rows, rows);
+
+        for(size_t i = 0; i < keys.size(); i++)
+        {
+            auto result = table.findBestKeyMatch(keys[i], transform);
+            EXPECT_EQ(std::get<0>(result), std::get<0>(expected[i])) << rows << " " << i;
+            EXPECT_EQ(std::get<1>(result), std::get<1>(expected[i])) << rows << " " << i;
+        }
+
+        // Stale columns are not used.
+        table.table.pop_back();
+        EXPECT_EQ(table.findBestKeyMatch(keys[0], transform),
+                  table.template findBestKeyMatch_BinSearch<false>(keys[0], transform));
+    }
+}
+
+template <typename Distance>
+struct KDTreeMatchingTest : public PropertyMatchingTest<Distance>
+{
+    using Key   = typename PropertyMatchingTest<Distance>::Key;
+    using Value = typename PropertyMatchingTest<Distance>::Value;
+    using Table
+        = Matching::KDTreeMatchingTable<Key, ContractionProblem, Value, Value, Distance>;
+};
+
+using SeparableDistances = ::testing::Types<Matching::EuclideanDistance<std::array<int64_t, 4>>,
+                                            Matching::ManhattanDistance<std::array<int64_t, 4>>>;
+
+TYPED_TEST_SUITE(KDTreeMatchingTest, SeparableDistances);
+
+TYPED_TEST(KDTreeMatchingTest, MatchesSortedTableSearch)
+{
+    using Value = typename TestFixture::Value;
+    using Table = typename TestFixture::Table;
+
+    auto transform = [](Value value) -> Value { return value->index % 7 == 0 ? nullptr : value; };
+
+    for(size_t rows : {1, 3, 9, 50, 5000})
+    {
+        auto table = this->template makeTable<Table>(rows);
+
+        std::vector<std::tuple<Value, double>> expected;
+        std::vector<typename TestFixture::Key> keys;
+        for(int i = 0; i < 2000; i++)
+        {
+            keys.push_back(this->randomKey());
+            // Keys in the table, where rows at the same distance are most likely.
+            if(i % 4 == 0)
+                keys.back() = table.table[i % rows].key;
+            expected.push_back(
+                table.template findBestKeyMatch_BinSearch<false>(keys.back(), transform));
+        }
+
+        table.buildIndex();
+        ASSERT_EQ(table.order.size(), rows);
+
+        for(size_t i = 0; i < keys.size(); i++)
+        {
+            auto result = table.findBestKeyMatch(keys[i], transform);
+            EXPECT_EQ(std::get<0>(result), std::get<0>(expected[i])) << rows << " " << i;
+            EXPECT_EQ(std::get<1>(result), std::get<1>(expected[i])) << rows << " " << i;
+        }
+
+        // No usable rows at all.
+        auto none = [](Value value) -> Value { return nullptr; };
+        EXPECT_EQ(table.findBestKeyMatch(keys[0], none),
+                  table.template findBestKeyMatch_BinSearch<false>(keys[0], none));
+
+        // A stale index is not used.
+        table.table.pop_back();
+        EXPECT_EQ(table.findBestKeyMatch(keys[0], transform),
+                  table.template findBestKeyMatch_BinSearch<false>(keys[0], transform));
+    }
+}
+
+TYPED_TEST(KDTreeMatchingTest, ClusteredFirstElement)
+{
+    using Value = typename TestFixture::Value;
+    using Table = typename TestFixture::Table;
+    using Key   = typename TestFixture::Key;
+
+    auto transform = [](Value value) -> Value { return value->index % 5 == 0 ? nullptr : value; };
+
+    // Every row has the same first element, so the sorted-table search can
+    // only prune on the others.
+    auto table = this->template makeTable<Table>(3000);
+    for(auto& entry : table.table)
+        entry.key[0] = 1024;
+    std::sort(table.table.begin(), table.table.end(), [](auto const& a, auto const& b) {
+        return a.key < b.key || (a.key == b.key && a.speed > b.speed);
+    });
+    table.buildIndex();
+
+    for(int i = 0; i < 1000; i++)
+    {
+        Key key = this->randomKey();
+        if(i % 2 == 0)
+            key[0] = 1024;
+
+        EXPECT_EQ(table.findBestKeyMatch(key, transform),
+                  table.template findBestKeyMatch_BinSearch<false>(key, transform))
+            << i;
+    }
+
+    EXPECT_EQ(table.distanceType(), TypeParam::Type() + "KDTree");
+}
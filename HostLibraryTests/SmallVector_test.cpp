@@ -0,0 +1,217 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <Tensile/ContractionProblem.hpp>
+#include <Tensile/SmallVector.hpp>
+#include <Tensile/TensorDescriptor.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+using namespace Tensile;
+
+namespace
+{
+    // Counts calls to the global operator new made by this thread while an
+    // AllocationCounter is alive.
+    thread_local bool   counting    = false;
+    thread_local size_t allocations = 0;
+
+    struct AllocationCounter
+    {
+        AllocationCounter()
+        {
+            allocations = 0;
+            counting    = true;
+        }
+
+        ~AllocationCounter()
+        {
+            counting = false;
+        }
+
+        size_t count() const
+        {
+            return allocations;
+        }
+    };
+
+    using Ints = SmallVector<int, 4>;
+} // namespace
+
+void* operator new(size_t size)
+{
+    if(counting)
+        allocations++;
+
+    if(void* rv = std::malloc(size ? size : 1))
+        return rv;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(SmallVector, InlineUntilCapacity)
+{
+    AllocationCounter counter;
+    Ints              v;
+
+    for(int i = 0; i < 4; i++)
+        v.push_back(i);
+
+    EXPECT_TRUE(v.isInline());
+    EXPECT_EQ(counter.count(), 0);
+
+    v.push_back(4);
+    EXPECT_FALSE(v.isInline());
+    EXPECT_GT(counter.count(), 0);
+    EXPECT_EQ(v, Ints({0, 1, 2, 3, 4}));
+
+    v.resize(2);
+    EXPECT_TRUE(v.isInline());
+    EXPECT_EQ(v, Ints({0, 1}));
+
+    v.resize(6, 7);
+    EXPECT_EQ(v, Ints({0, 1, 7, 7, 7, 7}));
+}
+
+TEST(SmallVector, VectorOperations)
+{
+    Ints v{1, 2, 5};
+
+    v.insert(v.begin() + 2, 3);
+    std::vector<int> tail{6, 7};
+    v.insert(v.end(), tail.begin(), tail.end());
+    EXPECT_EQ(v, Ints({1, 2, 3, 5, 6, 7}));
+
+    v.erase(v.begin() + 3);
+    v.erase(v.begin() + 3, v.end());
+    EXPECT_EQ(v, Ints({1, 2, 3}));
+    EXPECT_EQ(v.front(), 1);
+    EXPECT_EQ(v.back(), 3);
+    EXPECT_THROW(v.at(3), std::out_of_range);
+
+    Ints big(9, 1);
+    Ints copy(big);
+    EXPECT_EQ(copy, big);
+
+    Ints moved(std::move(big));
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(big.empty());
+
+    EXPECT_LT(copy, v);
+    EXPECT_NE(v, copy);
+    EXPECT_EQ(v, std::vector<int>({1, 2, 3}));
+}
+
+TEST(SmallVector, TensorDescriptorDoesNotAllocate)
+{
+    AllocationCounter counter;
+
+    TensorDescriptor a(DataType::Float, {128, 64, 4}, {1, 256, 256 * 64});
+    TensorDescriptor b(DataType::Float, {128, 64, 4});
+    b.appendDim(2);
+    b.collapseDims(2, 4);
+
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST(SmallVector, GEMMProblemAllocations)
+{
+    // Warm up function-local statics and intern both operations.
+    ContractionProblem::GEMM(false, true, 64, 64, 64, 64, 64, 64, 1.0, false, 2);
+    ContractionProblem::GEMM(true, false, 64, 64, 64, 64, 64, 64, 1.0, false, 2);
+
+    size_t gemm, strided, copied;
+    {
+        AllocationCounter counter;
+
+        auto problem = ContractionProblem::GEMM(false, true, 64, 64, 64, 64, 64, 64, 1.0, false, 2);
+
+        gemm = counter.count();
+    }
+    {
+        AllocationCounter counter;
+
+        auto problem = ContractionProblem::GEMM_Strides(true,
+                                                        false,
+                                                        DataType::Half,
+                                                        DataType::Half,
+                                                        DataType::Half,
+                                                        DataType::Half,
+                                                        512,
+                                                        256,
+                                                        128,
+                                                        8,
+                                                        128,
+                                                        128 * 512,
+                                                        128,
+                                                        128 * 256,
+                                                        512,
+                                                        512 * 256,
+                                                        512,
+                                                        512 * 256,
+                                                        1.0);
+
+        strided = counter.count();
+
+        AllocationCounter copyCounter;
+        ContractionProblem copy(problem);
+        copied = copyCounter.count();
+    }
+
+    EXPECT_EQ(gemm, 0);
+    EXPECT_EQ(strided, 0);
+    EXPECT_EQ(copied, 0);
+}
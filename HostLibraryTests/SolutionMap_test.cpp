@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <Tensile/ContractionSolution.hpp>
+#include <Tensile/SolutionMap.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Tensile;
+
+namespace
+{
+    std::shared_ptr<ContractionSolution> MakeSolution(int index)
+    {
+        auto rv   = std::make_shared<ContractionSolution>();
+        rv->index = index;
+        return rv;
+    }
+} // namespace
+
+TEST(SolutionMap, MapInterface)
+{
+    auto s0 = MakeSolution(0);
+    auto s3 = MakeSolution(3);
+    auto s7 = MakeSolution(70000);
+
+    SolutionMap<ContractionSolution> map({{3, s3}, {0, s0}});
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_TRUE(map.insert({70000, s7}).second);
+    EXPECT_FALSE(map.insert({3, s0}).second);
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(3), s3);
+    EXPECT_EQ(map.find(70000)->second, s7);
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_EQ(map.find(-1), map.end());
+    EXPECT_EQ(map.find(1 << 30), map.end());
+    EXPECT_THROW(map.at(2), std::out_of_range);
+    EXPECT_THROW(map.insert({-1, s0}), std::out_of_range);
+
+    std::vector<int> keys;
+    for(auto const& pair : map)
+        keys.push_back(pair.first);
+    EXPECT_EQ(keys, std::vector<int>({0, 3, 70000}));
+    EXPECT_EQ(map.rbegin()->first, 70000);
+
+    auto last = map.end();
+    last--;
+    EXPECT_EQ(last->first, 70000);
+
+    map.insert_or_assign(3, s0);
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(3), s0);
+
+    SolutionMap<ContractionSolution> copy;
+    copy = map;
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy.at(70000), s7);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(copy.begin()->first, 0);
+}
+
+TEST(SolutionMap, IndexLimit)
+{
+    // INT_MAX is the end iterator's index, so it can't hold an entry.
+    int const last = std::numeric_limits<int>::max();
+
+    SolutionMap<ContractionSolution> map({{5, MakeSolution(5)}});
+    EXPECT_THROW(map.insert({last, MakeSolution(last)}), std::out_of_range);
+    EXPECT_THROW(map.insert_or_assign(last, MakeSolution(last)), std::out_of_range);
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.find(last), map.end());
+    EXPECT_EQ(map.count(last), 0);
+    EXPECT_EQ((--map.end())->first, 5);
+}
+
+TEST(SolutionMap, LookupsWhileInserting)
+{
+    int const count = 20000;
+
+    std::vector<std::shared_ptr<ContractionSolution>> solutions;
+    for(int i = 0; i < count; i++)
+        solutions.push_back(MakeSolution(i));
+
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(5));
+
+    SolutionMap<ContractionSolution> map;
+    std::atomic<bool>                done(false);
+    std::atomic<int>                 errors(0);
+
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; t++)
+    {
+        readers.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            while(!done.load())
+            {
+                int  index = rng() % count;
+                auto iter  = map.find(index);
+                if(iter != map.end() && iter->second != solutions[index])
+                    errors++;
+
+                int previous = -1;
+                for(auto const& pair : map)
+                {
+                    if(pair.first <= previous || pair.second->index != pair.first)
+                        errors++;
+                    previous = pair.first;
+                    if(pair.first > 100)
+                        break;
+                }
+            }
+        });
+    }
+
+    for(int index : order)
+        map.insert({index, solutions[index]});
+
+    done = true;
+    for(auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(map.size(), count);
+    for(int i = 0; i < count; i++)
+        ASSERT_EQ(map.at(i), solutions[i]) << i;
+}
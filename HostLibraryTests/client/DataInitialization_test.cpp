@@ -26,8 +26,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <tuple>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <DataInitializationTyped.hpp>
 
 using namespace Tensile;
@@ -79,6 +84,78 @@ public:
         return rv;
     }
 
+    std::shared_ptr<DataInitialization> RandomInit(size_t seed)
+    {
+        po::variables_map args = this->DataTypeArgs();
+
+        args.insert({"init-a", val(InitMode::Random, false)});
+        args.insert({"init-b", val(InitMode::Random, false)});
+        args.insert({"init-c", val(InitMode::Random, false)});
+        args.insert({"init-d", val(InitMode::Zero, false)});
+        args.insert({"init-alpha", val(InitMode::One, false)});
+        args.insert({"init-beta", val(InitMode::One, false)});
+        args.insert({"init-seed", val(seed, false)});
+        args.insert({"c-equal-d", val(false, false)});
+        args.insert({"pristine-on-gpu", val(false, false)});
+        args.insert({"bounds-check", val(BoundsCheckMode::Disable, false)});
+        args.insert({"num-elements-to-validate", val(0, false)});
+        args.insert({"offset-a", val((size_t)0, false)});
+        args.insert({"offset-b", val((size_t)0, false)});
+        args.insert({"offset-c", val((size_t)0, false)});
+        args.insert({"offset-d", val((size_t)0, false)});
+        args.insert({"strided-batched", val(false, false)});
+
+        TensorDescriptor a(TypeInfo<AType>::Enum, {10, 10, 1});
+        TensorDescriptor b(TypeInfo<BType>::Enum, {10, 10, 1});
+        TensorDescriptor c(TypeInfo<CType>::Enum, {10, 10, 1});
+        TensorDescriptor d(TypeInfo<DType>::Enum, {10, 10, 1});
+
+        TensorOps nop;
+
+        auto problem = ContractionProblem::GEMM(false, false, a, nop, b, nop, c, nop, d, nop, 1.5);
+
+        ClientProblemFactory factory(problem);
+
+        return DataInitialization::Get(args, factory);
+    }
+
+    ContractionProblem BatchedGEMM(size_t m, size_t n, size_t k, size_t batch)
+    {
+        TensorDescriptor a(TypeInfo<AType>::Enum, {m, k, batch});
+        TensorDescriptor b(TypeInfo<BType>::Enum, {k, n, batch});
+        TensorDescriptor c(TypeInfo<CType>::Enum, {m, n, batch});
+        TensorDescriptor d(TypeInfo<DType>::Enum, {m, n, batch});
+
+        TensorOps nop;
+
+        return ContractionProblem::GEMM(false, false, a, nop, b, nop, c, nop, d, nop, 1.5);
+    }
+
+    std::shared_ptr<DataInitialization> SerialInit(std::vector<ContractionProblem> const& problems)
+    {
+        po::variables_map args = this->DataTypeArgs();
+
+        args.insert({"init-a", val(InitMode::SerialIdx, false)});
+        args.insert({"init-b", val(InitMode::Random, false)});
+        args.insert({"init-c", val(InitMode::Zero, false)});
+        args.insert({"init-d", val(InitMode::Zero, false)});
+        args.insert({"init-alpha", val(InitMode::One, false)});
+        args.insert({"init-beta", val(InitMode::One, false)});
+        args.insert({"c-equal-d", val(false, false)});
+        args.insert({"pristine-on-gpu", val(false, false)});
+        args.insert({"bounds-check", val(BoundsCheckMode::Disable, false)});
+        args.insert({"num-elements-to-validate", val(0, false)});
+        args.insert({"offset-a", val((size_t)0, false)});
+        args.insert({"offset-b", val((size_t)0, false)});
+        args.insert({"offset-c", val((size_t)0, false)});
+        args.insert({"offset-d", val((size_t)0, false)});
+        args.insert({"strided-batched", val(false, false)});
+
+        ClientProblemFactory factory(problems.begin(), problems.end());
+
+        return DataInitialization::Get(args, factory);
+    }
+
     void RunDataContaminationTest(bool cEqualD, bool pristineGPU, BoundsCheckMode boundsCheck)
     {
         using val = po::variable_value;
@@ -204,6 +281,180 @@ TYPED_TEST(DataInitializationTest, Contamination_true_true_true)
     this->RunDataContaminationTest(true, true, BoundsCheckMode::NaN);
 }
 
+TYPED_TEST(DataInitializationTest, RandomReproducible)
+{
+    using AType = typename TestFixture::AType;
+
+    // Large enough to be filled in parallel.
+    size_t const elements = (1 << 18) + 3;
+
+    for(auto mode : {InitMode::Random, InitMode::RandomNarrow})
+    {
+        std::vector<AType> serial(elements), parallel(elements), other(elements);
+
+        auto init = this->RandomInit(7);
+
+#ifdef _OPENMP
+        int threads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        init->initArray(mode, serial.data(), elements, 0);
+        omp_set_num_threads(4);
+        init->initArray(mode, parallel.data(), elements, 0);
+        omp_set_num_threads(threads);
+#else
+        init->initArray(mode, serial.data(), elements, 0);
+        init->initArray(mode, parallel.data(), elements, 0);
+#endif
+        EXPECT_EQ(memcmp(serial.data(), parallel.data(), elements * sizeof(AType)), 0);
+
+        this->RandomInit(7)->initArray(mode, other.data(), elements, 0);
+        EXPECT_EQ(memcmp(serial.data(), other.data(), elements * sizeof(AType)), 0);
+
+        this->RandomInit(8)->initArray(mode, other.data(), elements, 0);
+        EXPECT_NE(memcmp(serial.data(), other.data(), elements * sizeof(AType)), 0);
+
+        init->initArray(mode, other.data(), elements, 1);
+        EXPECT_NE(memcmp(serial.data(), other.data(), elements * sizeof(AType)), 0);
+    }
+}
+
+TYPED_TEST(DataInitializationTest, PristineReuse)
+{
+    using AType = typename TestFixture::AType;
+    using BType = typename TestFixture::BType;
+
+    std::vector<ContractionProblem> problems = {this->BatchedGEMM(10, 10, 10, 2),
+                                                this->BatchedGEMM(10, 10, 10, 1),
+                                                this->BatchedGEMM(10, 10, 12, 1)};
+
+    auto init = this->SerialInit(problems);
+
+    std::vector<BType> firstB;
+    InputTraffic       before;
+
+    for(size_t i = 0; i < problems.size(); i++)
+    {
+        auto const& a = problems[i].a();
+        auto const& b = problems[i].b();
+
+        before      = init->inputTraffic();
+        auto inputs = std::dynamic_pointer_cast<TypeParam>(init->prepareCPUInputs(problems[i]));
+        ASSERT_NE(inputs, nullptr);
+
+        // The second problem is a sub-view of the first, the third is not.
+        if(i == 1)
+        {
+            EXPECT_EQ(init->inputTraffic().generatedBytes, before.generatedBytes);
+            EXPECT_GT(init->inputTraffic().reusedBytes, before.reusedBytes);
+        }
+        else if(i == 2)
+        {
+            EXPECT_EQ(init->inputTraffic().generatedBytes - before.generatedBytes,
+                      a.totalLogicalElements() * sizeof(AType));
+        }
+
+        std::vector<AType> expected(a.totalAllocatedElements());
+        init->initArray(InitMode::SerialIdx, expected.data(), a, 0);
+        EXPECT_EQ(memcmp(inputs->a, expected.data(), a.totalAllocatedBytes()), 0) << i;
+
+        if(i == 0)
+            firstB.assign(inputs->b, inputs->b + b.totalAllocatedElements());
+        else
+            EXPECT_EQ(memcmp(inputs->b, firstB.data(), b.totalAllocatedBytes()), 0) << i;
+    }
+
+    // Unchanged operands are not copied again for the next run.
+    init->prepareGPUInputs(problems[2]);
+    before      = init->inputTraffic();
+    auto inputs = std::dynamic_pointer_cast<TypeParam>(init->prepareGPUInputs(problems[2]));
+    EXPECT_GT(init->inputTraffic().skippedBytes, before.skippedBytes);
+
+    std::vector<AType> gpuA(problems[2].a().totalAllocatedElements());
+    hipMemcpy(gpuA.data(), inputs->a, problems[2].a().totalAllocatedBytes(), hipMemcpyDeviceToHost);
+
+    std::vector<AType> expected(gpuA.size());
+    init->initArray(InitMode::SerialIdx, expected.data(), problems[2].a(), 0);
+    EXPECT_EQ(memcmp(gpuA.data(), expected.data(), problems[2].a().totalAllocatedBytes()), 0);
+}
+
+TEST(DataInitializationTest, InitKeyCovers)
+{
+    TensorDescriptor big(DataType::Float, {10, 10, 2});
+    TensorDescriptor batch(DataType::Float, {10, 10, 1}, {1, 10, 100});
+    TensorDescriptor sub(DataType::Float, {4, 6, 1}, {1, 10, 100});
+    TensorDescriptor repacked(DataType::Float, {4, 6, 1});
+    TensorDescriptor aliased(DataType::Float, {10, 10}, {1, 5});
+    TensorDescriptor aliasedSub(DataType::Float, {5, 10}, {1, 5});
+
+    auto key = [](InitMode mode, TensorDescriptor const& tensor) {
+        return InitKey{mode, DataType::Float, tensor};
+    };
+
+    EXPECT_TRUE(key(InitMode::Random, big).covers(key(InitMode::Random, repacked)));
+    EXPECT_FALSE(key(InitMode::Random, big).covers(key(InitMode::One, big)));
+    EXPECT_FALSE(key(InitMode::Random, big)
+                     .covers(InitKey{InitMode::Random, DataType::Double, big}));
+
+    for(auto mode : {InitMode::SerialDim0, InitMode::SerialDim1, InitMode::Identity})
+    {
+        EXPECT_TRUE(key(mode, big).covers(key(mode, batch))) << mode;
+        EXPECT_TRUE(key(mode, big).covers(key(mode, sub))) << mode;
+        EXPECT_FALSE(key(mode, sub).covers(key(mode, big))) << mode;
+        EXPECT_FALSE(key(mode, big).covers(key(mode, repacked))) << mode;
+        EXPECT_FALSE(key(mode, aliased).covers(key(mode, aliasedSub))) << mode;
+    }
+
+    for(auto mode : {InitMode::SerialIdx, InitMode::TrigSin, InitMode::TrigAbsCos})
+    {
+        EXPECT_TRUE(key(mode, big).covers(key(mode, big))) << mode;
+        EXPECT_TRUE(key(mode, big).covers(key(mode, batch))) << mode;
+        EXPECT_FALSE(key(mode, big).covers(key(mode, sub))) << mode;
+    }
+}
+
+TEST(DataInitializationTest, RandomRange)
+{
+    CounterRandom rng(CounterRandom::Key(3, 0), 0);
+
+    std::vector<int> counts(7, 0);
+    for(int i = 0; i < 70000; i++)
+    {
+        int value = DataInitialization::getValue<int32_t, InitMode::Random>(rng);
+        ASSERT_GE(value, -3);
+        ASSERT_LE(value, 3);
+        counts[value + 3]++;
+    }
+
+    for(int count : counts)
+        EXPECT_NEAR(count, 10000, 500);
+
+    for(int i = 0; i < 10000; i++)
+    {
+        float value = DataInitialization::getValue<float, InitMode::Random>(rng);
+        ASSERT_GE(value, -100.0f);
+        ASSERT_LE(value, 100.0f);
+        ASSERT_EQ(value, std::round(value));
+    }
+}
+
+TEST(DataInitializationTest, ThreadRandomSeed)
+{
+    auto draw = [](uint64_t seed) {
+        DataInitialization::SeedThreadRandom(seed);
+        std::vector<double> values;
+        for(int i = 0; i < 16; i++)
+            values.push_back(DataInitialization::getValue<double, InitMode::Random>());
+        return values;
+    };
+
+    auto first = draw(5);
+    EXPECT_EQ(draw(5), first);
+    EXPECT_NE(draw(6), first);
+    EXPECT_EQ(draw(5), first);
+
+    DataInitialization::SeedThreadRandom(0);
+}
+
 template <typename T>
 struct DataInitializationTestFloating : public ::testing::Test
 {
@@ -0,0 +1,280 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include <Reference.hpp>
+
+using namespace Tensile;
+using namespace Tensile::Client;
+
+template <typename T>
+struct RandomValue
+{
+    static T Get(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        return static_cast<T>(dist(rng));
+    }
+};
+
+template <typename T>
+struct RandomValue<std::complex<T>>
+{
+    static std::complex<T> Get(std::mt19937& rng)
+    {
+        T real = RandomValue<T>::Get(rng);
+        return {real, RandomValue<T>::Get(rng)};
+    }
+};
+
+template <>
+struct RandomValue<int32_t>
+{
+    static int32_t Get(std::mt19937& rng)
+    {
+        return std::uniform_int_distribution<int32_t>(-100, 100)(rng);
+    }
+};
+
+template <>
+struct RandomValue<int8_t>
+{
+    static int8_t Get(std::mt19937& rng)
+    {
+        return std::uniform_int_distribution<int32_t>(-128, 127)(rng);
+    }
+};
+
+template <>
+struct RandomValue<Int8x4>
+{
+    static Int8x4 Get(std::mt19937& rng)
+    {
+        int8_t a = RandomValue<int8_t>::Get(rng);
+        int8_t b = RandomValue<int8_t>::Get(rng);
+        int8_t c = RandomValue<int8_t>::Get(rng);
+        return Int8x4(a, b, c, RandomValue<int8_t>::Get(rng));
+    }
+};
+
+template <typename Inputs, bool HPA = false>
+struct ReferenceCase
+{
+    using TypedInputs                            = Inputs;
+    constexpr static bool HighPrecisionAccumulate = HPA;
+};
+
+template <typename Case>
+struct ReferenceTest : public ::testing::Test
+{
+    using TypedInputs = typename Case::TypedInputs;
+    using AType       = typename TypedInputs::AType;
+    using BType       = typename TypedInputs::BType;
+    using CType       = typename TypedInputs::CType;
+    using DType       = typename TypedInputs::DType;
+    using AlphaType   = typename TypedInputs::AlphaType;
+    using BetaType    = typename TypedInputs::BetaType;
+
+    std::mt19937 rng{42};
+
+    template <typename T>
+    std::vector<T> random(size_t count)
+    {
+        std::vector<T> rv(count);
+        for(auto& value : rv)
+            value = RandomValue<T>::Get(rng);
+        return rv;
+    }
+
+    ContractionProblem problem(std::string const& identifier, std::vector<size_t> const& sizes)
+    {
+        std::vector<size_t> empty;
+        auto                rv = ContractionProblem::FromIndexSizes(identifier,
+                                                     sizes,
+                                                     TypeInfo<AType>::Enum,
+                                                     empty,
+                                                     TypeInfo<BType>::Enum,
+                                                     empty,
+                                                     TypeInfo<CType>::Enum,
+                                                     empty,
+                                                     TypeInfo<DType>::Enum,
+                                                     empty,
+                                                     1.0);
+        rv.setAlphaType(TypeInfo<AlphaType>::Enum);
+        rv.setBetaType(TypeInfo<BetaType>::Enum);
+        rv.setHighPrecisionAccumulate(Case::HighPrecisionAccumulate);
+        return rv;
+    }
+
+    /**
+     * Solves the same batched GEMM through the blocked fast path and, by adding
+     * a size-1 second bound index, through the element-wise path.
+     */
+    void CompareBlocked(std::string const& identifier,
+                        std::string const& identifierTwoBound,
+                        std::vector<size_t> sizes)
+    {
+        auto blockedProblem = problem(identifier, sizes);
+
+        sizes.push_back(1);
+        auto genericProblem = problem(identifierTwoBound, sizes);
+        ASSERT_EQ(genericProblem.boundIndices().size(), 2);
+
+        auto a = random<AType>(blockedProblem.a().totalAllocatedElements());
+        auto b = random<BType>(blockedProblem.b().totalAllocatedElements());
+        auto c = random<CType>(blockedProblem.c().totalAllocatedElements());
+
+        std::vector<DType> blocked(blockedProblem.d().totalAllocatedElements());
+        std::vector<DType> generic(blockedProblem.d().totalAllocatedElements());
+
+        auto alpha = RandomValue<AlphaType>::Get(rng);
+        auto beta  = RandomValue<BetaType>::Get(rng);
+
+        TypedInputs blockedInputs(a.data(), b.data(), c.data(), blocked.data(), alpha, beta);
+        TypedInputs genericInputs(a.data(), b.data(), c.data(), generic.data(), alpha, beta);
+
+        SolveCPU(blockedProblem, blockedInputs);
+        SolveCPU(genericProblem, genericInputs);
+
+        for(size_t i = 0; i < blocked.size(); i++)
+            ASSERT_EQ(blocked[i], generic[i]) << i;
+    }
+};
+
+using ReferenceCases = ::testing::Types<ReferenceCase<ContractionInputs_S_S_S>,
+                                        ReferenceCase<ContractionInputs_D_D_D>,
+                                        ReferenceCase<ContractionInputs_C_C_C>,
+                                        ReferenceCase<ContractionInputs_Z_Z_Z>,
+#ifdef TENSILE_USE_HALF
+                                        ReferenceCase<ContractionInputs_H_H_H>,
+                                        ReferenceCase<ContractionInputs_H_H_H, true>,
+                                        ReferenceCase<ContractionInputs_H_H_S>,
+                                        ReferenceCase<ContractionInputs_H_S_S>,
+#endif // TENSILE_USE_HALF
+                                        ReferenceCase<ContractionInputs_B_B_S>,
+                                        ReferenceCase<ContractionInputs_B_B_S, true>,
+                                        ReferenceCase<ContractionInputs_B_S_S>,
+                                        ReferenceCase<ContractionInputs_I8x4_I32_I32>,
+                                        ReferenceCase<ContractionInputs_I8_I32_I32>,
+                                        ReferenceCase<ContractionInputs_I32_I32_I32>>;
+TYPED_TEST_SUITE(ReferenceTest, ReferenceCases);
+
+TYPED_TEST(ReferenceTest, BlockedNN)
+{
+    this->CompareBlocked("Contraction_l_Aikl_Bljk_Cijk_Dijk",
+                         "Contraction_lm_Aiklm_Bljkm_Cijk_Dijk",
+                         {131, 70, 1, 300});
+}
+
+TYPED_TEST(ReferenceTest, BlockedBatchedTN)
+{
+    this->CompareBlocked("Contraction_l_Alik_Bljk_Cijk_Dijk",
+                         "Contraction_lm_Alikm_Bljkm_Cijk_Dijk",
+                         {67, 259, 3, 17});
+}
+
+TYPED_TEST(ReferenceTest, BlockedConjugate)
+{
+    if(!TypeInfo<typename TestFixture::AType>::IsComplex)
+        GTEST_SKIP() << "conjugate requires a complex type";
+
+    this->CompareBlocked("Contraction_l_AlikC_BjlkC_Cijk_Dijk",
+                         "Contraction_lm_AlikmC_BjlkmC_Cijk_Dijk",
+                         {5, 300, 2, 33});
+}
+
+TYPED_TEST(ReferenceTest, BlockedBetaZeroIgnoresC)
+{
+    using DType = typename TestFixture::DType;
+    using CType = typename TestFixture::CType;
+
+    if(TypeInfo<CType>::IsIntegral)
+        GTEST_SKIP() << "NaN requires a floating point type";
+
+    auto problem = this->problem("Contraction_l_Ailk_Bljk_Cijk_Dijk", {19, 23, 2, 29});
+
+    auto a = this->template random<typename TestFixture::AType>(
+        problem.a().totalAllocatedElements());
+    auto b = this->template random<typename TestFixture::BType>(
+        problem.b().totalAllocatedElements());
+    std::vector<CType> c(problem.c().totalAllocatedElements(),
+                         static_cast<CType>(std::numeric_limits<float>::quiet_NaN()));
+    std::vector<DType> d(problem.d().totalAllocatedElements());
+
+    typename TestFixture::TypedInputs inputs(a.data(),
+                                             b.data(),
+                                             c.data(),
+                                             d.data(),
+                                             static_cast<typename TestFixture::AlphaType>(1),
+                                             static_cast<typename TestFixture::BetaType>(0));
+    SolveCPU(problem, inputs);
+
+    for(size_t i = 0; i < d.size(); i++)
+        ASSERT_EQ(d[i], d[i]) << i;
+}
+
+TYPED_TEST(ReferenceTest, ElementsMatchFullSolve)
+{
+    using DType = typename TestFixture::DType;
+
+    auto problem = this->problem("Contraction_l_Ailk_Bljk_Cijk_Dijk", {37, 21, 2, 45});
+
+    auto a = this->template random<typename TestFixture::AType>(
+        problem.a().totalAllocatedElements());
+    auto b = this->template random<typename TestFixture::BType>(
+        problem.b().totalAllocatedElements());
+    auto c = this->template random<typename TestFixture::CType>(
+        problem.c().totalAllocatedElements());
+
+    std::vector<DType> full(problem.d().totalAllocatedElements());
+    std::vector<DType> sampled(problem.d().totalAllocatedElements(), static_cast<DType>(0));
+
+    auto alpha = RandomValue<typename TestFixture::AlphaType>::Get(this->rng);
+    auto beta  = RandomValue<typename TestFixture::BetaType>::Get(this->rng);
+
+    typename TestFixture::TypedInputs fullInputs(
+        a.data(), b.data(), c.data(), full.data(), alpha, beta);
+    typename TestFixture::TypedInputs sampledInputs(
+        a.data(), b.data(), c.data(), sampled.data(), alpha, beta);
+
+    SolveCPU(problem, fullInputs);
+
+    std::vector<size_t> elements{0, 1, 36, 37, 500, problem.d().totalLogicalElements() - 1};
+    SolveCPUElements(problem, sampledInputs, elements);
+
+    for(size_t i = 0; i < sampled.size(); i++)
+    {
+        if(std::find(elements.begin(), elements.end(), i) != elements.end())
+            ASSERT_EQ(sampled[i], full[i]) << i;
+        else
+            ASSERT_EQ(sampled[i], static_cast<DType>(0)) << i;
+    }
+}
@@ -0,0 +1,231 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+
+#include <ResultComparison.hpp>
+
+using namespace Tensile;
+using namespace Tensile::Client;
+
+namespace
+{
+    struct ComparisonData
+    {
+        TensorDescriptor   tensor;
+        std::vector<float> reference;
+        std::vector<float> result;
+    };
+
+    /**
+     * Random reference and result buffers for `tensor`, with about one result
+     * value in `mismatchEvery` perturbed beyond the float tolerance.
+     */
+    ComparisonData MakeData(TensorDescriptor const& tensor, size_t mismatchEvery)
+    {
+        ComparisonData rv{tensor,
+                          std::vector<float>(tensor.totalAllocatedElements()),
+                          std::vector<float>(tensor.totalAllocatedElements())};
+
+        std::mt19937                          rng(17);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        std::uniform_int_distribution<size_t> pick(0, std::max<size_t>(mismatchEvery, 1) - 1);
+
+        for(size_t i = 0; i < rv.reference.size(); i++)
+        {
+            rv.reference[i] = value(rng);
+            rv.result[i]    = rv.reference[i];
+            if(mismatchEvery > 0 && pick(rng) == 0)
+                rv.result[i] += 0.5f;
+        }
+
+        return rv;
+    }
+
+    void CompareSerial(PointwiseComparison<float>& compare, ComparisonData const& data)
+    {
+        ForEachTensorRow(data.tensor,
+                         0,
+                         data.tensor.totalLogicalElements(),
+                         [&](size_t index, size_t stride, size_t number, size_t count) {
+                             std::cout << "row " << number / data.tensor.sizes()[0] << std::endl;
+                             for(size_t i = 0; i < count; i++)
+                             {
+                                 size_t elemIndex = index + i * stride;
+                                 compare(data.reference[elemIndex],
+                                         data.result[elemIndex],
+                                         elemIndex,
+                                         number + i);
+                             }
+                             return true;
+                         });
+    }
+
+    /**
+     * Runs the serial and parallel comparisons with the same settings and
+     * checks that they count and print the same things, including where each
+     * row starts.
+     */
+    void ExpectSameAsSerial(ComparisonData const& data,
+                            bool                  printValids,
+                            size_t                printMax,
+                            size_t                maxErrors)
+    {
+        PointwiseComparison<float> serial(printValids, printMax, true, maxErrors);
+        PointwiseComparison<float> parallel(printValids, printMax, true, maxErrors);
+
+        testing::internal::CaptureStdout();
+        CompareSerial(serial, data);
+        std::string serialOutput = testing::internal::GetCapturedStdout();
+
+        testing::internal::CaptureStdout();
+        parallel.compareTensor(
+            data.tensor, data.reference.data(), data.result.data(), [](size_t row) {
+                std::cout << "row " << row << std::endl;
+            });
+        std::string parallelOutput = testing::internal::GetCapturedStdout();
+
+        EXPECT_EQ(parallel.errors(), serial.errors());
+        EXPECT_EQ(parallel.values(), serial.values());
+        EXPECT_EQ(parallelOutput, serialOutput);
+    }
+} // namespace
+
+TEST(ResultComparison, ForEachTensorRow)
+{
+    TensorDescriptor tensor(DataType::Float, {5, 3, 2}, {2, 11, 40});
+
+    std::vector<size_t> coord(3);
+    std::vector<size_t> indices;
+    ForEachTensorRow(tensor, 3, 27, [&](size_t index, size_t stride, size_t number, size_t count) {
+        for(size_t i = 0; i < count; i++)
+        {
+            CoordNumbered(number + i,
+                          coord.begin(),
+                          coord.end(),
+                          tensor.sizes().begin(),
+                          tensor.sizes().end());
+            EXPECT_EQ(index + i * stride, tensor.index(coord));
+            indices.push_back(number + i);
+        }
+        return true;
+    });
+
+    ASSERT_EQ(indices.size(), 24);
+    for(size_t i = 0; i < indices.size(); i++)
+        EXPECT_EQ(indices[i], i + 3);
+}
+
+TEST(ResultComparison, PointwiseMatchesSerial)
+{
+    // Padded rows, so chunks start and end in the middle of a row.
+    auto data = MakeData(TensorDescriptor(DataType::Float, {300, 517, 3}, {1, 307, 307 * 520}),
+                         5000);
+
+    ExpectSameAsSerial(data, false, 0, 0);
+    ExpectSameAsSerial(data, false, 10, 0);
+    ExpectSameAsSerial(data, false, std::numeric_limits<size_t>::max(), 0);
+    ExpectSameAsSerial(data, true, 50, 0);
+}
+
+TEST(ResultComparison, PointwiseStridedRows)
+{
+    auto data = MakeData(TensorDescriptor(DataType::Float, {1000, 300}, {3, 3100}), 1000);
+
+    ExpectSameAsSerial(data, false, 20, 0);
+}
+
+TEST(ResultComparison, PointwiseEarlyExit)
+{
+    auto sparse = MakeData(TensorDescriptor(DataType::Float, {1024, 1024}), 20000);
+    ExpectSameAsSerial(sparse, false, 0, 7);
+    ExpectSameAsSerial(sparse, false, 3, 7);
+
+    PointwiseComparison<float> compare(false, 0, false, 7);
+    compare.compareTensor(sparse.tensor, sparse.reference.data(), sparse.result.data());
+    EXPECT_EQ(compare.errors(), 7);
+    EXPECT_LT(compare.values(), sparse.tensor.totalLogicalElements());
+
+    // Every value is wrong: each chunk fills up on its own.
+    auto dense = MakeData(TensorDescriptor(DataType::Float, {1024, 1024}), 1);
+    ExpectSameAsSerial(dense, false, 0, 100);
+    ExpectSameAsSerial(dense, false, 0, 200000);
+
+    // More errors allowed than there are.
+    ExpectSameAsSerial(sparse, false, 0, 1000000);
+}
+
+TEST(ResultComparison, RMSMatchesSerial)
+{
+    auto data = MakeData(TensorDescriptor(DataType::Float, {300, 517, 3}, {1, 307, 307 * 520}),
+                         5000);
+
+    RMSComparison<float> serial(1e-7, false);
+    RMSComparison<float> parallel(1e-7, false);
+
+    ForEachTensorRow(data.tensor,
+                     0,
+                     data.tensor.totalLogicalElements(),
+                     [&](size_t index, size_t stride, size_t number, size_t count) {
+                         for(size_t i = 0; i < count; i++)
+                             serial(data.reference[index + i * stride],
+                                    data.result[index + i * stride],
+                                    index + i * stride,
+                                    number + i);
+                         return true;
+                     });
+    parallel.compareTensor(data.tensor, data.reference.data(), data.result.data());
+
+    EXPECT_NEAR(parallel.errorValue(), serial.errorValue(), serial.errorValue() * 1e-12);
+    EXPECT_EQ(parallel.error(), serial.error());
+}
+
+TEST(ResultComparison, Performance)
+{
+    auto data = MakeData(TensorDescriptor(DataType::Float, {4096, 4096}), 0);
+
+    PointwiseComparison<float> serial(false, 0, false);
+    PointwiseComparison<float> parallel(false, 0, false);
+
+    auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < data.reference.size(); i++)
+        serial(data.reference[i], data.result[i], i, i);
+    std::chrono::duration<double> serialTime = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    parallel.compareTensor(data.tensor, data.reference.data(), data.result.data());
+    std::chrono::duration<double> parallelTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(serial.errors(), parallel.errors());
+    EXPECT_EQ(serial.values(), parallel.values());
+
+    std::cout << "serial: " << serialTime.count() << " s, compareTensor: " << parallelTime.count()
+              << " s" << std::endl;
+}
@@ -0,0 +1,256 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <ValidationSampler.hpp>
+
+#include <algorithm>
+#include <set>
+
+using namespace Tensile;
+using namespace Tensile::Client;
+
+namespace
+{
+    // Logical element number of (row, col, batch) in a packed Cijk GEMM output.
+    size_t element(size_t m, size_t n, size_t row, size_t col, size_t batch = 0)
+    {
+        return row + col * m + batch * m * n;
+    }
+
+    std::vector<size_t> tileElements(ValidationSampler const& sampler, size_t tile)
+    {
+        std::vector<size_t> rv;
+        sampler.elements(tile, rv);
+        return rv;
+    }
+} // namespace
+
+TEST(ValidationSampler, CornersFirst)
+{
+    auto problem
+        = ContractionProblem::GEMM(false, false, 1000, 700, 64, 1000, 64, 1000, 1.0, false, 3);
+
+    ValidationSampler sampler(problem, 128, 64, 10, 16, 1);
+
+    EXPECT_EQ(sampler.totalTiles(), 8 * 11 * 3);
+    ASSERT_EQ(sampler.tiles(), 10);
+
+    // The first four tiles are the corners of the first layer, the next four
+    // those of the last layer.
+    for(size_t layer : {0, 1})
+    {
+        std::set<size_t> corners;
+        for(size_t tile = 4 * layer; tile < 4 * layer + 4; tile++)
+            for(auto element : tileElements(sampler, tile))
+                corners.insert(element);
+
+        size_t batch = 2 * layer;
+        EXPECT_TRUE(corners.count(element(1000, 700, 0, 0, batch))) << batch;
+        EXPECT_TRUE(corners.count(element(1000, 700, 999, 0, batch))) << batch;
+        EXPECT_TRUE(corners.count(element(1000, 700, 0, 699, batch))) << batch;
+        EXPECT_TRUE(corners.count(element(1000, 700, 999, 699, batch))) << batch;
+    }
+}
+
+TEST(ValidationSampler, CornersOfEachEndLayer)
+{
+    // Free and batch sizes of D are 40 x 30 x 2 x 3; each tile is 16 x 16,
+    // so a layer is 3 x 2 tiles and there are 6 layers.
+    std::vector<size_t> sizes{40, 30, 2, 3, 8};
+    std::vector<size_t> empty;
+
+    auto problem = ContractionProblem::FromIndexSizes("Contraction_m_Aimkl_Bmjkl_Cijkl_Dijkl",
+                                                      sizes,
+                                                      DataType::Float,
+                                                      empty,
+                                                      DataType::Float,
+                                                      empty,
+                                                      DataType::Float,
+                                                      empty,
+                                                      DataType::Float,
+                                                      empty,
+                                                      1.0);
+    ASSERT_TRUE(ValidationSampler::Supports(problem));
+
+    ValidationSampler sampler(problem, 16, 16, 12, 0, 3);
+    ASSERT_EQ(sampler.totalTiles(), 3 * 2 * 6);
+    ASSERT_EQ(sampler.tiles(), 12);
+
+    // Elements are numbered with the row fastest, then the column and the
+    // two batch indices.
+    auto corner = [](size_t row, size_t col, size_t layer) {
+        return row + col * 40 + layer * 40 * 30;
+    };
+
+    std::set<size_t> corners;
+    for(size_t tile = 0; tile < 8; tile++)
+        for(auto element : tileElements(sampler, tile))
+            corners.insert(element);
+
+    for(size_t layer : {0, 5})
+    {
+        EXPECT_TRUE(corners.count(corner(0, 0, layer))) << layer;
+        EXPECT_TRUE(corners.count(corner(39, 0, layer))) << layer;
+        EXPECT_TRUE(corners.count(corner(0, 29, layer))) << layer;
+        EXPECT_TRUE(corners.count(corner(39, 29, layer))) << layer;
+    }
+
+    for(size_t layer = 1; layer < 5; layer++)
+        EXPECT_FALSE(corners.count(corner(0, 0, layer))) << layer;
+}
+
+TEST(ValidationSampler, TilePerimeter)
+{
+    auto problem
+        = ContractionProblem::GEMM(false, false, 300, 200, 64, 300, 64, 300, 1.0, false, 1);
+
+    // Enough tiles to take all of them, in order.
+    ValidationSampler sampler(problem, 128, 64, 100, 0, 1);
+    ASSERT_EQ(sampler.tiles(), 3 * 4);
+    ASSERT_EQ(sampler.tiles(), sampler.totalTiles());
+
+    // Tile (1, 2) spans rows [128, 256) and columns [128, 192).
+    auto elements = tileElements(sampler, 1 + 2 * 3);
+    std::set<size_t> unique(elements.begin(), elements.end());
+    EXPECT_EQ(unique.size(), elements.size());
+    EXPECT_EQ(elements.size(), 2 * 128 + 2 * 64 - 4);
+
+    for(size_t row = 128; row < 256; row++)
+    {
+        EXPECT_TRUE(unique.count(element(300, 200, row, 128)));
+        EXPECT_TRUE(unique.count(element(300, 200, row, 191)));
+    }
+    for(size_t col = 128; col < 192; col++)
+    {
+        EXPECT_TRUE(unique.count(element(300, 200, 128, col)));
+        EXPECT_TRUE(unique.count(element(300, 200, 255, col)));
+    }
+
+    // The last tile is partial: rows [256, 300) and columns [192, 200).
+    elements = tileElements(sampler, sampler.tiles() - 1);
+    EXPECT_EQ(elements.size(), 2 * 44 + 2 * 8 - 4);
+    EXPECT_NE(std::find(elements.begin(), elements.end(), element(300, 200, 299, 199)),
+              elements.end());
+}
+
+TEST(ValidationSampler, Stratified)
+{
+    auto problem
+        = ContractionProblem::GEMM(false, false, 4096, 4096, 64, 4096, 64, 4096, 1.0, false, 1);
+
+    size_t const tiles = 40;
+
+    ValidationSampler sampler(problem, 64, 64, tiles, 16, 7);
+    ASSERT_EQ(sampler.totalTiles(), 64 * 64);
+    ASSERT_EQ(sampler.tiles(), tiles);
+
+    // Each sampled tile after the corners lands in its own equal share of the
+    // tiles, numbered with tile 0 fastest.
+    size_t const strata = tiles - 4;
+    for(size_t stratum = 0; stratum < strata; stratum++)
+    {
+        auto   first   = tileElements(sampler, 4 + stratum).front();
+        size_t tileNum = first % 4096 / 64 + first / 4096 / 64 * 64;
+
+        EXPECT_GE(tileNum, stratum * sampler.totalTiles() / strata);
+        EXPECT_LT(tileNum, (stratum + 1) * sampler.totalTiles() / strata);
+    }
+
+    ValidationSampler same(problem, 64, 64, tiles, 16, 7);
+    ValidationSampler other(problem, 64, 64, tiles, 16, 8);
+    EXPECT_EQ(tileElements(sampler, 10), tileElements(same, 10));
+    EXPECT_NE(tileElements(sampler, 10), tileElements(other, 10));
+}
+
+TEST(ValidationSampler, UniformElements)
+{
+    auto problem
+        = ContractionProblem::GEMM(false, false, 300, 200, 64, 300, 64, 300, 1.0, false, 2);
+
+    ValidationSampler sampler(problem, 128, 64, 4, 16, 3);
+
+    std::vector<size_t> elements;
+    sampler.uniformElements(4000, elements);
+    ASSERT_EQ(elements.size(), 4000);
+
+    // Draws cover all of D, not just the chosen tiles.
+    size_t inFirstHalf = 0;
+    for(auto element : elements)
+    {
+        ASSERT_LT(element, 300 * 200 * 2);
+        inFirstHalf += element < 300 * 200;
+    }
+    EXPECT_GT(inFirstHalf, 1800);
+    EXPECT_LT(inFirstHalf, 2200);
+
+    // The draws depend on the seed only.
+    ValidationSampler more(problem, 128, 64, 40, 16, 3);
+    std::vector<size_t> same;
+    more.uniformElements(4000, same);
+    EXPECT_EQ(elements, same);
+}
+
+TEST(ValidationSampler, Supports)
+{
+    auto gemm = ContractionProblem::GEMM(false, false, 300, 200, 64, 300, 64, 300, 1.0, false, 1);
+    EXPECT_TRUE(ValidationSampler::Supports(gemm));
+
+    // A has no free index.
+    std::vector<size_t> sizes{200, 64};
+    std::vector<size_t> empty;
+    auto                gemv = ContractionProblem::FromIndexSizes("Contraction_j_Aj_Bij_Ci_Di",
+                                                   sizes,
+                                                   DataType::Float,
+                                                   empty,
+                                                   DataType::Float,
+                                                   empty,
+                                                   DataType::Float,
+                                                   empty,
+                                                   DataType::Float,
+                                                   empty,
+                                                   1.0);
+    EXPECT_FALSE(ValidationSampler::Supports(gemv));
+}
+
+TEST(ValidationSampler, ErrorRateUpperBound)
+{
+    EXPECT_EQ(ValidationSampler::ErrorRateUpperBound(0, 0), 1.0);
+    EXPECT_EQ(ValidationSampler::ErrorRateUpperBound(10, 10), 1.0);
+
+    // Rule of three: no failures in n samples bounds the rate near 3 / n.
+    EXPECT_NEAR(ValidationSampler::ErrorRateUpperBound(300, 0), 0.00994, 1e-4);
+
+    // Clopper-Pearson one-sided 95% bound for 1 failure in 100 samples.
+    EXPECT_NEAR(ValidationSampler::ErrorRateUpperBound(100, 1), 0.0466, 1e-3);
+
+    EXPECT_LT(ValidationSampler::ErrorRateUpperBound(100, 1),
+              ValidationSampler::ErrorRateUpperBound(100, 5));
+    EXPECT_LT(ValidationSampler::ErrorRateUpperBound(10000, 5),
+              ValidationSampler::ErrorRateUpperBound(100, 5));
+}
@@ -153,3 +153,72 @@ TEST(LLVMYAMLContractionTest, ContractionLibrary)
     llvm::yaml::Output yout(llvm::outs());
     yout << l;
 }
+
+TEST(LLVMYAMLContractionTest, KDTreeMatchingLibrary)
+{
+    std::string mydoc = "solutions:\n"
+                        "  - name: foo\n"
+                        "    sizeMapping:\n"
+                        "      globalAccumulation: 0\n"
+                        "      workspaceSizePerElemC: 0\n"
+                        "      workGroup: [1,2,3]\n"
+                        "      macroTile: [1,2,3]\n"
+                        "      threadTile: [1,2,3]\n"
+                        "      depthU: 8\n"
+                        "      globalSplitU: 1\n"
+                        "      staggerStrideShift: 3\n"
+                        "      staggerU: 32\n"
+                        "      workGroupMapping: 8\n"
+                        "      sourceKernel: false\n"
+                        "      persistentKernel: 0\n"
+                        "      persistentKernelAlongBatch: false\n"
+                        "    index: 0\n"
+                        "    hardwarePredicate: { type: TruePred }\n"
+                        "    problemPredicate:  { type: TruePred }\n"
+                        "    debugKernel: false\n"
+                        "    problemType:\n"
+                        "      operationIdentifier: foo\n"
+                        "      highPrecisionAccumulate: false\n"
+                        "      useBeta: true\n"
+                        "      aType: Float\n"
+                        "      bType: Float\n"
+                        "      cType: Float\n"
+                        "      dType: Float\n"
+                        "library:\n"
+                        "  type: Matching\n"
+                        "  distance: EuclideanKDTree\n"
+                        "  properties:\n"
+                        "    - { type: FreeSizeA, index: 0 }\n"
+                        "    - { type: FreeSizeB, index: 0 }\n"
+                        "  table:\n"
+                        "    - { key: [128, 128], speed: 1.0, index: 0 }\n"
+                        "    - { key: [256, 512], speed: 2.0, index: 0 }\n"
+                        "";
+
+    LibraryIOContext<ContractionSolution> context{std::string(""), {}, nullptr};
+    llvm::yaml::Input                     yin(mydoc, &context);
+
+    MasterContractionLibrary l;
+
+    yin >> l;
+
+    ASSERT_FALSE(yin.error());
+
+    auto library = l.library;
+    if(auto cache = std::dynamic_pointer_cast<
+           CachingLibrary<ContractionProblem, ContractionSolution>>(library))
+        library = cache->library();
+
+    auto matching = std::dynamic_pointer_cast<
+        ProblemMatchingLibrary<ContractionProblem, ContractionSolution>>(library);
+    ASSERT_NE(matching, nullptr);
+    EXPECT_EQ(matching->table->distanceType(), "EuclideanKDTree");
+
+    std::string             output;
+    llvm::raw_string_ostream stream(output);
+    llvm::yaml::Output      yout(stream);
+    yout << l;
+    stream.flush();
+
+    EXPECT_NE(output.find("EuclideanKDTree"), std::string::npos) << output;
+}
@@ -32,6 +32,11 @@
 
 #include "TestData.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
 using namespace Tensile;
 
 /**
@@ -123,8 +128,16 @@ TEST_P(LibraryPerformanceTest, LoadLibrary)
 
 TEST_P(LibraryPerformanceTest, CreateProblem)
 {
-    for(int i = 0; i < 1000000; i++)
+    // Includes drawing the random sizes; the operation strings are interned
+    // after the first few problems.
+    int const count = 1000000;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < count; i++)
         RandomGEMM();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << elapsed.count() / count << " ns/problem" << std::endl;
 }
 
 TEST_P(LibraryPerformanceTest, FindSolution)
@@ -161,6 +174,146 @@ TEST_P(LibraryPerformanceTest, FindCachedSolution)
     }
 }
 
+TEST_P(LibraryPerformanceTest, FindCachedSolutionThreaded)
+{
+    // Reports cached lookup throughput as the number of host threads grows.
+    std::vector<ContractionProblem> problems;
+    for(int i = 0; i < 100; i++)
+    {
+        problems.push_back(RandomGEMM());
+        library->findBestSolution(problems.back(), hardware);
+    }
+
+    int const lookupsPerThread = 10000;
+
+    for(int threads = 1; threads <= 64; threads *= 2)
+    {
+        std::atomic<int>         missing(0);
+        std::vector<std::thread> workers;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for(int t = 0; t < threads; t++)
+        {
+            workers.emplace_back([&, t]() {
+                for(int i = 0; i < lookupsPerThread; i++)
+                {
+                    auto const& problem  = problems[(i + t) % problems.size()];
+                    auto        solution = library->findBestSolution(problem, hardware);
+                    if(solution == nullptr)
+                        missing++;
+                }
+            });
+        }
+
+        for(auto& worker : workers)
+            worker.join();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << threads << " threads: "
+                  << static_cast<int64_t>(threads * lookupsPerThread / elapsed.count())
+                  << " lookups/s" << std::endl;
+
+        if(solutionRequired)
+            EXPECT_EQ(missing.load(), 0);
+    }
+}
+
+TEST_P(LibraryPerformanceTest, FindSolutions)
+{
+    // Batched lookup must agree with one lookup per problem.
+    auto master = std::dynamic_pointer_cast<MasterSolutionLibrary<ContractionProblem>>(library);
+    ASSERT_NE(master, nullptr);
+
+    auto cache = std::dynamic_pointer_cast<CachingLibrary<ContractionProblem>>(master->library);
+    auto uncached = cache ? cache->library() : master->library;
+
+    std::vector<ContractionProblem> problems;
+    for(int i = 0; i < 10000; i++)
+        problems.push_back(RandomGEMM());
+
+    std::vector<size_t> indices(problems.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    std::vector<std::shared_ptr<ContractionSolution>> solutions(problems.size());
+    std::vector<double> fitness(problems.size(), std::numeric_limits<double>::max());
+
+    auto start = std::chrono::steady_clock::now();
+    uncached->findBestSolutions(problems, indices, hardware, solutions, fitness);
+    std::chrono::duration<double> batched = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < problems.size(); i++)
+    {
+        auto solution = uncached->findBestSolution(problems[i], hardware);
+        ASSERT_EQ(solution, solutions[i]) << i << problems[i];
+
+        if(solutionRequired)
+            ASSERT_NE(solution, nullptr) << i << problems[i];
+    }
+    std::chrono::duration<double> single = std::chrono::steady_clock::now() - start;
+
+    std::cout << "batched: " << batched.count() << " s, one at a time: " << single.count()
+              << " s" << std::endl;
+
+    for(size_t threads : {1, 4})
+    {
+        auto threaded = master->findBestSolutions(problems, hardware, nullptr, threads);
+        for(size_t i = 0; i < problems.size(); i++)
+            ASSERT_EQ(threaded[i], solutions[i]) << threads << " " << i << problems[i];
+    }
+}
+
+TEST_P(LibraryPerformanceTest, FindSolutionView)
+{
+    // Compares lookups that share one memoized view between the levels of
+    // the library against lookups that compute every property read.
+    auto master = std::dynamic_pointer_cast<MasterSolutionLibrary<ContractionProblem>>(library);
+    ASSERT_NE(master, nullptr);
+
+    auto cache = std::dynamic_pointer_cast<CachingLibrary<ContractionProblem>>(master->library);
+    auto uncached = cache ? cache->library() : master->library;
+
+    std::vector<ContractionProblem> problems;
+    for(int i = 0; i < 10000; i++)
+        problems.push_back(RandomGEMM());
+
+    std::vector<std::shared_ptr<ContractionSolution>> solutions(problems.size());
+
+    size_t computed[2] = {0, 0};
+    double seconds[2]  = {0, 0};
+
+    for(bool memoize : {false, true})
+    {
+        auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < problems.size(); i++)
+        {
+            ContractionProblemView view(problems[i], memoize);
+
+            auto solution = uncached->findBestSolution(view, hardware);
+            computed[memoize] += view.computeCount();
+
+            if(memoize)
+                ASSERT_EQ(solution, solutions[i]) << i << problems[i];
+            else
+                solutions[i] = solution;
+
+            if(solutionRequired)
+                ASSERT_NE(solution, nullptr) << i << problems[i];
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        seconds[memoize]                      = elapsed.count();
+    }
+
+    ASSERT_LE(computed[true], computed[false]);
+
+    std::cout << "shared view: " << seconds[true] << " s, "
+              << double(computed[true]) / problems.size() << " values per lookup; unshared: "
+              << seconds[false] << " s, " << double(computed[false]) / problems.size()
+              << " values per lookup" << std::endl;
+}
+
 TEST_P(LibraryPerformanceTest, Solve)
 {
     float                                a, b, c, d;
@@ -188,6 +341,115 @@ TEST_P(LibraryPerformanceTest, Solve)
     }
 }
 
+TEST_P(LibraryPerformanceTest, SolveReusingKernels)
+{
+    float                                a, b, c, d;
+    ContractionProblem                   problem;
+    std::shared_ptr<ContractionSolution> solution;
+
+    for(int i = 0; i < 10 && solution == nullptr; i++)
+    {
+        problem  = RandomGEMM();
+        solution = library->findBestSolution(problem, hardware);
+
+        if(solutionRequired)
+        {
+            EXPECT_NE(solution, nullptr) << problem;
+        }
+    }
+
+    if(solution)
+    {
+        TypedContractionInputs<float> inputs{&a, &b, &c, &d, 1.0, float(problem.beta())};
+
+        auto reference = solution->solve(problem, inputs, hardware);
+
+        std::vector<KernelInvocation> kernels;
+        for(int i = 0; i < 100000; i++)
+        {
+            solution->solve(problem, inputs, hardware, kernels);
+        }
+
+        ASSERT_EQ(kernels.size(), reference.size());
+        for(size_t i = 0; i < kernels.size(); i++)
+        {
+            EXPECT_EQ(kernels[i].kernelName, reference[i].kernelName);
+            ASSERT_EQ(kernels[i].args.size(), reference[i].args.size());
+            EXPECT_EQ(
+                memcmp(kernels[i].args.data(), reference[i].args.data(), kernels[i].args.size()),
+                0);
+        }
+    }
+}
+
+TEST_P(LibraryPerformanceTest, PreparedCall)
+{
+    // Rebinding a prepared call must give the same arguments as solving again.
+    float a[2], b[2], c[2], d[2], ws[2];
+
+    std::shared_ptr<ContractionSolution> solution;
+    ContractionProblem                   problem;
+
+    for(int i = 0; i < 100; i++)
+    {
+        problem  = RandomGEMM();
+        solution = library->findBestSolution(problem, hardware);
+
+        if(!solution)
+            continue;
+
+        float beta = problem.beta();
+
+        TypedContractionInputs<float> first{a, b, c, d, 1.0, beta, ws};
+        TypedContractionInputs<float> second{a + 1, b + 1, c + 1, d + 1, 2.0, beta, ws + 1};
+        if(problem.cEqualsD())
+            first.c = first.d, second.c = second.d;
+
+        auto prepared = solution->prepare(problem, first, hardware);
+        prepared.bind(second);
+
+        auto reference = solution->solve(problem, second, hardware);
+
+        auto const& kernels = prepared.kernels();
+        ASSERT_EQ(kernels.size(), reference.size());
+        for(size_t k = 0; k < kernels.size(); k++)
+        {
+            EXPECT_EQ(kernels[k].kernelName, reference[k].kernelName);
+            EXPECT_EQ(kernels[k].numWorkGroups.x, reference[k].numWorkGroups.x);
+            ASSERT_EQ(kernels[k].args.size(), reference[k].args.size());
+            EXPECT_EQ(
+                memcmp(kernels[k].args.data(), reference[k].args.data(), kernels[k].args.size()),
+                0)
+                << i << " " << k << " " << solution->name();
+        }
+    }
+
+    if(solution)
+    {
+        float beta = problem.beta();
+
+        TypedContractionInputs<float> inputs{a, b, c, d, 1.0, beta};
+        if(problem.cEqualsD())
+            inputs.c = inputs.d;
+
+        auto prepared = solution->prepare(problem, inputs, hardware);
+
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < 100000; i++)
+            prepared.bind(inputs);
+        std::chrono::duration<double> bound = std::chrono::steady_clock::now() - start;
+
+        std::vector<KernelInvocation> kernels;
+        start = std::chrono::steady_clock::now();
+        for(int i = 0; i < 100000; i++)
+            solution->solve(problem, inputs, hardware, kernels);
+        std::chrono::duration<double> solved = std::chrono::steady_clock::now() - start;
+
+        std::cout << "bind: " << bound.count() << " s, solve: " << solved.count() << " s"
+                  << std::endl;
+    }
+}
+
 TEST_P(LibraryPerformanceTest, SolveWithLog)
 {
     float                                a, b, c, d;
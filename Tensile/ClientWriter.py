@@ -409,7 +409,8 @@ def dataInitParams(problemType):
             ('init-c',     DataInitName(initC).name),
             ('init-d',     DataInitName(initD).name),
             ('init-alpha', DataInitName(initAlpha).name),
-            ('init-beta',  DataInitName(initBeta).name)]
+            ('init-beta',  DataInitName(initBeta).name),
+            ('init-seed',  globalParameters['DataInitSeed'])]
 
 def boundsCheckName(mode):
     if mode == 0: return 'Disable'
@@ -488,6 +489,9 @@ def writeClientConfigIni(problemSizes, problemType, sourceDir, codeObjectFiles,
         param("print-valids",             globalParameters["ValidationPrintValids"])
         param("print-max",                globalParameters["ValidationMaxToPrint"])
         param("num-elements-to-validate", globalParameters["NumElementsToValidate"])
+        param("validation-sample-tiles",  globalParameters["ValidationSampleTiles"])
+        param("validation-time-budget",   globalParameters["ValidationTimeBudget"])
+        param("validation-max-errors",    globalParameters["ValidationMaxErrors"])
         param("num-benchmarks",           globalParameters["NumBenchmarks"])
         param("num-warmups",              globalParameters["NumWarmups"])
         param("num-enqueues-per-sync",    globalParameters["EnqueuesPerSync"])
@@ -79,6 +79,9 @@ globalParameters["BoundsCheck"] = 0   # Bounds check
 
 globalParameters["ValidationMaxToPrint"] = 4      # maximum number of mismatches to print
 globalParameters["ValidationPrintValids"] = False # print matches too
+globalParameters["ValidationSampleTiles"] = 0     # >0: validate a stratified sample of this many macro tiles (corners first) instead of NumElementsToValidate strided elements
+globalParameters["ValidationTimeBudget"] = 0      # seconds of CPU reference time per problem when sampling tiles, 0 for no limit
+globalParameters["ValidationMaxErrors"] = 0       # >0: stop validating a solution after this many mismatches
 # steps
 globalParameters["ForceRedoBenchmarkProblems"] = True # if False and benchmarking already complete, then benchmarking will be skipped when tensile is re-run
 globalParameters["ForceRedoLibraryLogic"] = True      # if False and library logic already analyzed, then library logic will be skipped when tensile is re-run
@@ -150,6 +153,7 @@ globalParameters["DataInitTypeC"]  = 3
 globalParameters["DataInitTypeD"]  = 0
 globalParameters["DataInitTypeAlpha"] = 2
 globalParameters["DataInitTypeBeta"] = 2
+globalParameters["DataInitSeed"] = 0              # seed of the random init modes; the same seed gives the same data
 globalParameters["CEqualD"] = False               # Set to true if testing for the case where the pointer to C is the same as D.
 globalParameters["BufferOffsetA"] = 0             # data offset of buffer A
 globalParameters["BufferOffsetB"] = 0             # data offset of buffer B
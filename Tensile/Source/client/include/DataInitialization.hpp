@@ -32,7 +32,9 @@
 
 #include "ClientProblemFactory.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <random>
 
 #include "RunListener.hpp"
@@ -99,6 +101,91 @@ namespace Tensile
         std::ostream& operator<<(std::ostream& stream, BoundsCheckMode const& mode);
         std::istream& operator>>(std::istream& stream, BoundsCheckMode& mode);
 
+        /**
+         * Identifies the values an initialization mode writes into a buffer.
+         * The tensor only matters for problem-dependent modes; other modes
+         * fill the whole buffer regardless of the problem.
+         */
+        struct InitKey
+        {
+            InitMode         mode     = InitMode::Zero;
+            DataType         dataType = DataType::Float;
+            TensorDescriptor tensor;
+
+            /**
+             * True if a buffer holding the values of this key also holds the
+             * values of `other` at every element `other` addresses.  For the
+             * coordinate-based modes (SerialDim0/1, Identity) a smaller tensor
+             * with the same layout is a sub-view.  The index-based modes
+             * (SerialIdx, Trig*) number elements in order, so only the last
+             * dimension may shrink.
+             */
+            bool covers(InitKey const& other) const;
+        };
+
+        /**
+         * Bytes of input data written while preparing inputs, and the bytes
+         * that reusing already-valid buffers avoided writing.
+         */
+        struct InputTraffic
+        {
+            size_t generatedBytes = 0;
+            size_t reusedBytes    = 0;
+            size_t copiedBytes    = 0;
+            size_t skippedBytes   = 0;
+        };
+
+        std::ostream& operator<<(std::ostream& stream, InputTraffic const& traffic);
+
+        /**
+         * Counter-based random number generator.  Each draw is the SplitMix64
+         * output function of a key and an incrementing counter, so a value
+         * depends only on the key and its position in the stream.  Buffers can
+         * then be filled in parallel with contents that do not depend on the
+         * number of threads.
+         */
+        class CounterRandom
+        {
+        public:
+            /// Upper bound on the draws made for a single element of any type.
+            static const uint64_t DrawsPerElement = 4;
+
+            CounterRandom(uint64_t key, uint64_t counter)
+                : m_key(key)
+                , m_counter(counter)
+            {
+            }
+
+            static uint64_t Mix(uint64_t z)
+            {
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+                return z ^ (z >> 31);
+            }
+
+            /// Key of the `stream`-th independent stream for `seed`.
+            static uint64_t Key(uint64_t seed, uint64_t stream)
+            {
+                return Mix(Mix(seed) + stream);
+            }
+
+            uint64_t operator()()
+            {
+                return Mix(m_key + 0x9e3779b97f4a7c15 * m_counter++);
+            }
+
+            /// Uniform integer in [low, high].
+            int uniform(int low, int high)
+            {
+                uint64_t range = static_cast<uint64_t>(high - low) + 1;
+                return low + static_cast<int>((((*this)() >> 32) * range) >> 32);
+            }
+
+        private:
+            uint64_t m_key;
+            uint64_t m_counter;
+        };
+
         template <typename TypedInputs>
         class TypedDataInitialization;
 
@@ -186,8 +273,39 @@ namespace Tensile
                 }
             }
 
+            /**
+             * Restarts the generator behind getValue<T, Mode>() for the
+             * random modes on every thread from `seed`.
+             */
+            static void SeedThreadRandom(uint64_t seed)
+            {
+                s_threadSeed = seed;
+                s_threadSeedCount++;
+            }
+
+            /**
+             * Fixed-value modes are specialized for each type.  Random modes
+             * draw from a per-thread generator keyed from SeedThreadRandom();
+             * use the CounterRandom overload for values that do not depend on
+             * the calling thread.
+             */
             template <typename T, InitMode Mode>
-            static inline T getValue();
+            static inline T getValue()
+            {
+                static_assert(Mode == InitMode::Random || Mode == InitMode::RandomNarrow,
+                              "No value defined for this InitMode.");
+                return getValue<T, Mode>(threadRandom());
+            }
+
+            /**
+             * Random modes are specialized for each type and draw at most
+             * CounterRandom::DrawsPerElement values from `rng`.
+             */
+            template <typename T, InitMode Mode>
+            static inline T getValue(CounterRandom& rng)
+            {
+                return getValue<T, Mode>();
+            }
 
             template <typename T>
             static inline T getTrigValue(int idx, bool useCos, bool useAbs);
@@ -199,49 +317,53 @@ namespace Tensile
             static bool isBadOutput(T value);
 
             // Fills max buffer size
+            /**
+             * `stream` selects an independent sequence of random values, so
+             * buffers initialized with the same seed do not repeat each other.
+             */
             template <typename T>
-            void initArray(InitMode mode, T* array, size_t elements)
+            void initArray(InitMode mode, T* array, size_t elements, uint64_t stream = 0)
             {
                 switch(mode)
                 {
                 case InitMode::Zero:
-                    initArray<T, InitMode::Zero>(array, elements);
+                    initArray<T, InitMode::Zero>(array, elements, stream);
                     break;
                 case InitMode::One:
-                    initArray<T, InitMode::One>(array, elements);
+                    initArray<T, InitMode::One>(array, elements, stream);
                     break;
                 case InitMode::Two:
-                    initArray<T, InitMode::Two>(array, elements);
+                    initArray<T, InitMode::Two>(array, elements, stream);
                     break;
                 case InitMode::Random:
-                    initArray<T, InitMode::Random>(array, elements);
+                    initArray<T, InitMode::Random>(array, elements, stream);
                     break;
                 case InitMode::RandomNarrow:
-                    initArray<T, InitMode::RandomNarrow>(array, elements);
+                    initArray<T, InitMode::RandomNarrow>(array, elements, stream);
                     break;
                 case InitMode::NaN:
-                    initArray<T, InitMode::NaN>(array, elements);
+                    initArray<T, InitMode::NaN>(array, elements, stream);
                     break;
                 case InitMode::Inf:
-                    initArray<T, InitMode::Inf>(array, elements);
+                    initArray<T, InitMode::Inf>(array, elements, stream);
                     break;
                 case InitMode::BadInput:
-                    initArray<T, InitMode::BadInput>(array, elements);
+                    initArray<T, InitMode::BadInput>(array, elements, stream);
                     break;
                 case InitMode::BadOutput:
-                    initArray<T, InitMode::BadOutput>(array, elements);
+                    initArray<T, InitMode::BadOutput>(array, elements, stream);
                     break;
                 case InitMode::NegOne:
-                    initArray<T, InitMode::NegOne>(array, elements);
+                    initArray<T, InitMode::NegOne>(array, elements, stream);
                     break;
                 case InitMode::Max:
-                    initArray<T, InitMode::Max>(array, elements);
+                    initArray<T, InitMode::Max>(array, elements, stream);
                     break;
                 case InitMode::DenormMin:
-                    initArray<T, InitMode::DenormMin>(array, elements);
+                    initArray<T, InitMode::DenormMin>(array, elements, stream);
                     break;
                 case InitMode::DenormMax:
-                    initArray<T, InitMode::DenormMax>(array, elements);
+                    initArray<T, InitMode::DenormMax>(array, elements, stream);
                     break;
                 case InitMode::SerialIdx:
                 case InitMode::SerialDim0:
@@ -258,48 +380,51 @@ namespace Tensile
 
             // For problem dependent data initialization
             template <typename T>
-            void initArray(InitMode mode, T* array, TensorDescriptor const& tensor)
+            void initArray(InitMode                mode,
+                           T*                      array,
+                           TensorDescriptor const& tensor,
+                           uint64_t                stream = 0)
             {
                 switch(mode)
                 {
                 case InitMode::Zero:
-                    initArray<T, InitMode::Zero>(array, tensor);
+                    initArray<T, InitMode::Zero>(array, tensor, stream);
                     break;
                 case InitMode::One:
-                    initArray<T, InitMode::One>(array, tensor);
+                    initArray<T, InitMode::One>(array, tensor, stream);
                     break;
                 case InitMode::Two:
-                    initArray<T, InitMode::Two>(array, tensor);
+                    initArray<T, InitMode::Two>(array, tensor, stream);
                     break;
                 case InitMode::Random:
-                    initArray<T, InitMode::Random>(array, tensor);
+                    initArray<T, InitMode::Random>(array, tensor, stream);
                     break;
                 case InitMode::RandomNarrow:
-                    initArray<T, InitMode::RandomNarrow>(array, tensor);
+                    initArray<T, InitMode::RandomNarrow>(array, tensor, stream);
                     break;
                 case InitMode::NaN:
-                    initArray<T, InitMode::NaN>(array, tensor);
+                    initArray<T, InitMode::NaN>(array, tensor, stream);
                     break;
                 case InitMode::Inf:
-                    initArray<T, InitMode::Inf>(array, tensor);
+                    initArray<T, InitMode::Inf>(array, tensor, stream);
                     break;
                 case InitMode::BadInput:
-                    initArray<T, InitMode::BadInput>(array, tensor);
+                    initArray<T, InitMode::BadInput>(array, tensor, stream);
                     break;
                 case InitMode::BadOutput:
-                    initArray<T, InitMode::BadOutput>(array, tensor);
+                    initArray<T, InitMode::BadOutput>(array, tensor, stream);
                     break;
                 case InitMode::NegOne:
-                    initArray<T, InitMode::NegOne>(array, tensor);
+                    initArray<T, InitMode::NegOne>(array, tensor, stream);
                     break;
                 case InitMode::Max:
-                    initArray<T, InitMode::Max>(array, tensor);
+                    initArray<T, InitMode::Max>(array, tensor, stream);
                     break;
                 case InitMode::DenormMin:
-                    initArray<T, InitMode::DenormMin>(array, tensor);
+                    initArray<T, InitMode::DenormMin>(array, tensor, stream);
                     break;
                 case InitMode::DenormMax:
-                    initArray<T, InitMode::DenormMax>(array, tensor);
+                    initArray<T, InitMode::DenormMax>(array, tensor, stream);
                     break;
                 case InitMode::SerialIdx:
                     initArraySerialIdx<T>(array, tensor);
@@ -331,19 +456,23 @@ namespace Tensile
             }
 
             template <typename T, InitMode Mode>
-            void initArray(T* array, size_t elements)
+            void initArray(T* array, size_t elements, uint64_t stream = 0)
             {
+                uint64_t key = CounterRandom::Key(m_seed, stream);
+
+#pragma omp parallel for simd schedule(static) if(elements >= (1 << 16))
                 for(size_t i = 0; i < elements; i++)
                 {
-                    array[i] = getValue<T, Mode>();
+                    CounterRandom rng(key, i * CounterRandom::DrawsPerElement);
+                    array[i] = getValue<T, Mode>(rng);
                 }
             }
 
             template <typename T, InitMode Mode>
-            void initArray(T* array, TensorDescriptor const& tensor)
+            void initArray(T* array, TensorDescriptor const& tensor, uint64_t stream = 0)
             {
                 size_t elements = tensor.totalAllocatedElements();
-                initArray<T, Mode>(array, elements);
+                initArray<T, Mode>(array, elements, stream);
             }
 
             template <typename T>
@@ -457,17 +586,47 @@ namespace Tensile
                                           TimingEvents const&                startEvents,
                                           TimingEvents const&                stopEvents) override{};
 
-            virtual void finalizeReport() override{};
+            /// Reports the input traffic saved by reusing pristine data.
+            virtual void finalizeReport() override;
 
             virtual int error() const override
             {
                 return 0;
             };
 
+            InputTraffic const& inputTraffic() const
+            {
+                return m_inputTraffic;
+            }
+
         protected:
+            /// Stream of the seed reserved for threadRandom().
+            static const uint64_t ThreadRandomStream = ~0ull;
+
+            /// Generator behind getValue<T, Mode>() for the random modes.
+            static CounterRandom& threadRandom()
+            {
+                thread_local uint64_t      seedCount = 0;
+                thread_local CounterRandom rng(CounterRandom::Key(0, ThreadRandomStream), 0);
+
+                if(seedCount != s_threadSeedCount)
+                {
+                    seedCount = s_threadSeedCount;
+                    rng = CounterRandom(CounterRandom::Key(s_threadSeed, ThreadRandomStream), 0);
+                }
+
+                return rng;
+            }
+
+            static inline std::atomic<uint64_t> s_threadSeed{0};
+            static inline std::atomic<uint64_t> s_threadSeedCount{0};
+
             InitMode m_aInit, m_bInit, m_cInit, m_dInit;
             InitMode m_alphaInit, m_betaInit;
 
+            /// Seed of the random initialization modes.
+            uint64_t m_seed = 0;
+
             size_t m_aBufferOffset;
             size_t m_bBufferOffset;
             size_t m_cBufferOffset;
@@ -512,6 +671,8 @@ namespace Tensile
             /// and must be reinitialized for each problem. Pristine copy on GPU
             /// cannot be used with problem dependent data.
             bool m_problemDependentData = false;
+
+            InputTraffic m_inputTraffic;
         };
 
         template <>
@@ -568,9 +729,9 @@ namespace Tensile
         }
 
         template <>
-        inline float DataInitialization::getValue<float, InitMode::Random>()
+        inline float DataInitialization::getValue<float, InitMode::Random>(CounterRandom& rng)
         {
-            return static_cast<float>((rand() % 201) - 100);
+            return static_cast<float>(rng.uniform(-100, 100));
         }
 
         template <>
@@ -638,9 +799,9 @@ namespace Tensile
         }
 
         template <>
-        inline double DataInitialization::getValue<double, InitMode::Random>()
+        inline double DataInitialization::getValue<double, InitMode::Random>(CounterRandom& rng)
         {
-            return static_cast<double>((rand() % 2001) - 1000);
+            return static_cast<double>(rng.uniform(-1000, 1000));
         }
 
         template <>
@@ -727,10 +888,11 @@ namespace Tensile
 
         template <>
         inline std::complex<float>
-            DataInitialization::getValue<std::complex<float>, InitMode::Random>()
+            DataInitialization::getValue<std::complex<float>, InitMode::Random>(CounterRandom& rng)
         {
-            return std::complex<float>(getValue<float, InitMode::Random>(),
-                                       getValue<float, InitMode::Random>());
+            float real = getValue<float, InitMode::Random>(rng);
+            float imag = getValue<float, InitMode::Random>(rng);
+            return std::complex<float>(real, imag);
         }
 
         template <>
@@ -814,10 +976,11 @@ namespace Tensile
 
         template <>
         inline std::complex<double>
-            DataInitialization::getValue<std::complex<double>, InitMode::Random>()
+            DataInitialization::getValue<std::complex<double>, InitMode::Random>(CounterRandom& rng)
         {
-            return std::complex<double>(getValue<double, InitMode::Random>(),
-                                        getValue<double, InitMode::Random>());
+            double real = getValue<double, InitMode::Random>(rng);
+            double imag = getValue<double, InitMode::Random>(rng);
+            return std::complex<double>(real, imag);
         }
 
         template <>
@@ -880,9 +1043,9 @@ namespace Tensile
         }
 
         template <>
-        inline int32_t DataInitialization::getValue<int32_t, InitMode::Random>()
+        inline int32_t DataInitialization::getValue<int32_t, InitMode::Random>(CounterRandom& rng)
         {
-            return rand() % 7 - 3;
+            return rng.uniform(-3, 3);
         }
 
         template <>
@@ -943,12 +1106,12 @@ namespace Tensile
         }
 
         template <>
-        inline Int8x4 DataInitialization::getValue<Int8x4, InitMode::Random>()
+        inline Int8x4 DataInitialization::getValue<Int8x4, InitMode::Random>(CounterRandom& rng)
         {
-            return Int8x4{static_cast<int8_t>((rand() % 7) - 3),
-                          static_cast<int8_t>((rand() % 7) - 3),
-                          static_cast<int8_t>((rand() % 7) - 3),
-                          static_cast<int8_t>((rand() % 7) - 3)};
+            return Int8x4{static_cast<int8_t>(rng.uniform(-3, 3)),
+                          static_cast<int8_t>(rng.uniform(-3, 3)),
+                          static_cast<int8_t>(rng.uniform(-3, 3)),
+                          static_cast<int8_t>(rng.uniform(-3, 3))};
         }
 
         template <>
@@ -1040,9 +1203,9 @@ namespace Tensile
         }
 
         template <>
-        inline Half DataInitialization::getValue<Half, InitMode::Random>()
+        inline Half DataInitialization::getValue<Half, InitMode::Random>(CounterRandom& rng)
         {
-            return static_cast<Half>((rand() % 7) - 3);
+            return static_cast<Half>(rng.uniform(-3, 3));
         }
 
         template <>
@@ -1107,9 +1270,9 @@ namespace Tensile
         }
 
         template <>
-        inline BFloat16 DataInitialization::getValue<BFloat16, InitMode::Random>()
+        inline BFloat16 DataInitialization::getValue<BFloat16, InitMode::Random>(CounterRandom& rng)
         {
-            return static_cast<BFloat16>((rand() % 7) - 3);
+            return static_cast<BFloat16>(rng.uniform(-3, 3));
         }
 
         template <>
@@ -1170,9 +1333,9 @@ namespace Tensile
         }
 
         template <>
-        inline int8_t DataInitialization::getValue<int8_t, InitMode::Random>()
+        inline int8_t DataInitialization::getValue<int8_t, InitMode::Random>(CounterRandom& rng)
         {
-            return static_cast<int8_t>((rand() % 7) - 3);
+            return static_cast<int8_t>(rng.uniform(-3, 3));
         }
 
         template <>
@@ -1401,7 +1564,6 @@ namespace Tensile
             using typename FP_PARAM<T>::UINT_T;
             using FP_PARAM<T>::NUMSIG;
             using FP_PARAM<T>::NUMEXP;
-            using random_fp_int_dist = std::uniform_int_distribution<UINT_T>;
 
             static_assert(sizeof(UINT_T) == sizeof(T), "Type sizes do not match");
             static constexpr UINT_T expmask = (((UINT_T)1 << NUMEXP) - 1) << NUMSIG;
@@ -1431,13 +1593,11 @@ namespace Tensile
         template <typename T, int LOW_EXP, int HIGH_EXP>
         struct rocm_random : rocm_random_common<T>
         {
-            using typename rocm_random_common<T>::random_fp_int_dist;
-            __attribute__((flatten)) T operator()()
+            using typename rocm_random_common<T>::UINT_T;
+            __attribute__((flatten)) T operator()(CounterRandom& rng)
             {
-                static std::mt19937 rng;
-                int                 exp = std::uniform_int_distribution<int>{}(rng);
-                exp                     = exp % (HIGH_EXP - LOW_EXP + 1) + LOW_EXP;
-                return this->signsig_exp(random_fp_int_dist{}(rng), exp);
+                int exp = rng.uniform(LOW_EXP, HIGH_EXP);
+                return this->signsig_exp(static_cast<UINT_T>(rng()), exp);
             }
         };
 
@@ -1465,61 +1625,70 @@ namespace Tensile
         };
 
         template <>
-        inline float DataInitialization::getValue<float, InitMode::RandomNarrow>()
+        inline float DataInitialization::getValue<float, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return rocm_random_narrow_range<float>{}();
+            return rocm_random_narrow_range<float>{}(rng);
         }
 
         template <>
-        inline double DataInitialization::getValue<double, InitMode::RandomNarrow>()
+        inline double
+            DataInitialization::getValue<double, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return rocm_random_narrow_range<double>{}();
+            return rocm_random_narrow_range<double>{}(rng);
         }
 
         template <>
-        inline BFloat16 DataInitialization::getValue<BFloat16, InitMode::RandomNarrow>()
+        inline BFloat16
+            DataInitialization::getValue<BFloat16, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return rocm_random_narrow_range<BFloat16>{}();
+            return rocm_random_narrow_range<BFloat16>{}(rng);
         }
 
         template <>
-        inline Half DataInitialization::getValue<Half, InitMode::RandomNarrow>()
+        inline Half DataInitialization::getValue<Half, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return rocm_random_narrow_range<Half>{}();
+            return rocm_random_narrow_range<Half>{}(rng);
         }
 
         template <>
         inline std::complex<float>
-            DataInitialization::getValue<std::complex<float>, InitMode::RandomNarrow>()
+            DataInitialization::getValue<std::complex<float>, InitMode::RandomNarrow>(
+                CounterRandom& rng)
         {
-            return std::complex<float>(rocm_random_narrow_range<float>{}(),
-                                       rocm_random_narrow_range<float>{}());
+            float real = rocm_random_narrow_range<float>{}(rng);
+            float imag = rocm_random_narrow_range<float>{}(rng);
+            return std::complex<float>(real, imag);
         }
 
         template <>
         inline std::complex<double>
-            DataInitialization::getValue<std::complex<double>, InitMode::RandomNarrow>()
+            DataInitialization::getValue<std::complex<double>, InitMode::RandomNarrow>(
+                CounterRandom& rng)
         {
-            return std::complex<double>(rocm_random_narrow_range<double>{}(),
-                                        rocm_random_narrow_range<double>{}());
+            double real = rocm_random_narrow_range<double>{}(rng);
+            double imag = rocm_random_narrow_range<double>{}(rng);
+            return std::complex<double>(real, imag);
         }
 
         template <>
-        inline int32_t DataInitialization::getValue<int32_t, InitMode::RandomNarrow>()
+        inline int32_t
+            DataInitialization::getValue<int32_t, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return getValue<int32_t, InitMode::Random>();
+            return getValue<int32_t, InitMode::Random>(rng);
         }
 
         template <>
-        inline Int8x4 DataInitialization::getValue<Int8x4, InitMode::RandomNarrow>()
+        inline Int8x4
+            DataInitialization::getValue<Int8x4, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return getValue<Int8x4, InitMode::Random>();
+            return getValue<Int8x4, InitMode::Random>(rng);
         }
 
         template <>
-        inline int8_t DataInitialization::getValue<int8_t, InitMode::RandomNarrow>()
+        inline int8_t
+            DataInitialization::getValue<int8_t, InitMode::RandomNarrow>(CounterRandom& rng)
         {
-            return getValue<int8_t, InitMode::Random>();
+            return getValue<int8_t, InitMode::Random>(rng);
         }
     } // namespace Client
 } // namespace Tensile
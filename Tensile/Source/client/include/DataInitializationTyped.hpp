@@ -34,6 +34,8 @@
 #include <Tensile/Debug.hpp>
 #include <Tensile/hip/HipUtils.hpp>
 
+#include <array>
+
 namespace Tensile
 {
     namespace Client
@@ -120,6 +122,10 @@ namespace Tensile
             size_t workspaceSize;
 
             bool gpu;
+
+            /// Pristine generation held by each of A, B, C, D; 0 if unknown or
+            /// modified since it was copied.
+            std::array<size_t, 4> versions = {};
         };
 
         template <typename TypedInputs>
@@ -621,30 +627,72 @@ namespace Tensile
                 if(inputs.gpu)
                     throw std::runtime_error("Initializing GPU inputs as CPU.");
 
-                if(m_problem.a() != problem.a() || m_problem.b() != problem.b()
-                   || m_problem.c() != problem.c() || (!m_cEqualsD && m_problem.d() != problem.d()))
-                {
-                    if(m_problemDependentData)
-                    {
-                        initArray(m_aInit, inputs.managedA.get(), problem.a());
-                        initArray(m_bInit, inputs.managedB.get(), problem.b());
-                        initArray(m_cInit, inputs.managedC.get(), problem.c());
-                        if(!m_cEqualsD)
-                            initArray(m_dInit, inputs.managedD.get(), problem.d());
-                    }
-                    else
-                    {
-                        initArray(m_aInit, inputs.managedA.get(), m_aMaxElements);
-                        initArray(m_bInit, inputs.managedB.get(), m_bMaxElements);
-                        initArray(m_cInit, inputs.managedC.get(), m_cMaxElements);
-                        if(!m_cEqualsD)
-                            initArray(m_dInit, inputs.managedD.get(), m_dMaxElements);
-                    }
+                bool generated = false;
 
+                generated |= initPristine(inputs, 0, m_aInit, inputs.managedA.get(), problem.a());
+                generated |= initPristine(inputs, 1, m_bInit, inputs.managedB.get(), problem.b());
+                generated |= initPristine(inputs, 2, m_cInit, inputs.managedC.get(), problem.c());
+                if(!m_cEqualsD)
+                    generated
+                        |= initPristine(inputs, 3, m_dInit, inputs.managedD.get(), problem.d());
+
+                if(generated)
+                {
                     inputs.alpha = getValue<AlphaType>(m_alphaInit);
                     inputs.beta  = getValue<BetaType>(m_betaInit);
+                }
+            }
+
+            /**
+             * Fills one pristine operand unless it already holds the values
+             * `mode` gives `tensor`.  Problem-independent modes fill the whole
+             * buffer once; problem-dependent modes are regenerated only when
+             * the tensor is not a sub-view of the one last generated.
+             *
+             * \return true if the buffer was regenerated.
+             */
+            template <typename T>
+            bool initPristine(ManagedInputs&          inputs,
+                              size_t                  operand,
+                              InitMode                mode,
+                              T*                      array,
+                              TensorDescriptor const& tensor)
+            {
+                InitKey key{mode, tensor.dataType(), tensor};
+
+                bool   dependent = IsProblemDependent(mode);
+                size_t elements  = dependent ? tensor.totalLogicalElements() : maxElements(operand);
+                size_t bytes     = TypeInfo<T>::ElementSize * elements;
+
+                if(inputs.versions[operand] != 0 && m_pristineKeys[operand].covers(key))
+                {
+                    m_inputTraffic.reusedBytes += bytes;
+                    return false;
+                }
 
-                    m_problem = problem;
+                if(dependent)
+                    initArray(mode, array, tensor, operand);
+                else
+                    initArray(mode, array, elements, operand);
+
+                m_inputTraffic.generatedBytes += bytes;
+                m_pristineKeys[operand]  = key;
+                inputs.versions[operand] = ++m_pristineGeneration;
+                return true;
+            }
+
+            size_t maxElements(size_t operand) const
+            {
+                switch(operand)
+                {
+                case 0:
+                    return m_aMaxElements;
+                case 1:
+                    return m_bMaxElements;
+                case 2:
+                    return m_cMaxElements;
+                default:
+                    return m_dMaxElements;
                 }
             }
 
@@ -698,33 +746,50 @@ namespace Tensile
                 hipMemcpyKind kind = getCopyKind(dst, src);
 
                 if(dst->managedA != src->managedA)
-                    HIP_CHECK_EXC(hipMemcpy(dst->managedA.get(),
-                                            src->managedA.get(),
-                                            TypeInfo<AType>::ElementSize * m_aMaxElements,
-                                            kind));
+                    copyOperand(*dst, *src, 0, dst->managedA.get(), src->managedA.get(), kind);
 
                 if(dst->managedB != src->managedB)
-                    HIP_CHECK_EXC(hipMemcpy(dst->managedB.get(),
-                                            src->managedB.get(),
-                                            TypeInfo<BType>::ElementSize * m_bMaxElements,
-                                            kind));
+                    copyOperand(*dst, *src, 1, dst->managedB.get(), src->managedB.get(), kind);
 
                 if(dst->managedC != src->managedC)
-                    HIP_CHECK_EXC(hipMemcpy(dst->managedC.get(),
-                                            src->managedC.get(),
-                                            TypeInfo<CType>::ElementSize * m_cMaxElements,
-                                            kind));
+                    copyOperand(*dst, *src, 2, dst->managedC.get(), src->managedC.get(), kind);
 
                 if(!m_cEqualsD && dst->managedD != src->managedD)
-                    HIP_CHECK_EXC(hipMemcpy(dst->managedD.get(),
-                                            src->managedD.get(),
-                                            TypeInfo<DType>::ElementSize * m_dMaxElements,
-                                            kind));
+                    copyOperand(*dst, *src, 3, dst->managedD.get(), src->managedD.get(), kind);
 
                 dst->alpha = src->alpha;
                 dst->beta  = src->beta;
             }
 
+            /**
+             * Copies one whole operand buffer, skipping the copy when `dst`
+             * already holds the same pristine generation.  D, and C when it
+             * aliases D, are written by the kernel and are always copied.
+             */
+            template <typename T>
+            void copyOperand(ManagedInputs& dst,
+                             ManagedInputs& src,
+                             size_t         operand,
+                             T*             dstArray,
+                             T const*       srcArray,
+                             hipMemcpyKind  kind)
+            {
+                size_t bytes    = TypeInfo<T>::ElementSize * maxElements(operand);
+                bool   isOutput = operand == 3 || (operand == 2 && m_cEqualsD);
+
+                if(!isOutput && src.versions[operand] != 0
+                   && dst.versions[operand] == src.versions[operand])
+                {
+                    m_inputTraffic.skippedBytes += bytes;
+                    return;
+                }
+
+                HIP_CHECK_EXC(hipMemcpy(dstArray, srcArray, bytes, kind));
+
+                m_inputTraffic.copiedBytes += bytes;
+                dst.versions[operand] = isOutput ? 0 : src.versions[operand];
+            }
+
             void copyInputs(std::shared_ptr<ManagedInputs> dst,
                             std::shared_ptr<ManagedInputs> src,
                             std::shared_ptr<ManagedInputs> bad,
@@ -750,6 +815,7 @@ namespace Tensile
                         throw std::runtime_error("D pointers are equal for bounds check!");
 
                     copyInputBuffers(dst, bad);
+                    dst->versions = {};
 
                     {
                         ptrdiff_t aPadding = dst->aElements - problem.a().totalAllocatedElements();
@@ -784,6 +850,8 @@ namespace Tensile
                 }
                 else if(m_curBoundsCheck == BoundsCheckMode::GuardPageBack)
                 {
+                    dst->versions = {};
+
                     {
                         ptrdiff_t aPadding = dst->aElements - problem.a().totalAllocatedElements();
                         dst->a             = dst->managedA.get() + aPadding;
@@ -860,8 +928,9 @@ namespace Tensile
             std::shared_ptr<ManagedInputs> m_gpuInputsPristine; //< Untouched copies of the inputs
             std::shared_ptr<ManagedInputs> m_gpuInputs; //< Inputs to be sent in to GPU kernels
             std::shared_ptr<ManagedInputs> m_gpuBadInputs; //< GPU copies of 'bad' values
-            ContractionProblem
-                m_problem; //< Contraction problem for which current inputs are initialized
+
+            std::array<InitKey, 4> m_pristineKeys; //< Values held by the pristine A, B, C, D
+            size_t m_pristineGeneration = 0; //< Last version given to a pristine operand
         };
 
         // Commonly used managed contraction input type groupings
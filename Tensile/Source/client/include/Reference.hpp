@@ -110,6 +110,9 @@ namespace Tensile
             static void SolveCPU(ContractionProblem const& contraction,
                                  Inputs const&             inputs,
                                  size_t                    validationStride = 1);
+            static void SolveCPUElements(ContractionProblem const&  contraction,
+                                         Inputs const&              inputs,
+                                         std::vector<size_t> const& elements);
             static void SolveCPUConvolution(ConvolutionProblem const& convProblem,
                                             ContractionProblem const& problem,
                                             Inputs const&             inputs);
@@ -118,6 +121,13 @@ namespace Tensile
         void SolveCPU(ContractionProblem const& contraction,
                       ContractionInputs const&  inputs,
                       size_t                    validationStride = 1);
+        /**
+         * Computes only the listed logical elements of D (numbered as by
+         * CoordNumbered over the sizes of D).
+         */
+        void SolveCPUElements(ContractionProblem const&  contraction,
+                              ContractionInputs const&   inputs,
+                              std::vector<size_t> const& elements);
         void SolveCPUConvolution(ConvolutionProblem const& convProblem,
                                  ContractionProblem const& problem,
                                  ContractionInputs&        inputs);
@@ -37,6 +37,7 @@
 #include "DataInitialization.hpp"
 
 #include <cstddef>
+#include <vector>
 
 namespace Tensile
 {
@@ -135,6 +136,7 @@ namespace Tensile
             int  m_elementsToValidate;
             bool m_printValids;
             int  m_printMax;
+            int  m_maxErrors;
             int  m_validationStride;
 
             bool m_printTensorA;
@@ -146,6 +148,20 @@ namespace Tensile
 
             bool m_convolutionVsContraction;
 
+            // Sampled validation: the reference is computed lazily for the tiles
+            // each solution samples and reused across solutions of a problem.
+            // m_sampling is cleared for problems the sampler can't tile.
+            bool                m_sampleRequested;
+            bool                m_sampling;
+            int                 m_sampleTiles;
+            double              m_sampleTimeBudget;
+            std::vector<bool>   m_referenceComputed;
+            std::vector<size_t> m_sampleElements;
+            std::vector<size_t> m_uniformElements;
+            size_t              m_sampledTiles     = 0;
+            size_t              m_totalTiles       = 0;
+            double              m_referenceSeconds = 0;
+
             int m_numBenchmarkRuns = 0;
 
             bool   m_validatedSolution               = false;
@@ -155,6 +171,7 @@ namespace Tensile
             size_t m_errorsReported                  = 0;
 
             bool validateSolution(std::shared_ptr<ContractionInputs> inputs);
+            void sampleReference(ContractionSolution const& solution);
         };
     } // namespace Client
 } // namespace Tensile
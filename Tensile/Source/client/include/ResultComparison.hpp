@@ -26,13 +26,82 @@
 
 #pragma once
 
+#include "DataInitialization.hpp"
 #include "Reference.hpp"
+
+#include <Tensile/Utils.hpp>
+
+#include <atomic>
 #include <iostream>
+#include <vector>
 
 namespace Tensile
 {
     namespace Client
     {
+        /**
+         * Number of logical elements handed to one thread at a time by
+         * compareTensor().
+         */
+        const size_t ComparisonChunkElements = 1 << 16;
+
+        /**
+         * Calls `row(index, stride, number, count)` for each run of `count`
+         * elements along dimension 0 among the logical elements [begin, end)
+         * of `tensor`.  `index` and `number` are the buffer index and element
+         * number of the first element of the run.  Stops early if `row`
+         * returns false.
+         */
+        template <typename Row>
+        inline void
+            ForEachTensorRow(TensorDescriptor const& tensor, size_t begin, size_t end, Row&& row)
+        {
+            auto const&         sizes = tensor.sizes();
+            std::vector<size_t> coord(tensor.dimensions());
+
+            for(size_t number = begin; number < end;)
+            {
+                CoordNumbered(number, coord.begin(), coord.end(), sizes.begin(), sizes.end());
+                size_t count = std::min(sizes[0] - coord[0], end - number);
+
+                if(!row(tensor.index(coord), tensor.strides()[0], number, count))
+                    return;
+
+                number += count;
+            }
+        }
+
+        /**
+         * Calls `rowStart(row)`, in order, for each run along dimension 0 of
+         * `tensor` from row `next` up to the last one starting before logical
+         * element `end`, and advances `next` past them.
+         */
+        template <typename RowStart>
+        inline void StartTensorRows(TensorDescriptor const& tensor,
+                                    size_t                  end,
+                                    size_t&                 next,
+                                    RowStart&               rowStart)
+        {
+            size_t const rowSize = tensor.sizes()[0];
+            for(; next * rowSize < end; next++)
+                rowStart(next);
+        }
+
+        /**
+         * Counts the values of a strided run that are not AlmostEqual to the
+         * reference.
+         */
+        template <typename T>
+        inline size_t
+            CountMismatches(T const* reference, T const* result, size_t stride, size_t count)
+        {
+            size_t errors = 0;
+#pragma omp simd reduction(+ : errors)
+            for(size_t i = 0; i < count; i++)
+                errors += !AlmostEqual(reference[i * stride], result[i * stride]);
+            return errors;
+        }
+
         template <typename T>
         struct NullComparison
         {
@@ -41,6 +110,20 @@ namespace Tensile
             {
             }
 
+            void compareTensor(TensorDescriptor const& tensor, T const* reference, T const* result)
+            {
+            }
+
+            template <typename RowStart>
+            void compareTensor(TensorDescriptor const& tensor,
+                               T const*                reference,
+                               T const*                result,
+                               RowStart&&              rowStart)
+            {
+                size_t next = 0;
+                StartTensorRows(tensor, tensor.totalLogicalElements(), next, rowStart);
+            }
+
             template <typename... Args>
             inline void before(T value, size_t elemIndex, size_t elemCount)
             {
@@ -65,17 +148,28 @@ namespace Tensile
         class PointwiseComparison
         {
         public:
-            PointwiseComparison(bool printValids, size_t printMax, bool printReport)
+            /**
+             * If `maxErrors` is nonzero, comparison stops at the maxErrors-th
+             * incorrect value.
+             */
+            PointwiseComparison(bool   printValids,
+                                size_t printMax,
+                                bool   printReport,
+                                size_t maxErrors = 0)
                 : m_printValids(printValids)
                 , m_printMax(printMax)
                 , m_doPrint(printMax > 0)
                 , m_printReport(printReport)
+                , m_maxErrors(maxErrors)
             {
             }
 
             inline void
                 operator()(T referenceValue, T resultValue, size_t elemIndex, size_t elemNumber)
             {
+                if(stopped())
+                    return;
+
                 m_values++;
                 bool match = AlmostEqual(referenceValue, resultValue);
                 if(!match)
@@ -103,8 +197,108 @@ namespace Tensile
                 }
             }
 
+            /**
+             * Compares every logical element of `tensor`.  Equivalent to
+             * calling operator() on each element in order, but mismatches are
+             * counted in parallel chunks and only the chunks that print or
+             * hold the last counted mismatch are walked again in order.
+             *
+             * `rowStart(row)` is called for every run along dimension 0, in
+             * order and before any element of that run is compared, even
+             * once comparison has stopped.
+             */
+            void compareTensor(TensorDescriptor const& tensor, T const* reference, T const* result)
+            {
+                compareTensor(tensor, reference, result, [](size_t) {});
+            }
+
+            template <typename RowStart>
+            void compareTensor(TensorDescriptor const& tensor,
+                               T const*                reference,
+                               T const*                result,
+                               RowStart&&              rowStart)
+            {
+                size_t const total      = tensor.totalLogicalElements();
+                size_t const chunkCount = CeilDivide(total, ComparisonChunkElements);
+
+                std::vector<size_t> chunkErrors(chunkCount, 0);
+
+                // Chunks after one that alone holds maxErrors mismatches can
+                // never be reached by the in-order pass.
+                std::atomic<size_t> firstFullChunk(chunkCount);
+
+#pragma omp parallel for schedule(dynamic)
+                for(size_t chunk = 0; chunk < chunkCount; chunk++)
+                {
+                    if(chunk > firstFullChunk.load(std::memory_order_relaxed))
+                        continue;
+
+                    size_t begin  = chunk * ComparisonChunkElements;
+                    size_t end    = std::min(begin + ComparisonChunkElements, total);
+                    size_t errors = 0;
+
+                    ForEachTensorRow(
+                        tensor, begin, end, [&](size_t index, size_t stride, size_t, size_t count) {
+                            errors += CountMismatches(
+                                reference + index, result + index, stride, count);
+                            return !stopped(errors);
+                        });
+
+                    chunkErrors[chunk] = errors;
+
+                    if(stopped(errors))
+                    {
+                        size_t first = firstFullChunk.load();
+                        while(chunk < first && !firstFullChunk.compare_exchange_weak(first, chunk))
+                        {
+                        }
+                    }
+                }
+
+                size_t nextRow = 0;
+
+                for(size_t chunk = 0; chunk < chunkCount && !stopped(); chunk++)
+                {
+                    size_t begin = chunk * ComparisonChunkElements;
+                    size_t end   = std::min(begin + ComparisonChunkElements, total);
+
+                    if((m_doPrint && (m_printValids || chunkErrors[chunk] > 0))
+                       || stopped(m_errors + chunkErrors[chunk]))
+                    {
+                        ForEachTensorRow(
+                            tensor,
+                            begin,
+                            end,
+                            [&](size_t index, size_t stride, size_t number, size_t count) {
+                                StartTensorRows(tensor, number + 1, nextRow, rowStart);
+                                for(size_t i = 0; i < count && !stopped(); i++)
+                                {
+                                    size_t elemIndex = index + i * stride;
+                                    (*this)(reference[elemIndex],
+                                            result[elemIndex],
+                                            elemIndex,
+                                            number + i);
+                                }
+                                return !stopped();
+                            });
+                    }
+                    else
+                    {
+                        StartTensorRows(tensor, end, nextRow, rowStart);
+                        m_values += end - begin;
+                        m_errors += chunkErrors[chunk];
+                    }
+                }
+
+                StartTensorRows(tensor, total, nextRow, rowStart);
+            }
+
             void report() const
             {
+                if(stopped())
+                    std::cout << "Stopped validation at " << m_errors << " incorrect values after "
+                              << m_values << " values compared." << std::endl;
+
                 if(0 && m_printReport)
                     std::cout << "Found " << m_errors << " incorrect values in " << m_values
                               << " total values compared." << std::endl;
@@ -115,7 +309,27 @@ namespace Tensile
                 return m_errors != 0;
             }
 
+            size_t errors() const
+            {
+                return m_errors;
+            }
+
+            size_t values() const
+            {
+                return m_values;
+            }
+
         private:
+            bool stopped(size_t errors) const
+            {
+                return m_maxErrors > 0 && errors >= m_maxErrors;
+            }
+
+            bool stopped() const
+            {
+                return stopped(m_errors);
+            }
+
             size_t m_errors      = 0;
             size_t m_values      = 0;
             bool   m_printValids = 0;
@@ -123,6 +337,7 @@ namespace Tensile
             size_t m_printed     = 0;
             bool   m_doPrint     = false;
             bool   m_printReport = false;
+            size_t m_maxErrors   = 0;
         };
 
         template <typename T>
@@ -176,6 +391,77 @@ namespace Tensile
                 m_squareDifference += static_cast<double>(diff * diff);
             }
 
+            template <typename RowStart>
+            void compareTensor(TensorDescriptor const& tensor,
+                               T const*                reference,
+                               T const*                result,
+                               RowStart&&              rowStart)
+            {
+                size_t next = 0;
+                StartTensorRows(tensor, tensor.totalLogicalElements(), next, rowStart);
+                compareTensor(tensor, reference, result);
+            }
+
+            /**
+             * Compares every logical element of `tensor` in parallel chunks.
+             * Chunk results are combined in order, so the error value does
+             * not depend on the number of threads.
+             */
+            void compareTensor(TensorDescriptor const& tensor, T const* reference, T const* result)
+            {
+                struct Partial
+                {
+                    double maxReference     = 0;
+                    double maxResult        = 0;
+                    double squareDifference = 0;
+                };
+
+                size_t const total      = tensor.totalLogicalElements();
+                size_t const chunkCount = CeilDivide(total, ComparisonChunkElements);
+
+                std::vector<Partial> partials(chunkCount);
+
+#pragma omp parallel for schedule(dynamic)
+                for(size_t chunk = 0; chunk < chunkCount; chunk++)
+                {
+                    size_t   begin   = chunk * ComparisonChunkElements;
+                    size_t   end     = std::min(begin + ComparisonChunkElements, total);
+                    Partial& partial = partials[chunk];
+
+                    ForEachTensorRow(
+                        tensor, begin, end, [&](size_t index, size_t stride, size_t, size_t count) {
+                            using m = Magnitude<T>;
+
+                            T const* ref = reference + index;
+                            T const* res = result + index;
+
+                            double maxReference     = partial.maxReference;
+                            double maxResult        = partial.maxResult;
+                            double squareDifference = partial.squareDifference;
+#pragma omp simd reduction(max : maxReference, maxResult) reduction(+ : squareDifference)
+                            for(size_t i = 0; i < count; i++)
+                            {
+                                maxReference = std::max(
+                                    maxReference, static_cast<double>(m::abs(ref[i * stride])));
+                                maxResult = std::max(maxResult,
+                                                     static_cast<double>(m::abs(res[i * stride])));
+                                auto diff = m::abs(ref[i * stride] - res[i * stride]);
+                                squareDifference += static_cast<double>(diff * diff);
+                            }
+                            partial = {maxReference, maxResult, squareDifference};
+                            return true;
+                        });
+                }
+
+                m_values += total;
+                for(auto const& partial : partials)
+                {
+                    m_maxReference = std::max(m_maxReference, partial.maxReference);
+                    m_maxResult    = std::max(m_maxResult, partial.maxResult);
+                    m_squareDifference += partial.squareDifference;
+                }
+            }
+
             inline void report() const
             {
                 if(m_printReport)
@@ -28,8 +28,11 @@
 
 #include "RunListener.hpp"
 
+#include <Tensile/SmallVector.hpp>
+
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace Tensile
 {
@@ -165,6 +168,12 @@ namespace Tensile
                 reportValue_sizes(key, value);
             }
 
+            template <size_t N>
+            void report(std::string const& key, SmallVector<size_t, N> const& value)
+            {
+                reportValue_sizes(key, std::vector<size_t>(value.begin(), value.end()));
+            }
+
             virtual void reportValue_string(std::string const& key, std::string const& value) = 0;
             virtual void reportValue_uint(std::string const& key, uint64_t value)             = 0;
             virtual void reportValue_int(std::string const& key, int64_t value)               = 0;
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <Tensile/ContractionProblem.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Tensile
+{
+    namespace Client
+    {
+        /**
+         * Chooses which elements of D to validate when a full reference pass is
+         * too expensive.  D is divided into macro tiles over the first free index
+         * of A and of B; every other dimension of D selects a layer of tiles.
+         *
+         * Tiles are chosen in priority order: the four corner tiles of the first
+         * layer and then of the last layer (which hold the edges of D and any
+         * partial tiles), then one uniformly random tile from each of the equal
+         * strata the remaining tiles are split into.
+         * Within a tile every element on its perimeter is checked, which covers
+         * each macro-tile boundary, along with a few random interior elements.
+         *
+         * That selection is deliberately biased towards where errors are likely,
+         * so it says nothing about the error rate of D as a whole.  A separate
+         * uniform sample of D is drawn for that.
+         *
+         * Requires at least one free index in each of A and B; see Supports().
+         */
+        class ValidationSampler
+        {
+        public:
+            ValidationSampler(ContractionProblem const& problem,
+                              size_t                    macroTile0,
+                              size_t                    macroTile1,
+                              size_t                    tileCount,
+                              size_t                    interiorSamples,
+                              uint64_t                  seed);
+
+            /// Whether `problem` has the free indices the tiling is built on.
+            static bool Supports(ContractionProblem const& problem);
+
+            /// Number of tiles chosen.
+            size_t tiles() const
+            {
+                return m_tiles.size();
+            }
+
+            /// Number of tiles that cover D.
+            size_t totalTiles() const
+            {
+                return m_totalTiles;
+            }
+
+            /**
+             * Appends the logical element numbers of D (as numbered by
+             * CoordNumbered) to check for the tile-th chosen tile.
+             */
+            void elements(size_t tile, std::vector<size_t>& rv) const;
+
+            /**
+             * Appends `count` logical element numbers of D drawn uniformly at
+             * random, with replacement, independently of the chosen tiles.
+             */
+            void uniformElements(size_t count, std::vector<size_t>& rv) const;
+
+            /**
+             * One-sided Clopper-Pearson upper bound on the fraction of incorrect
+             * elements in D, given that failures of samples elements drawn
+             * uniformly from D (see uniformElements()) were incorrect.
+             */
+            static double
+                ErrorRateUpperBound(size_t samples, size_t failures, double confidence = 0.95);
+
+        private:
+            size_t elementNumber(size_t row, size_t col, size_t layer) const;
+
+            size_t m_dim0, m_dim1;
+            size_t m_size0, m_size1;
+            size_t m_macroTile0, m_macroTile1;
+            size_t m_tiles0, m_tiles1;
+            size_t m_totalTiles    = 0;
+            size_t m_totalElements = 0;
+            size_t m_interiorSamples;
+
+            uint64_t m_seed;
+
+            std::vector<size_t> m_layerDims;
+            std::vector<size_t> m_layerSizes;
+            std::vector<size_t> m_elementStrides;
+
+            std::vector<size_t> m_tiles;
+        };
+    } // namespace Client
+} // namespace Tensile
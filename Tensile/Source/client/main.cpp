@@ -60,6 +60,28 @@ namespace po = boost::program_options;
 
 namespace Tensile
 {
+    /**
+     * Parses each token of a SmallVector option into one element, as
+     * program_options does for std::vector.  Found by argument-dependent
+     * lookup.
+     */
+    template <typename T, size_t N>
+    void validate(boost::any& v, std::vector<std::string> const& values, SmallVector<T, N>*, int)
+    {
+        if(v.empty())
+            v = boost::any(SmallVector<T, N>());
+
+        auto* rv = boost::any_cast<SmallVector<T, N>>(&v);
+
+        for(auto const& value : values)
+        {
+            boost::any               element;
+            std::vector<std::string> token{value};
+            po::validate(element, token, static_cast<T*>(nullptr), 0);
+            rv->push_back(boost::any_cast<T>(element));
+        }
+    }
+
     namespace Client
     {
 
@@ -125,6 +147,7 @@ namespace Tensile
                 ("init-d",                   po::value<InitMode>()->default_value(InitMode::Zero), "Initialization for D")
                 ("init-alpha",               po::value<InitMode>()->default_value(InitMode::Two), "Initialization for alpha")
                 ("init-beta",                po::value<InitMode>()->default_value(InitMode::Two), "Initialization for beta")
+                ("init-seed",                po::value<size_t>()->default_value(0), "Seed for the random initialization modes")
                 ("pristine-on-gpu",          po::value<bool>()->default_value(true), "Keep a pristine copy of inputs on GPU for performance")
                 ("c-equal-d",                po::value<bool>()->default_value(false), "C equals D")
                 ("offset-a",                 po::value<size_t>()->default_value(0), "buffer a start offset")
@@ -134,6 +157,12 @@ namespace Tensile
                 ("print-valids",             po::value<bool>()->default_value(false), "Print values that pass validation")
                 ("print-max",                po::value<int>()->default_value(-1), "Max number of values to print")
                 ("num-elements-to-validate", po::value<int>()->default_value(0), "Number of elements to validate")
+                ("validation-sample-tiles",  po::value<int>()->default_value(0), "Validate a stratified random sample of this many macro tiles "
+                                                                                  "(corner tiles first) instead of a strided pass. 0 disables sampling.")
+                ("validation-time-budget",   po::value<double>()->default_value(0.0), "Seconds of CPU reference time per problem for sampled "
+                                                                                      "validation. 0 means no limit.")
+                ("validation-max-errors",    po::value<int>()->default_value(0), "Stop validating a solution after this many incorrect values. "
+                                                                                  "0 compares every value.")
                 ("bounds-check",             po::value<BoundsCheckMode>()->default_value(BoundsCheckMode::Disable),
                 "1:Use sentinel values to check memory boundaries."
                 "2:Memory bound check by front guard page"
@@ -678,6 +707,8 @@ int main(int argc, const char* argv[])
 
     listeners.finalizeReport();
 
+    library->savePersistentCache();
+
     // error range in shell is [0-255]
     return std::min(listeners.error(), 255);
 }
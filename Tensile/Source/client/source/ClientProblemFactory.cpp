@@ -97,6 +97,9 @@ namespace Tensile
             if(args.count("beta-type"))
                 m_betaType = args["beta-type"].as<DataType>();
 
+            if(args.count("init-seed"))
+                DataInitialization::SeedThreadRandom(args["init-seed"].as<size_t>());
+
             m_beta  = DataInitialization::getValue<double>(args["init-beta"].as<InitMode>());
             m_alpha = DataInitialization::getValue<double>(args["init-alpha"].as<InitMode>());
 
@@ -26,11 +26,14 @@
 
 #include "DataInitialization.hpp"
 #include "DataInitializationTyped.hpp"
+#include "ResultReporter.hpp"
 
 #include <Tensile/Utils.hpp>
 
 #include <hip/hip_runtime.h>
 
+#include <iomanip>
+
 namespace Tensile
 {
     namespace Client
@@ -213,6 +216,58 @@ namespace Tensile
             return stream;
         }
 
+        bool InitKey::covers(InitKey const& other) const
+        {
+            if(mode != other.mode || dataType != other.dataType)
+                return false;
+
+            if(!IsProblemDependent(mode) || tensor == other.tensor)
+                return true;
+
+            auto const& sizes   = tensor.sizes();
+            auto const& strides = tensor.strides();
+
+            if(sizes.size() != other.tensor.sizes().size() || strides != other.tensor.strides()
+               || tensor.offset() != other.tensor.offset())
+                return false;
+
+            // With aliased elements the last write to an address depends on
+            // the sizes, so only distinct, ordered strides can share a buffer.
+            size_t extent = 1;
+            for(size_t i = 0; i < sizes.size(); i++)
+            {
+                if(strides[i] < extent)
+                    return false;
+                extent = strides[i] * sizes[i];
+            }
+
+            bool indexBased = mode == InitMode::SerialIdx || mode == InitMode::TrigSin
+                              || mode == InitMode::TrigCos || mode == InitMode::TrigAbsSin
+                              || mode == InitMode::TrigAbsCos;
+
+            for(size_t i = 0; i < sizes.size(); i++)
+            {
+                if(other.tensor.sizes()[i] > sizes[i])
+                    return false;
+                if(indexBased && i + 1 < sizes.size() && other.tensor.sizes()[i] != sizes[i])
+                    return false;
+            }
+
+            return true;
+        }
+
+        std::ostream& operator<<(std::ostream& stream, InputTraffic const& traffic)
+        {
+            auto mb = [](size_t bytes) { return bytes / (1024.0 * 1024.0); };
+
+            return stream << std::fixed << std::setprecision(1)
+                          << "Input data: generated " << mb(traffic.generatedBytes)
+                          << " MB, reused " << mb(traffic.reusedBytes) << " MB; copied "
+                          << mb(traffic.copiedBytes) << " MB, skipped "
+                          << mb(traffic.skippedBytes) << " MB of unchanged copies."
+                          << std::defaultfloat;
+        }
+
         double DataInitialization::GetRepresentativeBetaValue(po::variables_map const& args)
         {
             auto argValue = args["init-beta"].as<int>();
@@ -366,6 +421,10 @@ namespace Tensile
             if(args.count("convolution-vs-contraction"))
                 m_convolutionVsContraction = args["convolution-vs-contraction"].as<bool>();
 
+            if(args.count("init-seed"))
+                m_seed = args["init-seed"].as<size_t>();
+            SeedThreadRandom(m_seed);
+
             for(auto const& problem : problemFactory.problems())
             {
                 m_aMaxElements = std::max(m_aMaxElements, problem.a().totalAllocatedElements());
@@ -408,5 +467,11 @@ namespace Tensile
         }
 
         DataInitialization::~DataInitialization() {}
+
+        void DataInitialization::finalizeReport()
+        {
+            if(m_reporter)
+                m_reporter->log(LogLevel::Normal, m_inputTraffic);
+        }
     } // namespace Client
 } // namespace Tensile
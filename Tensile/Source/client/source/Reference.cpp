@@ -28,8 +28,10 @@
 #include "Tensile/Debug.hpp"
 #include "Tensile/Utils.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <stdlib.h>
 
 #include <omp.h>
@@ -114,10 +116,278 @@ namespace Tensile
             return static_cast<Accumulator>(static_cast<LMultT>(l) * static_cast<RMultT>(r));
         }
 
+        // Register tile of the blocked reference microkernel and the cache blocks it
+        // is fed from.  KC * (MC + NC) packed elements stay resident in L2.
+        constexpr size_t BlockedMR = 4;
+        constexpr size_t BlockedNR = 16;
+        constexpr size_t BlockedMC = 64;
+        constexpr size_t BlockedNC = 256;
+        constexpr size_t BlockedKC = 256;
+
+        /**
+         * Widens one A or B element into the accumulator type while packing, so
+         * the microkernel only ever sees Accumulator * Accumulator.  Lanes is the
+         * number of packed k entries each input element expands to.  Elements
+         * are widened one at a time; there is no vectorized conversion path.
+         */
+        template <typename Accumulator, typename T>
+        struct PackedInput
+        {
+            constexpr static size_t Lanes = 1;
+
+            inline static void
+                Widen(T const& val, bool conj, Accumulator* out, size_t laneStride)
+            {
+                out[0] = static_cast<Accumulator>(Transform<T>::Input(val, conj));
+            }
+        };
+
+        // A BFloat16 is the upper half of a float, so widening it is a shift.
+        template <>
+        struct PackedInput<float, BFloat16>
+        {
+            constexpr static size_t Lanes = 1;
+
+            inline static void Widen(BFloat16 const& val, bool, float* out, size_t laneStride)
+            {
+                uint32_t bits = static_cast<uint32_t>(val.data) << 16;
+                std::memcpy(out, &bits, sizeof(bits));
+            }
+        };
+
+        // An Int8x4 product is a 4-element dot product; integer sums are exact in
+        // any order, so each byte becomes its own k entry.
+        template <>
+        struct PackedInput<int32_t, Int8x4>
+        {
+            constexpr static size_t Lanes = 4;
+
+            inline static void Widen(Int8x4 const& val, bool, int32_t* out, size_t laneStride)
+            {
+                out[0]              = val.a;
+                out[laneStride]     = val.b;
+                out[2 * laneStride] = val.c;
+                out[3 * laneStride] = val.d;
+            }
+        };
+
+        /**
+         * Fast path for plain and strided-batched GEMM: one free index in each of
+         * A and B and one bound index without zero-pad or mirror.  A and B are
+         * widened to the accumulator type and packed into micro-panels per cache
+         * block, and a register tile is accumulated with a SIMD inner loop.  Each
+         * element of D still sums its products in bound index order and is
+         * finished with the same alpha/beta expression, so results match the
+         * element-wise path.
+         *
+         * Returns false without touching D when the problem does not qualify.
+         */
         template <typename Inputs, typename Accumulator>
-        void ReferenceSolution<Inputs, Accumulator>::SolveCPU(ContractionProblem const& problem,
-                                                              Inputs const&             inputs,
-                                                              size_t validationStride)
+        bool SolveCPUBlocked(ContractionProblem const& problem,
+                             Inputs const&             inputs,
+                             bool                      aConjugate,
+                             bool                      bConjugate)
+        {
+            using AType = typename Inputs::AType;
+            using BType = typename Inputs::BType;
+
+            if constexpr(!std::is_same<AType, BType>())
+            {
+                return false;
+            }
+            else
+            {
+                using Packed                = PackedInput<Accumulator, AType>;
+                constexpr size_t Lanes      = Packed::Lanes;
+                constexpr size_t MaxKLength = BlockedKC * Lanes;
+
+                if(problem.freeIndicesA().size() != 1 || problem.freeIndicesB().size() != 1
+                   || problem.boundIndices().size() != 1)
+                    return false;
+
+                auto const& bound = problem.boundIndices()[0];
+                if(bound.aZeroPad.valid() || bound.bZeroPad.valid() || bound.aMirror
+                   || bound.bMirror)
+                    return false;
+
+                auto const& freeA   = problem.freeIndicesA()[0];
+                auto const& freeB   = problem.freeIndicesB()[0];
+                auto const& batches = problem.batchIndices();
+
+                auto const& a = problem.a();
+                auto const& b = problem.b();
+                auto const& c = problem.c();
+                auto const& d = problem.d();
+
+                size_t const M = problem.freeSizeA(0);
+                size_t const N = problem.freeSizeB(0);
+                size_t const K = problem.boundSize(0);
+
+                size_t const aM = a.strides()[freeA.i];
+                size_t const aK = a.strides()[bound.a];
+                size_t const bK = b.strides()[bound.b];
+                size_t const bN = b.strides()[freeB.i];
+                size_t const cM = c.strides()[freeA.c];
+                size_t const cN = c.strides()[freeB.c];
+                size_t const dM = d.strides()[freeA.d];
+                size_t const dN = d.strides()[freeB.d];
+
+                std::vector<size_t> batchSize(batches.size());
+                for(size_t i = 0; i < batches.size(); i++)
+                    batchSize[i] = problem.batchSize(i);
+                size_t const batchCount = CoordCount(batchSize.begin(), batchSize.end());
+
+                size_t const mTiles = CeilDivide(M, BlockedMC);
+                size_t const nTiles = CeilDivide(N, BlockedNC);
+
+                auto const zero  = static_cast<typename Inputs::BetaType>(0);
+                bool const doMul = inputs.alpha != static_cast<typename Inputs::AlphaType>(0);
+
+#pragma omp parallel
+                {
+                    std::vector<Accumulator> aPack(BlockedMC * MaxKLength);
+                    std::vector<Accumulator> bPack(MaxKLength * BlockedNC);
+                    std::vector<Accumulator> tile(BlockedMC * BlockedNC);
+                    std::vector<size_t>      batchCoord(batches.size());
+
+#pragma omp for schedule(dynamic)
+                    for(size_t tileNum = 0; tileNum < batchCount * mTiles * nTiles; tileNum++)
+                    {
+                        size_t const batchNum = tileNum / (mTiles * nTiles);
+                        size_t const m0       = (tileNum / nTiles) % mTiles * BlockedMC;
+                        size_t const n0       = tileNum % nTiles * BlockedNC;
+                        size_t const mc       = std::min(BlockedMC, M - m0);
+                        size_t const nc       = std::min(BlockedNC, N - n0);
+
+                        CoordNumbered(batchNum,
+                                      batchCoord.begin(),
+                                      batchCoord.end(),
+                                      batchSize.begin(),
+                                      batchSize.end());
+
+                        size_t aBase = a.offset(), bBase = b.offset();
+                        size_t cBase = c.offset(), dBase = d.offset();
+                        for(size_t i = 0; i < batches.size(); i++)
+                        {
+                            aBase += batchCoord[i] * a.strides()[batches[i].a];
+                            bBase += batchCoord[i] * b.strides()[batches[i].b];
+                            cBase += batchCoord[i] * c.strides()[batches[i].c];
+                            dBase += batchCoord[i] * d.strides()[batches[i].d];
+                        }
+
+                        std::fill(tile.begin(), tile.end(), Accumulator(0));
+
+                        for(size_t k0 = 0; doMul && k0 < K; k0 += BlockedKC)
+                        {
+                            size_t const kc = std::min(BlockedKC, K - k0);
+                            size_t const kl = kc * Lanes;
+
+                            // Pack A as MR-row panels, k-major, zero-filled past M.
+                            for(size_t ip = 0; ip < mc; ip += BlockedMR)
+                            {
+                                Accumulator* panel = aPack.data() + ip * kl;
+                                for(size_t i = 0; i < BlockedMR; i++)
+                                {
+                                    if(ip + i >= mc)
+                                    {
+                                        for(size_t k = 0; k < kl; k++)
+                                            panel[k * BlockedMR + i] = Accumulator(0);
+                                        continue;
+                                    }
+
+                                    auto row = inputs.a + aBase + (m0 + ip + i) * aM + k0 * aK;
+                                    for(size_t k = 0; k < kc; k++)
+                                        Packed::Widen(row[k * aK],
+                                                      aConjugate,
+                                                      panel + k * Lanes * BlockedMR + i,
+                                                      BlockedMR);
+                                }
+                            }
+
+                            // Pack B as NR-column panels, k-major, zero-filled past N.
+                            for(size_t jp = 0; jp < nc; jp += BlockedNR)
+                            {
+                                Accumulator* panel = bPack.data() + jp * kl;
+                                for(size_t j = 0; j < BlockedNR; j++)
+                                {
+                                    if(jp + j >= nc)
+                                    {
+                                        for(size_t k = 0; k < kl; k++)
+                                            panel[k * BlockedNR + j] = Accumulator(0);
+                                        continue;
+                                    }
+
+                                    auto col = inputs.b + bBase + (n0 + jp + j) * bN + k0 * bK;
+                                    for(size_t k = 0; k < kc; k++)
+                                        Packed::Widen(col[k * bK],
+                                                      bConjugate,
+                                                      panel + k * Lanes * BlockedNR + j,
+                                                      BlockedNR);
+                                }
+                            }
+
+                            for(size_t ip = 0; ip < mc; ip += BlockedMR)
+                                for(size_t jp = 0; jp < nc; jp += BlockedNR)
+                                {
+                                    Accumulator const* aPanel = aPack.data() + ip * kl;
+                                    Accumulator const* bPanel = bPack.data() + jp * kl;
+
+                                    Accumulator acc[BlockedMR][BlockedNR];
+                                    for(size_t i = 0; i < BlockedMR; i++)
+                                        for(size_t j = 0; j < BlockedNR; j++)
+                                            acc[i][j] = tile[(ip + i) * BlockedNC + jp + j];
+
+                                    for(size_t k = 0; k < kl; k++)
+                                        for(size_t i = 0; i < BlockedMR; i++)
+                                        {
+                                            Accumulator const aVal = aPanel[k * BlockedMR + i];
+#pragma omp simd
+                                            for(size_t j = 0; j < BlockedNR; j++)
+                                                acc[i][j] += multiply<Accumulator>(
+                                                    aVal, bPanel[k * BlockedNR + j]);
+                                        }
+
+                                    for(size_t i = 0; i < BlockedMR; i++)
+                                        for(size_t j = 0; j < BlockedNR; j++)
+                                            tile[(ip + i) * BlockedNC + jp + j] = acc[i][j];
+                                }
+                        }
+
+                        for(size_t i = 0; i < mc; i++)
+                            for(size_t j = 0; j < nc; j++)
+                            {
+                                size_t const m = m0 + i, n = n0 + j;
+
+                                // Ensure zero*nan returns zero
+                                auto const beta = inputs.beta;
+
+                                inputs.d[dBase + m * dM + n * dN]
+                                    = static_cast<typename Inputs::DType>(
+                                        multiply<Accumulator>(inputs.alpha,
+                                                              tile[i * BlockedNC + j])
+                                        + ((beta == zero) ? static_cast<Accumulator>(zero)
+                                                          : multiply<Accumulator>(
+                                                              beta,
+                                                              inputs.c[cBase + m * cM + n * cN])));
+                            }
+                    }
+                }
+
+                return true;
+            }
+        }
+
+        /**
+         * Computes elementCount logical elements of D, the n-th of which is
+         * elementNumber(n).  When allElements is set they cover D in order and the
+         * blocked path may be used instead.
+         */
+        template <typename Inputs, typename Accumulator, typename ElementNumber>
+        void SolveReference(ContractionProblem const& problem,
+                            Inputs const&             inputs,
+                            size_t                    elementCount,
+                            bool                      allElements,
+                            ElementNumber             elementNumber)
         {
             auto const& freeIndicesA = problem.freeIndicesA();
             auto const& freeIndicesB = problem.freeIndicesB();
@@ -172,7 +442,7 @@ namespace Tensile
                 }
             }
 
-            // Set num threads and enable proc_bind to prevent main thread from migrating
+            // Enable proc_bind to prevent main thread from migrating
             // Defaults cause validation to affect benchmark timing
             // Dynamic thread mode causes HostLibraryTests to fail
             const char* env_bind = std::getenv("OMP_PROC_BIND");
@@ -182,10 +452,24 @@ namespace Tensile
 #else
                 setenv("OMP_PROC_BIND", "true", 1);
 #endif
-            omp_set_num_threads(64);
+
+            if(allElements
+               && SolveCPUBlocked<Inputs, Accumulator>(problem, inputs, aConjugate, bConjugate))
+            {
+                if(env_bind == nullptr)
+#ifdef _WIN32
+                    _putenv("OMP_PROC_BIND=");
+#else
+                    unsetenv("OMP_PROC_BIND");
+#endif
+                return;
+            }
+
 #pragma omp parallel for
-            for(size_t dNum = 0; dNum < d.totalLogicalElements(); dNum += validationStride)
+            for(size_t elementNum = 0; elementNum < elementCount; elementNum++)
             {
+                size_t dNum = elementNumber(elementNum);
+
                 std::vector<int64_t> aCoord(a.dimensions());
                 std::vector<int64_t> bCoord(b.dimensions());
                 std::vector<int64_t> cCoord(c.dimensions());
@@ -335,9 +619,38 @@ namespace Tensile
 #endif
         }
 
-        void SolveCPU(ContractionProblem const& problem,
-                      ContractionInputs const&  inputs,
-                      size_t                    validationStride)
+        template <typename Inputs, typename Accumulator>
+        void ReferenceSolution<Inputs, Accumulator>::SolveCPU(ContractionProblem const& problem,
+                                                              Inputs const&             inputs,
+                                                              size_t validationStride)
+        {
+            size_t elementCount = CeilDivide(problem.d().totalLogicalElements(), validationStride);
+            SolveReference<Inputs, Accumulator>(
+                problem, inputs, elementCount, validationStride == 1, [=](size_t elementNum) {
+                    return elementNum * validationStride;
+                });
+        }
+
+        template <typename Inputs, typename Accumulator>
+        void ReferenceSolution<Inputs, Accumulator>::SolveCPUElements(
+            ContractionProblem const&  problem,
+            Inputs const&              inputs,
+            std::vector<size_t> const& elements)
+        {
+            SolveReference<Inputs, Accumulator>(
+                problem, inputs, elements.size(), false, [&](size_t elementNum) {
+                    return elements[elementNum];
+                });
+        }
+
+        /**
+         * Calls solve(ReferenceSolution<...>(), typedInputs) with the reference
+         * solution matching the data types of the problem.
+         */
+        template <typename Solve>
+        void DispatchCPU(ContractionProblem const& problem,
+                         ContractionInputs const&  inputs,
+                         Solve&&                   solve)
         {
             // retreive alpha/beta type set via setAlpha/BetaType()
             auto alphaType = problem.alphaType();
@@ -367,26 +680,22 @@ namespace Tensile
             case ContractionInputs_S_S_S::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_S_S_S const&>(inputs);
-                return ReferenceSolution<ContractionInputs_S_S_S>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_S_S_S>(), typedInputs);
             }
             case ContractionInputs_D_D_D::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_D_D_D const&>(inputs);
-                return ReferenceSolution<ContractionInputs_D_D_D>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_D_D_D>(), typedInputs);
             }
             case ContractionInputs_C_C_C::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_C_C_C const&>(inputs);
-                return ReferenceSolution<ContractionInputs_C_C_C>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_C_C_C>(), typedInputs);
             }
             case ContractionInputs_Z_Z_Z::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_Z_Z_Z const&>(inputs);
-                return ReferenceSolution<ContractionInputs_Z_Z_Z>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_Z_Z_Z>(), typedInputs);
             }
 #ifdef TENSILE_USE_HALF
             case ContractionInputs_H_H_H::TypeId():
@@ -395,47 +704,40 @@ namespace Tensile
 
                 if(problem.highPrecisionAccumulate())
                 {
-                    return ReferenceSolution<ContractionInputs_H_H_H, float>::SolveCPU(
-                        problem, typedInputs, validationStride);
+                    return solve(ReferenceSolution<ContractionInputs_H_H_H, float>(), typedInputs);
                 }
                 else
                 {
-                    return ReferenceSolution<ContractionInputs_H_H_H>::SolveCPU(
-                        problem, typedInputs, validationStride);
+                    return solve(ReferenceSolution<ContractionInputs_H_H_H>(), typedInputs);
                 }
             }
             case ContractionInputs_H_S_S::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_H_S_S const&>(inputs);
-                return ReferenceSolution<ContractionInputs_H_S_S>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_H_S_S>(), typedInputs);
             }
             case ContractionInputs_H_H_S::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_H_H_S const&>(inputs);
-                return ReferenceSolution<ContractionInputs_H_H_S, float>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_H_H_S, float>(), typedInputs);
             }
 #endif // TENSILE_USE_HALF
             case ContractionInputs_I8x4_I32_I32::TypeId():
             {
                 auto const& typedInputs
                     = dynamic_cast<ContractionInputs_I8x4_I32_I32 const&>(inputs);
-                return ReferenceSolution<ContractionInputs_I8x4_I32_I32>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_I8x4_I32_I32>(), typedInputs);
             }
             case ContractionInputs_I32_I32_I32::TypeId():
             {
                 auto const& typedInputs
                     = dynamic_cast<ContractionInputs_I32_I32_I32 const&>(inputs);
-                return ReferenceSolution<ContractionInputs_I32_I32_I32>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_I32_I32_I32>(), typedInputs);
             }
             case ContractionInputs_I8_I32_I32::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_I8_I32_I32 const&>(inputs);
-                return ReferenceSolution<ContractionInputs_I8_I32_I32>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_I8_I32_I32>(), typedInputs);
             }
 #ifdef TENSILE_USE_BF16
             case ContractionInputs_B_B_S::TypeId():
@@ -444,20 +746,17 @@ namespace Tensile
 
                 if(problem.highPrecisionAccumulate())
                 {
-                    return ReferenceSolution<ContractionInputs_B_B_S, float>::SolveCPU(
-                        problem, typedInputs, validationStride);
+                    return solve(ReferenceSolution<ContractionInputs_B_B_S, float>(), typedInputs);
                 }
                 else
                 {
-                    return ReferenceSolution<ContractionInputs_B_B_S>::SolveCPU(
-                        problem, typedInputs, validationStride);
+                    return solve(ReferenceSolution<ContractionInputs_B_B_S>(), typedInputs);
                 }
             }
             case ContractionInputs_B_S_S::TypeId():
             {
                 auto const& typedInputs = dynamic_cast<ContractionInputs_B_S_S const&>(inputs);
-                return ReferenceSolution<ContractionInputs_B_S_S>::SolveCPU(
-                    problem, typedInputs, validationStride);
+                return solve(ReferenceSolution<ContractionInputs_B_S_S>(), typedInputs);
             }
 #endif // TENSILE_USE_BF16
 
@@ -467,6 +766,24 @@ namespace Tensile
             throw std::runtime_error("Data type not implemented.");
         }
 
+        void SolveCPU(ContractionProblem const& problem,
+                      ContractionInputs const&  inputs,
+                      size_t                    validationStride)
+        {
+            DispatchCPU(problem, inputs, [&](auto reference, auto const& typedInputs) {
+                reference.SolveCPU(problem, typedInputs, validationStride);
+            });
+        }
+
+        void SolveCPUElements(ContractionProblem const&  problem,
+                              ContractionInputs const&   inputs,
+                              std::vector<size_t> const& elements)
+        {
+            DispatchCPU(problem, inputs, [&](auto reference, auto const& typedInputs) {
+                reference.SolveCPUElements(problem, typedInputs, elements);
+            });
+        }
+
         // A is activation, B is weights
         // Assume packed.
         template <typename Inputs, typename Accumulator>
@@ -28,12 +28,15 @@
 #include "DataInitializationTyped.hpp"
 #include "ResultComparison.hpp"
 #include "ResultReporter.hpp"
+#include "ValidationSampler.hpp"
 
 #include "Reference.hpp"
 
 #include <Tensile/DataTypes.hpp>
 #include <Tensile/hip/HipUtils.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 
 namespace Tensile
@@ -47,6 +50,7 @@ namespace Tensile
             m_elementsToValidate = args["num-elements-to-validate"].as<int>();
             m_printValids        = args["print-valids"].as<bool>();
             m_printMax           = args["print-max"].as<int>();
+            m_maxErrors          = args["validation-max-errors"].as<int>();
 
             m_printTensorA   = args["print-tensor-a"].as<bool>();
             m_printTensorB   = args["print-tensor-b"].as<bool>();
@@ -62,6 +66,12 @@ namespace Tensile
                 m_convolutionProblem.FromIdentifier(
                     args["convolution-identifier"].as<std::string>());
 
+            m_sampleTiles      = args["validation-sample-tiles"].as<int>();
+            m_sampleTimeBudget = args["validation-time-budget"].as<double>();
+            m_sampleRequested
+                = m_sampleTiles > 0 && m_elementsToValidate != 0 && !m_convolutionVsContraction;
+            m_sampling = m_sampleRequested;
+
             m_enabled = m_elementsToValidate != 0 || m_printAny;
         }
 
@@ -87,6 +97,17 @@ namespace Tensile
                 m_problem          = problem;
                 m_referenceInputs  = m_dataInit->prepareCPUInputs(problem);
                 m_validationStride = 1;
+
+                // Without a free index in both A and B there are no tiles to
+                // sample, so such problems are validated in full.
+                m_sampling = m_sampleRequested && ValidationSampler::Supports(problem);
+                if(m_sampling)
+                {
+                    m_referenceComputed.assign(problem.d().totalLogicalElements(), false);
+                    m_referenceSeconds = 0;
+                    return;
+                }
+
                 if(m_elementsToValidate > 0
                    && m_elementsToValidate < problem.d().totalLogicalElements())
                     m_validationStride
@@ -122,6 +143,71 @@ namespace Tensile
         {
             m_validatedSolution = false;
             m_errorInSolution   = false;
+
+            if(m_enabled && m_sampling)
+                sampleReference(solution);
+        }
+
+        void ReferenceValidator::sampleReference(ContractionSolution const& solution)
+        {
+            // Tiles are solved a few at a time so the reference stays parallel
+            // while the time budget is still checked often.
+            const size_t tilesPerStep = 8;
+            // Drawn uniformly from D for the error-rate bound, and always checked.
+            const size_t uniformSamples = 1024;
+
+            auto const& macroTile = solution.sizeMapping.macroTile;
+
+            auto seed = hash_combine(m_problem.d().totalLogicalElements(), solution.index);
+
+            ValidationSampler sampler(m_problem, macroTile.x, macroTile.y, m_sampleTiles, 16, seed);
+
+            m_sampleElements.clear();
+            m_uniformElements.clear();
+            m_totalTiles = sampler.totalTiles();
+
+            std::vector<size_t> pending;
+            auto                solve = [&](std::vector<size_t> const& elements, size_t first) {
+                pending.clear();
+                for(size_t i = first; i < elements.size(); i++)
+                {
+                    size_t element = elements[i];
+                    if(!m_referenceComputed[element])
+                    {
+                        m_referenceComputed[element] = true;
+                        pending.push_back(element);
+                    }
+                }
+
+                if(pending.empty())
+                    return;
+
+                auto start = std::chrono::steady_clock::now();
+                SolveCPUElements(m_problem, *m_referenceInputs, pending);
+                m_referenceSeconds += std::chrono::duration<double>(
+                                          std::chrono::steady_clock::now() - start)
+                                          .count();
+            };
+
+            sampler.uniformElements(uniformSamples, m_uniformElements);
+            solve(m_uniformElements, 0);
+
+            size_t tile = 0;
+            while(tile < sampler.tiles())
+            {
+                // The first step (the corner tiles) is always taken.
+                if(m_sampleTimeBudget > 0 && tile > 0
+                   && m_referenceSeconds >= m_sampleTimeBudget)
+                    break;
+
+                size_t first = m_sampleElements.size();
+                for(size_t end = std::min(tile + tilesPerStep, sampler.tiles()); tile < end; tile++)
+                    sampler.elements(tile, m_sampleElements);
+
+                solve(m_sampleElements, first);
+            }
+
+            m_sampledTiles = tile;
         }
 
         bool ReferenceValidator::needMoreRunsInSolution() const
@@ -290,7 +376,7 @@ namespace Tensile
                 // RMSComparison<typename ManagedInputs::DType> compareValid(1e-7,
                 // m_printMax > 0);
                 PointwiseComparison<typename ManagedInputs::DType> compareValid(
-                    m_printValids, m_printMax, m_printMax > 0);
+                    m_printValids, m_printMax, m_printMax > 0, m_maxErrors);
                 InvalidComparison<typename ManagedInputs::DType> compareInvalid(m_printMax,
                                                                                 m_printMax > 0);
                 rv = checkResultsTyped(reference, result, compareValid, compareInvalid);
@@ -464,17 +550,50 @@ namespace Tensile
                 compareInvalid.before(resultBuffer[i], i, elementsBeforeData);
             }
 
-            if(m_validationStride == 1)
+            size_t uniformErrors = 0;
+
+            if(m_sampling)
+            {
+                std::vector<size_t> coord(tensor.dimensions());
+                auto                elemIndex = [&](size_t elemNumber) {
+                    CoordNumbered(elemNumber,
+                                  coord.begin(),
+                                  coord.end(),
+                                  tensor.sizes().begin(),
+                                  tensor.sizes().end());
+                    return tensor.index(coord);
+                };
+
+                // Each element is compared once, whichever sample chose it.
+                std::vector<size_t> elements = m_sampleElements;
+                elements.insert(elements.end(), m_uniformElements.begin(), m_uniformElements.end());
+                std::sort(elements.begin(), elements.end());
+                elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+
+                for(size_t elemNumber : elements)
+                {
+                    size_t index = elemIndex(elemNumber);
+                    compareValid(reference.d[index], resultData[index], index, elemNumber);
+                }
+
+                for(size_t elemNumber : m_uniformElements)
+                {
+                    size_t index = elemIndex(elemNumber);
+                    uniformErrors += !AlmostEqual(reference.d[index], resultData[index]);
+                }
+            }
+            else if(m_validationStride == 1)
             {
                 std::vector<size_t> coord(tensor.dimensions());
-                size_t outerCount = CoordCount(tensor.sizes().begin() + 1, tensor.sizes().end());
 
                 size_t       prevBaseIndex = 0;
                 const size_t innerDimSize  = tensor.sizes()[0];
-                const size_t initialStride = tensor.strides()[0];
 
-                for(size_t i = 0; i < outerCount; i++)
-                {
+                // Checks the gap before each row just before the row is compared.
+                auto checkGap = [&](size_t i) {
+                    if(boundsCheck != BoundsCheckMode::NaN)
+                        return;
+
                     CoordNumbered(i,
                                   coord.begin() + 1,
                                   coord.end(),
@@ -482,8 +601,7 @@ namespace Tensile
                                   tensor.sizes().end());
                     size_t baseElemIndex = tensor.index(coord);
 
-                    if(boundsCheck == BoundsCheckMode::NaN && baseElemIndex != 0
-                       && baseElemIndex != prevBaseIndex + innerDimSize)
+                    if(baseElemIndex != 0 && baseElemIndex != prevBaseIndex + innerDimSize)
                     {
                         for(auto innerIndex = prevBaseIndex + innerDimSize;
                             innerIndex < baseElemIndex;
@@ -495,18 +613,9 @@ namespace Tensile
                     }
 
                     prevBaseIndex = baseElemIndex;
+                };
 
-                    for(size_t j = 0; j < innerDimSize; j++)
-                    {
-                        size_t elemIndex = baseElemIndex + (j * initialStride);
-
-                        Type referenceValue = reference.d[elemIndex];
-                        Type resultValue    = resultData[elemIndex];
-
-                        compareValid(
-                            referenceValue, resultValue, elemIndex, (i * tensor.sizes()[0]) + j);
-                    }
-                }
+                compareValid.compareTensor(tensor, reference.d, resultData, checkGap);
             }
             else
             {
@@ -537,6 +646,20 @@ namespace Tensile
                 std::cout << "Performed bounds check on " << boundsCheckElements << " elements ("
                           << elementsBeforeData << " before data)" << std::endl;
 
+            if(m_sampling)
+            {
+                // Only the uniform draws bound the error rate of D; the tiles are
+                // chosen where errors are most likely.
+                double bound = ValidationSampler::ErrorRateUpperBound(m_uniformElements.size(),
+                                                                      uniformErrors);
+                std::cout << "Compared " << compareValid.values() << " elements from "
+                          << m_sampledTiles << " of " << m_totalTiles << " tiles and "
+                          << m_uniformElements.size() << " uniform draws, "
+                          << compareValid.errors() << " incorrect; " << uniformErrors
+                          << " uniform draws incorrect, so the error rate of D is < " << bound
+                          << " at 95% confidence" << std::endl;
+            }
+
             compareValid.report();
             compareInvalid.report();
 
@@ -0,0 +1,249 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include "ValidationSampler.hpp"
+
+#include <Tensile/Utils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Tensile
+{
+    namespace Client
+    {
+        ValidationSampler::ValidationSampler(ContractionProblem const& problem,
+                                             size_t                    macroTile0,
+                                             size_t                    macroTile1,
+                                             size_t                    tileCount,
+                                             size_t                    interiorSamples,
+                                             uint64_t                  seed)
+            // Callers check Supports(), so these do not throw.
+            : m_dim0(problem.freeIndicesA().at(0).d)
+            , m_dim1(problem.freeIndicesB().at(0).d)
+            , m_macroTile0(std::max<size_t>(macroTile0, 1))
+            , m_macroTile1(std::max<size_t>(macroTile1, 1))
+            , m_interiorSamples(interiorSamples)
+            , m_seed(seed)
+        {
+            auto const& sizes = problem.d().sizes();
+
+            m_size0 = sizes[m_dim0];
+            m_size1 = sizes[m_dim1];
+
+            m_elementStrides.resize(sizes.size());
+            size_t stride = 1;
+            for(size_t i = 0; i < sizes.size(); i++)
+            {
+                m_elementStrides[i] = stride;
+                stride *= sizes[i];
+
+                if(i != m_dim0 && i != m_dim1)
+                {
+                    m_layerDims.push_back(i);
+                    m_layerSizes.push_back(sizes[i]);
+                }
+            }
+
+            size_t layers = CoordCount(m_layerSizes.begin(), m_layerSizes.end());
+
+            m_tiles0     = CeilDivide(m_size0, m_macroTile0);
+            m_tiles1     = CeilDivide(m_size1, m_macroTile1);
+            m_totalTiles    = m_tiles0 * m_tiles1 * layers;
+            m_totalElements = m_size0 * m_size1 * layers;
+
+            if(m_totalTiles == 0 || tileCount == 0)
+                return;
+
+            if(tileCount >= m_totalTiles)
+            {
+                m_tiles.resize(m_totalTiles);
+                for(size_t tile = 0; tile < m_totalTiles; tile++)
+                    m_tiles[tile] = tile;
+                return;
+            }
+
+            size_t const tilesPerLayer = m_tiles0 * m_tiles1;
+            size_t const lastTile0     = m_tiles0 - 1;
+            size_t const lastTile1     = (m_tiles1 - 1) * m_tiles0;
+            size_t const lastLayer     = (layers - 1) * tilesPerLayer;
+
+            for(size_t layer : {size_t(0), lastLayer})
+            {
+                for(size_t corner : {size_t(0), lastTile0, lastTile1, lastTile0 + lastTile1})
+                {
+                    corner += layer;
+                    if(m_tiles.size() < tileCount
+                       && std::find(m_tiles.begin(), m_tiles.end(), corner) == m_tiles.end())
+                        m_tiles.push_back(corner);
+                }
+            }
+
+            size_t const corners = m_tiles.size();
+            size_t const strata  = tileCount - corners;
+
+            std::mt19937_64 rng(m_seed);
+            for(size_t stratum = 0; stratum < strata; stratum++)
+            {
+                size_t begin = stratum * m_totalTiles / strata;
+                size_t end   = (stratum + 1) * m_totalTiles / strata;
+
+                // Step past a corner that already landed in this stratum.
+                for(size_t tries = 0; tries < end - begin; tries++)
+                {
+                    size_t tile = begin + (rng() + tries) % (end - begin);
+                    if(std::find(m_tiles.begin(), m_tiles.begin() + corners, tile)
+                       == m_tiles.begin() + corners)
+                    {
+                        m_tiles.push_back(tile);
+                        break;
+                    }
+                }
+            }
+        }
+
+        bool ValidationSampler::Supports(ContractionProblem const& problem)
+        {
+            return !problem.freeIndicesA().empty() && !problem.freeIndicesB().empty();
+        }
+
+        size_t ValidationSampler::elementNumber(size_t row, size_t col, size_t layer) const
+        {
+            size_t rv = row * m_elementStrides[m_dim0] + col * m_elementStrides[m_dim1];
+
+            for(size_t i = 0; i < m_layerDims.size(); i++)
+            {
+                rv += (layer % m_layerSizes[i]) * m_elementStrides[m_layerDims[i]];
+                layer /= m_layerSizes[i];
+            }
+
+            return rv;
+        }
+
+        void ValidationSampler::elements(size_t tile, std::vector<size_t>& rv) const
+        {
+            size_t tileNum = m_tiles.at(tile);
+
+            size_t const tile0 = tileNum % m_tiles0;
+            size_t const tile1 = (tileNum / m_tiles0) % m_tiles1;
+            size_t const layer = tileNum / (m_tiles0 * m_tiles1);
+
+            size_t const r0 = tile0 * m_macroTile0;
+            size_t const r1 = std::min(r0 + m_macroTile0, m_size0);
+            size_t const c0 = tile1 * m_macroTile1;
+            size_t const c1 = std::min(c0 + m_macroTile1, m_size1);
+
+            for(size_t col = c0; col < c1; col++)
+            {
+                rv.push_back(elementNumber(r0, col, layer));
+                if(r1 - 1 > r0)
+                    rv.push_back(elementNumber(r1 - 1, col, layer));
+            }
+
+            for(size_t row = r0 + 1; row + 1 < r1; row++)
+            {
+                rv.push_back(elementNumber(row, c0, layer));
+                if(c1 - 1 > c0)
+                    rv.push_back(elementNumber(row, c1 - 1, layer));
+            }
+
+            if(r1 - r0 <= 2 || c1 - c0 <= 2)
+                return;
+
+            size_t const first = rv.size();
+
+            std::mt19937_64 rng(m_seed ^ (tileNum * 0x9e3779b97f4a7c15));
+            for(size_t i = 0; i < m_interiorSamples; i++)
+            {
+                size_t row = r0 + 1 + rng() % (r1 - r0 - 2);
+                size_t col = c0 + 1 + rng() % (c1 - c0 - 2);
+                rv.push_back(elementNumber(row, col, layer));
+            }
+
+            std::sort(rv.begin() + first, rv.end());
+            rv.erase(std::unique(rv.begin() + first, rv.end()), rv.end());
+        }
+
+        void ValidationSampler::uniformElements(size_t count, std::vector<size_t>& rv) const
+        {
+            if(m_totalElements == 0)
+                return;
+
+            // A stream of its own, so it doesn't depend on which tiles were chosen.
+            std::mt19937_64                       rng(m_seed ^ 0x5bd1e9955bd1e995);
+            std::uniform_int_distribution<size_t> element(0, m_totalElements - 1);
+
+            for(size_t i = 0; i < count; i++)
+            {
+                size_t number = element(rng);
+                size_t row    = number % m_size0;
+                size_t col    = (number / m_size0) % m_size1;
+                size_t layer  = number / (m_size0 * m_size1);
+
+                rv.push_back(elementNumber(row, col, layer));
+            }
+        }
+
+        double ValidationSampler::ErrorRateUpperBound(size_t samples,
+                                                      size_t failures,
+                                                      double confidence)
+        {
+            if(samples == 0 || failures >= samples)
+                return 1.0;
+
+            double const alpha = 1.0 - confidence;
+            double const n     = samples;
+
+            if(failures == 0)
+                return 1.0 - std::pow(alpha, 1.0 / n);
+
+            // Largest p for which seeing at most `failures` errors is still
+            // plausible: P(X <= failures | n, p) = alpha.
+            auto cdf = [&](double p) {
+                double sum = 0;
+                for(size_t k = 0; k <= failures; k++)
+                    sum += std::exp(std::lgamma(n + 1) - std::lgamma(k + 1.0)
+                                    - std::lgamma(n - k + 1) + k * std::log(p)
+                                    + (n - k) * std::log1p(-p));
+                return sum;
+            };
+
+            double lo = failures / n, hi = 1.0;
+            for(int iter = 0; iter < 64; iter++)
+            {
+                double mid = (lo + hi) / 2;
+                if(cdf(mid) > alpha)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+
+            return hi;
+        }
+    } // namespace Client
+} // namespace Tensile
@@ -26,11 +26,18 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <shared_mutex>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include <Tensile/ContractionProblem.hpp>
+#include <Tensile/SolutionCacheFile.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 
 #include <Tensile/AMDGPU_Detail.hpp>
@@ -39,21 +46,97 @@
 
 namespace Tensile
 {
-    template <typename Value, typename Key, typename... Keys>
-    struct MultiLevelMap
+    /**
+     * Reverses the order of a list of types into a std::tuple.
+     */
+    template <typename... Ts>
+    struct ReversedTuple
+    {
+        using type = std::tuple<>;
+    };
+
+    template <typename T, typename... Ts>
+    struct ReversedTuple<T, Ts...>
+    {
+        using type = decltype(std::tuple_cat(std::declval<typename ReversedTuple<Ts...>::type>(),
+                                             std::declval<std::tuple<T>>()));
+    };
+
+    /**
+     * Describes how CacheMap matches a key.  By default keys are compared in
+     * full.  Keys which carry a precomputed fingerprint compare that first,
+     * so most entries which differ are rejected without reading the keys;
+     * CacheMap still compares the keys in full before returning an entry.
+     *
+     * heapBytes() estimates memory owned by the key outside of the entry
+     * itself, for enforcing a byte limit.
+     */
+    template <typename K>
+    struct CacheKeyTraits
     {
-        using type = typename MultiLevelMap<std::unordered_map<Key, Value>, Keys...>::type;
+        static size_t hash(K const& key)
+        {
+            return std::hash<K>()(key);
+        }
+
+        static bool fingerprintEqual(K const& lhs, K const& rhs)
+        {
+            return lhs == rhs;
+        }
+
+        static size_t heapBytes(K const& key)
+        {
+            return 0;
+        }
     };
 
-    template <typename Value, typename Key>
-    struct MultiLevelMap<Value, Key>
+    template <>
+    struct CacheKeyTraits<ContractionProblem>
     {
-        using type = std::unordered_map<Key, Value>;
+        static size_t hash(ContractionProblem const& key)
+        {
+            return std::hash<Fingerprint>()(key.fingerprint());
+        }
+
+        static bool fingerprintEqual(ContractionProblem const& lhs, ContractionProblem const& rhs)
+        {
+            return lhs.fingerprint() == rhs.fingerprint();
+        }
+
+        static size_t heapBytes(ContractionProblem const& key)
+        {
+            size_t rv = 0;
+
+            for(auto const* tensor : {&key.a(), &key.b(), &key.c(), &key.d()})
+                rv += tensor->sizes().heapBytes() + tensor->strides().heapBytes();
+
+            rv += key.problemSizes().heapBytes() + key.problemStrides().heapBytes();
+
+            rv += key.freeIndices().heapBytes() + key.freeIndicesA().heapBytes()
+                  + key.freeIndicesB().heapBytes();
+            rv += key.batchIndices().heapBytes() + key.boundIndices().heapBytes();
+
+            return rv;
+        }
     };
 
     /**
      * Thread-safe multi-valued cache.
      *
+     * Lookups take no locks: entries live in an open-addressed table of
+     * atomic pointers.  Inserts are serialized by a mutex.  When the table
+     * needs to grow, a new one is built from the existing entries and
+     * published atomically.
+     *
+     * By default the cache is unbounded, and superseded tables are only
+     * released when the cache is destroyed.  If an entry or byte limit is
+     * given, entries are evicted with the CLOCK algorithm: lookups mark
+     * entries as referenced, and an insert into a full cache sweeps a hand
+     * over the entries, clearing marks until it finds an unreferenced
+     * victim.  Evicted entries and tables are reclaimed once every lookup
+     * which could have seen them has finished, tracked with a two-epoch
+     * scheme on per-thread reader counters.
+     *
      * Note that due to a quirk with templates, the order of the keys in find() and add() is *opposite* of that in the type.
      *
      * e.g.
@@ -65,92 +148,450 @@ namespace Tensile
     template <typename Value, typename... Keys>
     class CacheMap
     {
-        using Map = typename MultiLevelMap<Value, Keys...>::type;
+        using Key = typename ReversedTuple<Keys...>::type;
+
+        struct Entry
+        {
+            Entry(size_t hash, Key const& key, Value const& value, size_t bytes)
+                : hash(hash)
+                , key(key)
+                , value(value)
+                , bytes(bytes)
+                , referenced(false)
+            {
+            }
+
+            size_t                    hash;
+            Key                       key;
+            Value                     value;
+            size_t                    bytes;
+            mutable std::atomic<bool> referenced;
+        };
+
+        struct Table
+        {
+            explicit Table(size_t capacity)
+                : mask(capacity - 1)
+                , slots(new std::atomic<Entry const*>[capacity])
+            {
+                for(size_t i = 0; i < capacity; i++)
+                    slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+
+            size_t capacity() const
+            {
+                return mask + 1;
+            }
+
+            size_t                                       mask;
+            std::unique_ptr<std::atomic<Entry const*>[]> slots;
+        };
+
+        /**
+         * An entry or table which has been unlinked, and the epoch in which
+         * that happened.
+         */
+        struct Retired
+        {
+            uint64_t               epoch;
+            std::unique_ptr<Entry> entry;
+            std::unique_ptr<Table> table;
+        };
+
+        /**
+         * Per-thread counters, striped across cache lines so that threads
+         * don't contend on them.
+         */
+        struct alignas(64) CounterStripe
+        {
+            std::atomic<int64_t> lookups{0};
+            std::atomic<int64_t> hits{0};
+            std::atomic<int64_t> readers[2] = {{0}, {0}};
+        };
+
+        /**
+         * Registers a lookup with the current epoch for the duration of
+         * the lookup.  Only needed when entries can be evicted.
+         */
+        class ReadGuard
+        {
+        public:
+            ReadGuard(CacheMap const& cache, CounterStripe& stripe)
+                : m_readers(nullptr)
+            {
+                if(!cache.bounded())
+                    return;
+
+                uint64_t epoch = cache.m_epoch.load(std::memory_order_acquire);
+                m_readers      = &stripe.readers[epoch & 1];
+                m_readers->fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            ~ReadGuard()
+            {
+                if(m_readers)
+                    m_readers->fetch_sub(1, std::memory_order_release);
+            }
+
+        private:
+            std::atomic<int64_t>* m_readers;
+        };
+
+        static constexpr size_t InitialCapacity = 64;
+        static constexpr size_t CounterStripes  = 16;
 
     public:
-        CacheMap(Value const& nullValue)
+        /**
+         * @param maxEntries Maximum number of entries, or 0 for no limit.
+         * @param maxBytes   Maximum resident bytes (entries and table), or 0
+         *                   for no limit.
+         */
+        CacheMap(Value const& nullValue, size_t maxEntries = 0, size_t maxBytes = 0)
             : m_nullValue(nullValue)
+            , m_maxEntries(maxEntries)
+            , m_maxBytes(maxBytes)
             , m_lookupEfficiency(Debug::Instance().printLookupEfficiency())
-            , m_lookups(0)
-            , m_hits(0)
-
         {
+            m_currentTable = std::make_unique<Table>(InitialCapacity);
+            m_table.store(m_currentTable.get(), std::memory_order_release);
         }
 
         ~CacheMap()
         {
             if(m_lookupEfficiency)
-                std::cout << "CacheMap: " << m_hits << "/" << m_lookups << " cache hits"
+            {
+                int64_t lookups = 0, hits = 0;
+                for(auto const& stripe : m_counters)
+                {
+                    lookups += stripe.lookups.load(std::memory_order_relaxed);
+                    hits += stripe.hits.load(std::memory_order_relaxed);
+                }
+
+                std::cout << "CacheMap: " << hits << "/" << lookups << " cache hits, "
+                          << lookups - hits << " misses, " << m_evictions << " evictions, "
+                          << m_size << " entries, " << residentBytes() << " resident bytes"
                           << std::endl;
+            }
         }
 
         template <typename... Ks>
         Value find(Ks const&... keys)
         {
-            std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+            auto& stripe = m_counters[counterStripe()];
+
+            ReadGuard guard(*this, stripe);
 
-            auto rv = find_impl(m_map, keys...);
+            size_t hash = keyHash(keys...);
+
+            Table const* table = m_table.load(std::memory_order_acquire);
+            Entry const* entry = find_entry(*table, hash, keys...);
 
             if(m_lookupEfficiency)
             {
-                m_lookups++;
-                if(rv != m_nullValue)
-                    m_hits++;
+                stripe.lookups.fetch_add(1, std::memory_order_relaxed);
+                if(entry)
+                    stripe.hits.fetch_add(1, std::memory_order_relaxed);
             }
 
-            return rv;
+            if(entry == nullptr)
+                return m_nullValue;
+
+            if(bounded() && !entry->referenced.load(std::memory_order_relaxed))
+                entry->referenced.store(true, std::memory_order_relaxed);
+
+            return entry->value;
         }
 
         template <typename... Ks>
         void add(Value const& value, Ks const&... ks)
         {
-            std::lock_guard<std::shared_timed_mutex> lock(m_mutex);
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if(bounded())
+                reclaim();
+
+            size_t hash  = keyHash(ks...);
+            Table* table = m_currentTable.get();
+
+            if(find_entry(*table, hash, ks...))
+                return;
+
+            size_t bytes = sizeof(Entry) + keyHeapBytes(ks...);
+
+            if(m_maxEntries > 0)
+            {
+                while(m_size > 0 && m_size >= m_maxEntries)
+                    evict(*table);
+            }
+
+            if(m_maxBytes > 0)
+            {
+                while(m_size > 0 && residentBytes() + bytes > m_maxBytes)
+                    evict(*table);
+            }
+
+            // Keep the load factor at or below 1/2 so probe sequences stay
+            // short and every probe is guaranteed to reach an empty slot.
+            if((m_size + m_tombstones + 1) * 2 > table->capacity())
+                table = rebuild(*table);
+
+            auto entry = std::make_unique<Entry>(hash, Key(ks...), value, bytes);
+
+            insert_entry(*table, entry.get(), std::memory_order_release);
+
+            m_size++;
+            m_entryBytes += bytes;
+
+            if(m_freeEntries.empty())
+            {
+                m_entries.push_back(std::move(entry));
+            }
+            else
+            {
+                m_entries[m_freeEntries.back()] = std::move(entry);
+                m_freeEntries.pop_back();
+            }
+        }
+
+        /**
+         * Calls f(key, value) for each entry, with the keys as a tuple in
+         * find() order.  Inserts are blocked for the duration.
+         */
+        template <typename F>
+        void forEach(F&& f) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for(auto const& entry : m_entries)
+            {
+                if(entry)
+                    f(entry->key, entry->value);
+            }
+        }
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_size;
+        }
 
-            add_impl(m_map, value, ks...);
+        int64_t evictions() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_evictions;
         }
 
     private:
-        template <typename SubMap, typename K>
-        Value find_impl(SubMap const& map, K const& key)
+        bool bounded() const
         {
-            auto iter = map.find(key);
+            return m_maxEntries > 0 || m_maxBytes > 0;
+        }
 
-            if(iter == map.end())
-                return m_nullValue;
+        Entry const* tombstone() const
+        {
+            return reinterpret_cast<Entry const*>(&m_tombstone);
+        }
 
-            return iter->second;
+        size_t residentBytes() const
+        {
+            return m_entryBytes + m_currentTable->capacity() * sizeof(std::atomic<Entry const*>);
         }
 
-        template <typename SubMap, typename K, typename... Ks>
-        Value find_impl(SubMap const& map, K const& key, Ks const&... ks)
+        template <typename... Ks>
+        Entry const* find_entry(Table const& table, size_t hash, Ks const&... keys) const
         {
-            auto iter = map.find(key);
+            for(size_t i = hash & table.mask;; i = (i + 1) & table.mask)
+            {
+                Entry const* entry = table.slots[i].load(std::memory_order_acquire);
 
-            if(iter == map.end())
-                return m_nullValue;
+                if(entry == nullptr)
+                    return nullptr;
+
+                if(entry == tombstone() || entry->hash != hash
+                   || !fingerprintEqual(entry->key, keys...))
+                    continue;
+
+                if(entry->key == std::tie(keys...))
+                    return entry;
+            }
+        }
+
+        void insert_entry(Table& table, Entry const* entry, std::memory_order order)
+        {
+            size_t i = entry->hash & table.mask;
+            for(;; i = (i + 1) & table.mask)
+            {
+                Entry const* slot = table.slots[i].load(std::memory_order_relaxed);
+                if(slot == nullptr)
+                    break;
+                if(slot == tombstone())
+                {
+                    m_tombstones--;
+                    break;
+                }
+            }
+
+            table.slots[i].store(entry, order);
+        }
+
+        /**
+         * Builds and publishes a new table holding the live entries, doubling
+         * the capacity if needed.  Dropping tombstones is enough otherwise.
+         */
+        Table* rebuild(Table const& old)
+        {
+            size_t capacity = old.capacity();
+            if((m_size + 1) * 4 > capacity)
+                capacity *= 2;
+
+            auto table   = std::make_unique<Table>(capacity);
+            m_tombstones = 0;
+
+            for(auto const& entry : m_entries)
+            {
+                if(entry)
+                    insert_entry(*table, entry.get(), std::memory_order_relaxed);
+            }
+
+            m_table.store(table.get(), std::memory_order_release);
+            retire(nullptr, std::move(m_currentTable));
+            m_currentTable = std::move(table);
+
+            return m_currentTable.get();
+        }
+
+        /**
+         * Advances the CLOCK hand to the first unreferenced entry and
+         * evicts it.
+         */
+        void evict(Table& table)
+        {
+            while(true)
+            {
+                if(m_hand >= m_entries.size())
+                    m_hand = 0;
+
+                auto& entry = m_entries[m_hand];
+
+                if(entry && !entry->referenced.exchange(false, std::memory_order_relaxed))
+                {
+                    for(size_t i = entry->hash & table.mask;; i = (i + 1) & table.mask)
+                    {
+                        if(table.slots[i].load(std::memory_order_relaxed) == entry.get())
+                        {
+                            table.slots[i].store(tombstone(), std::memory_order_release);
+                            break;
+                        }
+                    }
+
+                    m_tombstones++;
+                    m_size--;
+                    m_entryBytes -= entry->bytes;
+                    m_evictions++;
+
+                    retire(std::move(entry), nullptr);
+                    m_freeEntries.push_back(m_hand);
+                    m_hand++;
+                    return;
+                }
+
+                m_hand++;
+            }
+        }
+
+        void retire(std::unique_ptr<Entry> entry, std::unique_ptr<Table> table)
+        {
+            m_retired.push_back(
+                Retired{m_epoch.load(std::memory_order_relaxed), std::move(entry), std::move(table)});
+        }
+
+        /**
+         * Advances the epoch once no lookup registered with the previous
+         * one remains, and frees anything retired two or more epochs ago:
+         * lookups which could still reach it have all finished.
+         */
+        void reclaim()
+        {
+            uint64_t epoch = m_epoch.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            for(auto const& stripe : m_counters)
+            {
+                if(stripe.readers[(epoch + 1) & 1].load(std::memory_order_acquire) != 0)
+                    return;
+            }
+
+            m_epoch.store(epoch + 1, std::memory_order_release);
+
+            while(!m_retired.empty() && m_retired.front().epoch + 1 <= epoch)
+                m_retired.pop_front();
+        }
+
+        template <typename K>
+        static size_t keyHash(K const& key)
+        {
+            return CacheKeyTraits<K>::hash(key);
+        }
+
+        template <typename K, typename... Ks>
+        static size_t keyHash(K const& key, Ks const&... keys)
+        {
+            return combine_hashes(CacheKeyTraits<K>::hash(key), keyHash(keys...));
+        }
+
+        template <typename... Ks>
+        static size_t keyHeapBytes(Ks const&... keys)
+        {
+            return (CacheKeyTraits<Ks>::heapBytes(keys) + ...);
+        }
 
-            return find_impl(iter->second, ks...);
+        template <typename... Ks>
+        static bool fingerprintEqual(Key const& key, Ks const&... keys)
+        {
+            return fingerprintEqual_impl(key, std::index_sequence_for<Ks...>(), keys...);
         }
 
-        template <typename SubMap, typename K>
-        void add_impl(SubMap& map, Value const& value, K const& key)
+        template <size_t... Is, typename... Ks>
+        static bool
+            fingerprintEqual_impl(Key const& key, std::index_sequence<Is...>, Ks const&... keys)
         {
-            map.emplace(key, value);
+            return (CacheKeyTraits<std::tuple_element_t<Is, Key>>::fingerprintEqual(
+                        std::get<Is>(key), keys)
+                    && ...);
         }
 
-        template <typename SubMap, typename K, typename... Ks>
-        void add_impl(SubMap& map, Value const& value, K const& key, Ks const&... ks)
+        static size_t counterStripe()
         {
-            add_impl(map[key], value, ks...);
+            static std::atomic<size_t> nextStripe(0);
+            thread_local size_t        stripe
+                = nextStripe.fetch_add(1, std::memory_order_relaxed) % CounterStripes;
+            return stripe;
         }
 
-        Map                     m_map;
-        std::shared_timed_mutex m_mutex;
-        Value                   m_nullValue;
+        std::atomic<Table const*> m_table;
+        std::atomic<uint64_t>     m_epoch{0};
+
+        std::unique_ptr<Table>              m_currentTable;
+        std::vector<std::unique_ptr<Entry>> m_entries;
+        std::vector<size_t>                 m_freeEntries;
+        std::deque<Retired>                 m_retired;
+        mutable std::mutex                  m_mutex;
+        Value                               m_nullValue;
+
+        size_t  m_maxEntries;
+        size_t  m_maxBytes;
+        size_t  m_size       = 0;
+        size_t  m_tombstones = 0;
+        size_t  m_entryBytes = 0;
+        size_t  m_hand       = 0;
+        int64_t m_evictions  = 0;
 
-        bool                 m_lookupEfficiency;
-        std::atomic<int64_t> m_lookups;
-        std::atomic<int64_t> m_hits;
+        std::aligned_storage_t<sizeof(Entry), alignof(Entry)> m_tombstone;
+
+        bool                                      m_lookupEfficiency;
+        std::array<CounterStripe, CounterStripes> m_counters;
     };
 
     template <typename MyProblem, typename MySolution = typename MyProblem::Solution>
@@ -160,10 +601,95 @@ namespace Tensile
         using Library = SolutionLibrary<MyProblem, MySolution>;
         using Cache = CacheMap<std::tuple<std::shared_ptr<MySolution>, double>, AMDGPU, MyProblem>;
 
+        using SolutionResolver = std::function<std::shared_ptr<MySolution>(
+            SolutionCacheFile::Record const&, AMDGPU const&)>;
+        using PlaceholderLocator = std::function<int32_t(MySolution const&)>;
+
         CachingLibrary(std::shared_ptr<Library> subLibrary)
             : m_subLibrary(subLibrary)
-            , m_cache(std::make_tuple(nullptr, std::numeric_limits<double>::max()))
+            , m_cache(std::make_tuple(nullptr, std::numeric_limits<double>::max()),
+                      Debug::Instance().solutionCacheEntries(),
+                      Debug::Instance().solutionCacheBytes())
+        {
+        }
+
+        /**
+         * Consults `file` whenever a problem misses in memory, before
+         * searching the sub-library.  `resolve` maps a stored record back to
+         * a solution, returning nullptr if it isn't available.  `locate`, if
+         * given, names the placeholder library a solution is read from, so
+         * that it can be stored alongside the solution index.
+         *
+         * New selections are only written back by savePersistentCache().
+         *
+         * Not thread-safe with respect to concurrent lookups.
+         */
+        void setPersistentCache(std::shared_ptr<SolutionCacheFile> file,
+                                SolutionResolver                   resolve,
+                                PlaceholderLocator                 locate = nullptr)
+        {
+            m_persistentCache   = std::move(file);
+            m_resolveSolution   = std::move(resolve);
+            m_locatePlaceholder = std::move(locate);
+        }
+
+        std::shared_ptr<SolutionCacheFile> persistentCache() const
+        {
+            return m_persistentCache;
+        }
+
+        /// Whether selections have been made since the file was last saved.
+        bool persistentCacheDirty() const
+        {
+            return m_persistentDirty;
+        }
+
+        /**
+         * Writes the contents of the persistent cache file merged with every
+         * entry in memory back to the file.
+         */
+        bool savePersistentCache() const
         {
+            if(!m_persistentCache)
+                return false;
+
+            std::unordered_map<Fingerprint, SolutionCacheFile::Record> records;
+
+            auto recordKey = [](SolutionCacheFile::Record const& record) {
+                Fingerprint key;
+                key.add(record.fingerprintLo)
+                    .add(record.fingerprintHi)
+                    .add(record.processor)
+                    .add(record.computeUnitCount);
+                return key;
+            };
+
+            for(auto const& record : m_persistentCache->records())
+                records[recordKey(record)] = record;
+
+            m_cache.forEach([&](auto const& key, auto const& value) {
+                auto const& solution    = std::get<0>(value);
+                int32_t     placeholder = m_locatePlaceholder ? m_locatePlaceholder(*solution) : -1;
+
+                auto record = SolutionCacheFile::MakeRecord(std::get<0>(key).fingerprint(),
+                                                            std::get<1>(key),
+                                                            solution->index,
+                                                            std::get<1>(value),
+                                                            placeholder);
+                records[recordKey(record)] = record;
+            });
+
+            std::vector<SolutionCacheFile::Record> rv;
+            rv.reserve(records.size());
+            for(auto const& pair : records)
+                rv.push_back(pair.second);
+
+            bool saved = SolutionCacheFile::Write(
+                m_persistentCache->filename(), m_persistentCache->libraryHash(), rv);
+            if(saved)
+                m_persistentDirty = false;
+
+            return saved;
         }
 
         virtual std::shared_ptr<MySolution> findBestSolution(MyProblem const& problem,
@@ -176,16 +702,18 @@ namespace Tensile
                 double cachedFitness = std::numeric_limits<double>::max();
                 fitness              = (fitness) ? fitness : &cachedFitness;
 
-                auto const&                 amdgpu = dynamic_cast<AMDGPU const&>(hardware);
-                std::shared_ptr<MySolution> solution;
-                std::tie(solution, *fitness) = m_cache.find(problem, amdgpu);
+                auto const& amdgpu   = dynamic_cast<AMDGPU const&>(hardware);
+                auto        solution = findCachedSolution(problem, amdgpu, fitness);
 
                 if(solution)
                     return solution;
 
                 solution = m_subLibrary->findBestSolution(problem, hardware, fitness);
                 if(solution)
+                {
                     m_cache.add(std::make_tuple(solution, *fitness), problem, amdgpu);
+                    m_persistentDirty = true;
+                }
 
                 return solution;
             }
@@ -195,6 +723,44 @@ namespace Tensile
             }
         }
 
+        /**
+         * Looks every problem up in the cache first and passes only the
+         * misses on to the sub-library, as one batch.
+         */
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>& fitness) const override
+        {
+            auto amdgpu = dynamic_cast<AMDGPU const*>(&hardware);
+            if(amdgpu == nullptr)
+                return m_subLibrary->findBestSolutions(
+                    problems, indices, hardware, solutions, fitness);
+
+            std::vector<size_t> misses;
+            for(size_t i : indices)
+            {
+                solutions[i] = findCachedSolution(problems[i], *amdgpu, &fitness[i]);
+                if(!solutions[i])
+                    misses.push_back(i);
+            }
+
+            if(misses.empty())
+                return;
+
+            m_subLibrary->findBestSolutions(problems, misses, hardware, solutions, fitness);
+
+            for(size_t i : misses)
+            {
+                if(solutions[i])
+                {
+                    m_cache.add(std::make_tuple(solutions[i], fitness[i]), problems[i], *amdgpu);
+                    m_persistentDirty = true;
+                }
+            }
+        }
+
         virtual SolutionSet<MySolution> findAllSolutions(MyProblem const& problem,
                                                          Hardware const&  hardware) const override
         {
@@ -231,8 +797,40 @@ namespace Tensile
         }
 
     private:
+        /**
+         * Checks the in-memory cache, then the persistent cache file if one
+         * is attached.  Hits from the file are added to the in-memory cache.
+         */
+        std::shared_ptr<MySolution> findCachedSolution(MyProblem const& problem,
+                                                       AMDGPU const&    amdgpu,
+                                                       double*          fitness) const
+        {
+            std::shared_ptr<MySolution> solution;
+            std::tie(solution, *fitness) = m_cache.find(problem, amdgpu);
+
+            if(solution || !m_persistentCache)
+                return solution;
+
+            auto record = m_persistentCache->find(problem.fingerprint(), amdgpu);
+            if(record)
+                solution = m_resolveSolution(*record, amdgpu);
+
+            if(solution)
+            {
+                *fitness = record->fitness;
+                m_cache.add(std::make_tuple(solution, *fitness), problem, amdgpu);
+            }
+
+            return solution;
+        }
+
         std::shared_ptr<Library> m_subLibrary;
         mutable Cache            m_cache;
+
+        std::shared_ptr<SolutionCacheFile> m_persistentCache;
+        SolutionResolver                   m_resolveSolution;
+        PlaceholderLocator                 m_locatePlaceholder;
+        mutable std::atomic<bool>          m_persistentDirty{false};
     };
 
 #if 0
@@ -26,6 +26,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
 #include <type_traits>
 
 namespace Tensile
@@ -184,6 +188,75 @@ namespace Tensile
         return rv;
     }
 
+    /**
+ * 128-bit fingerprint accumulated from a stream of words.  Two
+ * independently-mixed 64-bit lanes make accidental collisions negligible, so
+ * it can stand in for a full comparison of the values it was built from.
+ */
+    struct Fingerprint
+    {
+        uint64_t lo = 0x9e3779b97f4a7c15;
+        uint64_t hi = 0xc2b2ae3d27d4eb4f;
+
+        static uint64_t mix(uint64_t v)
+        {
+            v ^= v >> 33;
+            v *= 0xff51afd7ed558ccd;
+            v ^= v >> 33;
+            v *= 0xc4ceb9fe1a85ec53;
+            v ^= v >> 33;
+            return v;
+        }
+
+        Fingerprint& add(uint64_t v)
+        {
+            lo = mix(lo ^ v);
+            hi = mix(hi + ((v << 32) | (v >> 32)) + 0x165667b19e3779f9);
+            return *this;
+        }
+
+        Fingerprint& add(std::string const& str)
+        {
+            add(str.size());
+
+            size_t pos = 0;
+            for(; pos + sizeof(uint64_t) <= str.size(); pos += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, str.data() + pos, sizeof(word));
+                add(word);
+            }
+
+            if(pos < str.size())
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, str.data() + pos, str.size() - pos);
+                add(word);
+            }
+
+            return *this;
+        }
+
+        template <typename Iter>
+        Fingerprint& add(Iter begin, Iter end)
+        {
+            add(static_cast<uint64_t>(std::distance(begin, end)));
+            for(; begin != end; begin++)
+                add(static_cast<uint64_t>(*begin));
+            return *this;
+        }
+
+        bool operator==(Fingerprint const& rhs) const
+        {
+            return lo == rhs.lo && hi == rhs.hi;
+        }
+
+        bool operator!=(Fingerprint const& rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+
     template <size_t N, class... Types>
     struct tuple_hash
     {
@@ -222,6 +295,15 @@ namespace Tensile
 
 namespace std
 {
+    template <>
+    struct hash<Tensile::Fingerprint>
+    {
+        inline size_t operator()(Tensile::Fingerprint const& fingerprint) const
+        {
+            return fingerprint.lo ^ fingerprint.hi;
+        }
+    };
+
     template <class... Types>
     struct hash<tuple<Types...>>
     {
@@ -27,11 +27,14 @@
 #pragma once
 
 #include <Tensile/ArithmeticUnitTypes.hpp>
+#include <Tensile/Comparison.hpp>
 #include <Tensile/KernelLanguageTypes.hpp>
 #include <Tensile/PerformanceMetricTypes.hpp>
 #include <Tensile/ScalarValueTypes.hpp>
+#include <Tensile/SmallVector.hpp>
 #include <Tensile/Tensile.hpp>
 
+#include <Tensile/ContractionProblemView.hpp>
 #include <Tensile/ContractionProblem_fwd.hpp>
 #include <Tensile/ContractionSolution_fwd.hpp>
 
@@ -57,6 +60,8 @@ namespace Tensile
     public:
         using Solution = ContractionSolution;
         using Inputs   = ContractionInputs;
+        using View     = ContractionProblemView;
+        using Program  = Predicates::Contraction::Program;
 
         ContractionProblem() = default;
 
@@ -85,7 +90,7 @@ namespace Tensile
             };
             std::string description() const;
         };
-        using ZeroPads = std::vector<ZeroPad>;
+        using ZeroPads = SmallVector<ZeroPad, 1>;
 
         /**
    * Represents a pair of free indices in a tensor contraction.
@@ -97,7 +102,7 @@ namespace Tensile
             size_t c; //< Dimension of C which corresponds for this index
             size_t d; //< Dimension of D which corresponds for this index
         };
-        using FreeIndices = std::vector<FreeIndex>;
+        using FreeIndices = SmallVector<FreeIndex, 2>;
 
         /**
    * Represents a batched index in a tensor contraction.
@@ -106,7 +111,7 @@ namespace Tensile
         {
             size_t a, b, c, d;
         };
-        using BatchIndices = std::vector<BatchIndex>;
+        using BatchIndices = SmallVector<BatchIndex, 2>;
 
         /**
    * Represents a bound (or summed) index in a tensor contraction.
@@ -123,7 +128,41 @@ namespace Tensile
             ZeroPad bZeroPad;
             bool    aMirror, bMirror;
         };
-        using BoundIndices = std::vector<BoundIndex>;
+        using BoundIndices = SmallVector<BoundIndex, 2>;
+
+        /// Per-index sizes, and the strides of all four tensors; held inline
+        /// for up to batched GEMM so building one does not allocate.
+        using Sizes   = SmallVector<size_t, 4>;
+        using Strides = SmallVector<size_t, 12>;
+
+        /**
+   * Index names and operation identifier, shared by every problem with the
+   * same index structure and tensor ops.  normalize() interns these in a
+   * process-wide table looked up by that structure, so building a problem
+   * whose structure has been seen before formats no strings and takes no
+   * lock.  Entries are never freed.
+   *
+   * Ids are handed out in order of first use, so they differ between
+   * processes.  Problems compare by `id` rather than by identifier: that
+   * order is only meaningful within one process and must not be persisted.
+   */
+        struct Operation
+        {
+            uint32_t    id = 0;
+            std::string aNames;
+            std::string bNames;
+            std::string cNames;
+            std::string dNames;
+            std::string sumNames;
+            std::string identifier;
+            Fingerprint fingerprint; //< Of `identifier` alone.
+        };
+
+        /**
+   * Interned id of an operation identifier: equal to operationId() of every
+   * problem whose operationIdentifier() is `identifier`.
+   */
+        static uint32_t OperationId(std::string const& identifier);
 
         virtual std::string description() const;
 
@@ -479,12 +518,12 @@ namespace Tensile
                 return idx - d().dimensions();
         }
 
-        std::vector<size_t> const& problemSizes() const
+        Sizes const& problemSizes() const
         {
             return m_problemSizes;
         }
 
-        std::vector<size_t> const& problemStrides() const
+        Strides const& problemStrides() const
         {
             return m_problemStrides;
         }
@@ -742,44 +781,56 @@ namespace Tensile
 
         std::string const& aNames() const
         {
-            return m_aNames;
+            return m_operation->aNames;
         }
         std::string const& bNames() const
         {
-            return m_bNames;
+            return m_operation->bNames;
         }
         std::string const& cNames() const
         {
-            return m_cNames;
+            return m_operation->cNames;
         }
         std::string const& dNames() const
         {
-            return m_dNames;
+            return m_operation->dNames;
         }
         std::string const& sumNames() const
         {
-            return m_sumNames;
+            return m_operation->sumNames;
         }
 
         bool transA() const
         {
-            return m_aNames == "lik";
+            return m_operation->aNames == "lik";
         }
         bool transB() const
         {
-            return m_bNames == "jlk";
+            return m_operation->bNames == "jlk";
         }
 
         std::string        operationName() const;
         std::string const& operationIdentifier() const
         {
-            return m_operationIdentifier;
+            return m_operation->identifier;
+        }
+        uint32_t operationId() const
+        {
+            return m_operation->id;
         }
         std::string operationDescription() const
         {
             return getOperationDescription();
         }
 
+        /**
+   * 128-bit fingerprint identifying this problem for solution selection.
+   * The structural part (operation identifier and tensor descriptors) is
+   * computed once by normalize(); the selection flags are folded in on each
+   * call since they can be changed afterwards.
+   */
+        Fingerprint fingerprint() const;
+
         void setWorkspaceSize(size_t size)
         {
             m_workspaceSize = size;
@@ -808,12 +859,8 @@ namespace Tensile
         TensorOps        m_cOps;
         TensorOps        m_dOps;
 
-        std::string m_aNames;
-        std::string m_bNames;
-        std::string m_cNames;
-        std::string m_dNames;
-        std::string m_sumNames;
-        std::string m_operationIdentifier;
+        Operation const* m_operation = &EmptyOperation();
+        Fingerprint      m_fingerprint;
 
         bool              m_transA;
         bool              m_transB;
@@ -843,13 +890,13 @@ namespace Tensile
         ZeroPads m_aZeroPads;
         ZeroPads m_bZeroPads;
 
-        std::vector<size_t> m_freeSizesA;
-        std::vector<size_t> m_freeSizesB;
-        std::vector<size_t> m_batchSizes;
-        std::vector<size_t> m_boundSizes;
+        Sizes m_freeSizesA;
+        Sizes m_freeSizesB;
+        Sizes m_batchSizes;
+        Sizes m_boundSizes;
 
-        std::vector<size_t> m_problemSizes;
-        std::vector<size_t> m_problemStrides;
+        Sizes               m_problemSizes;
+        Strides             m_problemStrides;
         std::vector<size_t> m_convProblemSizes;
 
         bool   m_transposeC01;
@@ -865,13 +912,18 @@ namespace Tensile
         void normalize();
         void consistencyCheck() const;
 
-        void getIndexNames(std::string& aNames,
-                           std::string& bNames,
-                           std::string& cNames,
-                           std::string& dNames,
-                           std::string& sumNames) const;
+        using IndexNames = SmallVector<char, 8>;
+
+        void getIndexNames(IndexNames& aNames,
+                           IndexNames& bNames,
+                           IndexNames& cNames,
+                           IndexNames& dNames,
+                           IndexNames& sumNames) const;
+
+        static Operation const& EmptyOperation();
 
-        std::string getOperationIdentifier() const;
+        Operation const* getOperation() const;
+        Fingerprint getFingerprint() const;
         std::string getOperationDescription() const;
     };
 
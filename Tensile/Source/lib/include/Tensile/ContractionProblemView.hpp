@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Tensile/ContractionProblem_fwd.hpp>
+#include <Tensile/Macros.hpp>
+#include <Tensile/Properties.hpp>
+
+namespace Tensile
+{
+    /**
+     * \ingroup Problem
+     *
+     * The properties of one ContractionProblem read while selecting a
+     * solution for it.  Each is computed from the problem the first time it
+     * is read and reused after that.  One view is created per lookup and
+     * passed down through every level of the library, so the problem type
+     * checks, the keys of matching tables and the predicates of each
+     * candidate solution all read a property at most once between them.
+     */
+    class TENSILE_API ContractionProblemView
+    {
+    public:
+        /// Indices of each kind that have a value of their own.
+        static constexpr size_t MaxSizeIndex = 8;
+        static constexpr size_t MaxIndex     = 3;
+
+        /**
+         * Sizes and strides take a run of values, one per index:
+         * `Size0 + i` is `problem.size(i)`.  Free0Size and Free1Size are the
+         * sizes read by Free0SizeMultiple and Free1SizeMultiple, which swap
+         * A and B when C is transposed.
+         */
+        enum Value : uint8_t
+        {
+            Size0         = 0,
+            Free0Size0    = Size0 + MaxSizeIndex,
+            Free1Size0    = Free0Size0 + MaxIndex,
+            FreeSizeA0    = Free1Size0 + MaxIndex,
+            FreeSizeB0    = FreeSizeA0 + MaxIndex,
+            BatchSize0    = FreeSizeB0 + MaxIndex,
+            BoundSize0    = BatchSize0 + MaxIndex,
+            StrideA0      = BoundSize0 + MaxIndex,
+            StrideB0      = StrideA0 + MaxIndex,
+            StrideC0      = StrideB0 + MaxIndex,
+            StrideD0      = StrideC0 + MaxIndex,
+            ElementBytesA = StrideD0 + MaxIndex,
+            ElementBytesB,
+            ElementBytesD,
+            TypeA,
+            TypeB,
+            TypeC,
+            TypeD,
+            HighPrecisionAccumulate,
+            DeterministicMode,
+            KernelLanguage,
+            ArithmeticUnit,
+            StridedBatched,
+            PersistentKernelEligible,
+            LeadingFree0Size,
+            LeadingFree1Size,
+            ElementsD,
+            WorkspaceSize,
+            Count
+        };
+
+        static_assert(Count <= 64, "Values must fit in the valid mask.");
+
+        /**
+         * The value read by `property`, or -1 if it has none.  Resolved once
+         * when a library is loaded, not per lookup.
+         */
+        static int PropertyValue(Property<ContractionProblem> const& property);
+
+        /**
+         * \param memoize If false, every read computes the value again.  Only
+         * useful to measure what the memoization saves.
+         */
+        explicit ContractionProblemView(ContractionProblem const& problem, bool memoize = true)
+            : m_problem(problem)
+            , m_keep(memoize ? ~uint64_t(0) : 0)
+        {
+        }
+
+        ContractionProblemView(ContractionProblemView const&) = delete;
+        ContractionProblemView& operator=(ContractionProblemView const&) = delete;
+
+        ContractionProblem const& problem() const
+        {
+            return m_problem;
+        }
+
+        uint64_t get(uint8_t value)
+        {
+            uint64_t bit = uint64_t(1) << value;
+            if(!(m_valid & bit))
+            {
+                m_values[value] = compute(value);
+                m_valid |= bit & m_keep;
+                m_computed++;
+            }
+
+            return m_values[value];
+        }
+
+        /// Number of values computed from the problem so far.
+        size_t computeCount() const
+        {
+            return m_computed;
+        }
+
+    private:
+        uint64_t compute(uint8_t value) const;
+
+        ContractionProblem const& m_problem;
+        uint64_t                  m_valid    = 0;
+        uint64_t                  m_keep     = 0;
+        size_t                    m_computed = 0;
+        uint64_t                  m_values[Count];
+    };
+} // namespace Tensile
@@ -86,10 +86,12 @@ namespace Tensile
             implemented = true
         };
 
+        // Orders by operation id, which is process-local; nothing may
+        // persist this order.
         static int compare(ContractionProblem const& lhs, ContractionProblem const& rhs)
         {
-            return LexicographicCompare(lhs.operationIdentifier(),
-                                        rhs.operationIdentifier(),
+            return LexicographicCompare(lhs.operationId(),
+                                        rhs.operationId(),
                                         lhs.highPrecisionAccumulate(),
                                         rhs.highPrecisionAccumulate(),
                                         lhs.kernelLanguage(),
@@ -127,20 +129,7 @@ namespace std
     {
         inline size_t operator()(Tensile::ContractionProblem const& problem) const
         {
-            return Tensile::hash_combine(problem.operationIdentifier(),
-                                         problem.a(),
-                                         problem.b(),
-                                         problem.c(),
-                                         problem.d(),
-                                         problem.highPrecisionAccumulate(),
-                                         problem.kernelLanguage(),
-                                         problem.deterministicMode(),
-                                         problem.arithmeticUnit(),
-                                         problem.workspaceSize(),
-                                         problem.stridedBatched(),
-                                         problem.performanceMetric(),
-                                         problem.fp16AltImpl(),
-                                         problem.fp16AltImplRound());
+            return std::hash<Tensile::Fingerprint>()(problem.fingerprint());
         }
     };
 
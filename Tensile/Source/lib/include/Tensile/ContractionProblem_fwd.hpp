@@ -30,8 +30,17 @@ namespace Tensile
 {
 
     class ContractionProblem;
+    class ContractionProblemView;
     struct ContractionInputs;
 
+    namespace Predicates
+    {
+        namespace Contraction
+        {
+            class Program;
+        }
+    }
+
     template <typename A     = float,
               typename B     = A,
               typename C     = A,
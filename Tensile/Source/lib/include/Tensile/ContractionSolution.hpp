@@ -36,6 +36,7 @@
 
 #include <Tensile/ContractionProblem_fwd.hpp>
 #include <Tensile/DataTypes.hpp>
+#include <Tensile/PredicateProgram.hpp>
 #include <Tensile/Predicates.hpp>
 #include <Tensile/Utils.hpp>
 
@@ -212,37 +213,146 @@ namespace Tensile
         virtual std::vector<KernelInvocation>
             solve(Problem const& problem, Inputs const& inputs, Hardware const& hardware) const;
 
+        /**
+   * Same as above, writing the calls into `kernels`.  The invocations left
+   * in `kernels` by an earlier call are refilled in place, so solving
+   * repeatedly into the same vector does not allocate once the arguments
+   * fit in the storage of each invocation.
+   */
+        virtual void solve(Problem const&                 problem,
+                           Inputs const&                  inputs,
+                           Hardware const&                hardware,
+                           std::vector<KernelInvocation>& kernels) const;
+
+        template <typename TypedInputs>
+        void solveTyped(Problem const&                 problem,
+                        TypedInputs const&             inputs,
+                        Hardware const&                hardware,
+                        std::vector<KernelInvocation>& rv) const;
+
+        template <typename TypedInputs, bool T_Debug>
+        void generateCalls(Problem const&                 problem,
+                           TypedInputs const&             inputs,
+                           Hardware const&                hardware,
+                           std::vector<KernelInvocation>& rv) const;
+
+        /**
+   * The kernel calls solving one problem, kept so they can be launched
+   * again with other inputs.  `bind()` rewrites only the arguments taken
+   * from the inputs (pointers, alpha and beta) at offsets recorded when the
+   * calls were prepared; sizes, strides, magic numbers and launch bounds
+   * are not recomputed.
+   */
+        class TENSILE_API PreparedCall
+        {
+        public:
+            /**
+     * Points the calls at new inputs, which must have the same types as
+     * the inputs they were prepared with.  Checks the inputs against the
+     * problem as `solve()` does.
+     */
+            void bind(Inputs const& inputs);
+
+            std::vector<KernelInvocation> const& kernels() const
+            {
+                return m_kernels;
+            }
+
+            Problem const& problem() const
+            {
+                return *m_problem;
+            }
+
+        private:
+            friend class ContractionSolution;
+
+            /// Member of the inputs written to a slot.
+            enum class Field : uint8_t
+            {
+                A,
+                B,
+                C,
+                D,
+                BatchA,
+                BatchB,
+                BatchC,
+                BatchD,
+                Workspace,
+                Alpha,
+                Beta
+            };
+
+            struct Slot
+            {
+                uint32_t kernel;
+                uint32_t offset;
+                Field    field;
+            };
+
+            template <typename TypedInputs>
+            static void BindTyped(PreparedCall& call, Inputs const& inputs);
+
+            std::shared_ptr<Problem const> m_problem;
+            std::vector<KernelInvocation>  m_kernels;
+            std::vector<Slot>              m_slots;
+
+            void (*m_bind)(PreparedCall&, Inputs const&) = nullptr;
+        };
+
+        /**
+   * Generates the kernel calls solving `problem` with `inputs`, as
+   * `solve()` does, and records where each input is written so they can be
+   * relaunched with other inputs through `PreparedCall::bind()`.
+   */
+        PreparedCall
+            prepare(Problem const& problem, Inputs const& inputs, Hardware const& hardware) const;
+
         template <typename TypedInputs>
-        std::vector<KernelInvocation> solveTyped(Problem const&     problem,
-                                                 TypedInputs const& inputs,
-                                                 Hardware const&    hardware) const;
+        void prepareTyped(Problem const&     problem,
+                          TypedInputs const& inputs,
+                          Hardware const&    hardware,
+                          PreparedCall&      rv) const;
 
         template <typename TypedInputs, bool T_Debug>
-        KernelInvocation generateSingleCall(Problem const&     problem,
-                                            TypedInputs const& inputs,
-                                            Hardware const&    hardware) const;
+        void generateSingleCall(Problem const&     problem,
+                                TypedInputs const& inputs,
+                                Hardware const&    hardware,
+                                KernelInvocation&  rv) const;
 
         template <typename TypedInputs, bool T_Debug>
-        KernelInvocation generateBetaOnlyCall(Problem const&     problem,
-                                              TypedInputs const& inputs,
-                                              Hardware const&    hardware) const;
+        void generateBetaOnlyCall(Problem const&     problem,
+                                  TypedInputs const& inputs,
+                                  Hardware const&    hardware,
+                                  KernelInvocation&  rv) const;
 
         template <typename TypedInputs>
-        std::string betaOnlyKernelName(Problem const&     problem,
-                                       TypedInputs const& inputs,
-                                       Hardware const&    hardware) const;
+        void betaOnlyKernelName(Problem const&     problem,
+                                TypedInputs const& inputs,
+                                Hardware const&    hardware,
+                                std::string&       name) const;
 
         template <typename TypedInputs, bool T_Debug>
-        KernelInvocation generateOutputConversionCall(Problem const&     problem,
-                                                      TypedInputs const& inputs,
-                                                      Hardware const&    hardware) const;
+        void generateOutputConversionCall(Problem const&     problem,
+                                          TypedInputs const& inputs,
+                                          Hardware const&    hardware,
+                                          KernelInvocation&  rv) const;
 
         template <typename TypedInputs>
-        std::string outputConversionKernelName(Problem const&     problem,
-                                               TypedInputs const& inputs,
-                                               Hardware const&    hardware) const;
+        void outputConversionKernelName(Problem const&     problem,
+                                        TypedInputs const& inputs,
+                                        Hardware const&    hardware,
+                                        std::string&       name) const;
 
         bool canSolve(Problem const& problem, Hardware const& hardware) const;
+        bool canSolve(ContractionProblemView& view, Hardware const& hardware) const;
+
+        /**
+         * Evaluates `problemPredicate`, through `problemProgram` if it was
+         * compiled from the current predicate.  `view` should be shared
+         * between the solutions checked against one problem: each property is
+         * then read from the problem once, however many solutions test it.
+         */
+        bool checkProblemPredicate(ContractionProblemView& view) const;
 
         bool matchesProblemType(Problem const& problem, Hardware const& hardware) const;
 
@@ -303,6 +413,9 @@ namespace Tensile
         std::shared_ptr<Predicates::Predicate<Hardware>> hardwarePredicate
             = std::make_shared<Predicates::True<Hardware>>();
 
+        /// `problemPredicate` compiled at load time.
+        Predicates::Contraction::Program problemProgram;
+
         SizeMapping sizeMapping;
 
         ProblemType problemType;
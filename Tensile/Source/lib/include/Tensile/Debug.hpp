@@ -83,17 +83,33 @@ namespace Tensile
 
         int getSolutionIndex() const;
 
+        // Limits on the solution cache, from TENSILE_SOLUTION_CACHE_SIZE.
+        // 0 means no limit.
+        size_t solutionCacheEntries() const;
+        size_t solutionCacheBytes() const;
+
+        // Persistent solution cache file, from TENSILE_SOLUTION_CACHE_FILE.
+        std::string solutionCacheFile() const;
+
+        // Parses a TENSILE_SOLUTION_CACHE_SIZE value: a decimal entry count,
+        // or a decimal byte count followed by K, M or G.  Returns false and
+        // leaves both limits alone if the value is anything else.
+        static bool ParseSolutionCacheSize(char const* text, size_t& entries, size_t& bytes);
+
     private:
         friend LazySingleton<Debug>;
 
         int         m_value;
         int         m_value2;
-        bool        m_naivePropertySearch = false;
-        bool        m_debugSelection      = false;
-        int         m_experimentSelection = 0;
-        int         m_solution_index      = -1;
-        bool        m_solselTrace         = false;
-        std::string m_metric              = "";
+        bool        m_naivePropertySearch  = false;
+        bool        m_debugSelection       = false;
+        int         m_experimentSelection  = 0;
+        int         m_solution_index       = -1;
+        bool        m_solselTrace          = false;
+        std::string m_metric               = "";
+        size_t      m_solutionCacheEntries = 0;
+        size_t      m_solutionCacheBytes   = 0;
+        std::string m_solutionCacheFile    = "";
 
         Debug();
     };
@@ -26,8 +26,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <vector>
 
 #include <Tensile/MLFeatures.hpp>
@@ -207,6 +210,200 @@ namespace Tensile
             Value             value;
         };
 
+        /**
+         * @brief The trees of a forest flattened into one pool of nodes
+         *
+         * Each tree's nodes are stored breadth-first, so a prediction walks
+         * forward through memory.  The two reserved indices are replaced by
+         * two sentinel nodes which branch to themselves, so every tree can
+         * be walked for a fixed number of steps without checking for the end
+         * or for out-of-bounds indices; compile() refuses trees which could
+         * go out of bounds.
+         */
+        struct CompiledForest
+        {
+            struct Node
+            {
+                int32_t featureIdx;
+                float   threshold;
+                int32_t next[2]; // Next pool index if val <= threshold, and if not
+            };
+
+            static constexpr int32_t FalseNode = 0;
+            static constexpr int32_t TrueNode  = 1;
+
+            /// Number of trees predicted together by predictBlock().
+            static constexpr size_t BlockSize = 8;
+
+            std::vector<Node>     nodes;
+            std::vector<uint32_t> roots; //< Pool index of each tree's root.
+            std::vector<uint32_t> depths; //< Steps from each tree's root to a result.
+
+            size_t size() const
+            {
+                return roots.size();
+            }
+
+            void clear()
+            {
+                nodes.clear();
+                roots.clear();
+                depths.clear();
+            }
+
+            /**
+             * Flattens `trees`, whose keys have `featureCount` features.
+             * Leaves the pool empty and returns false if any tree can't be
+             * walked safely: it is empty, or a node reachable from its root
+             * has an out-of-range feature or a child that doesn't come after
+             * it in the tree.
+             */
+            template <typename Tree>
+            bool compile(std::vector<Tree> const& trees, size_t featureCount)
+            {
+                clear();
+
+                nodes.push_back(Node{0, 0.0f, {FalseNode, FalseNode}});
+                nodes.push_back(Node{0, 0.0f, {TrueNode, TrueNode}});
+
+                for(auto const& tree : trees)
+                {
+                    if(!compileTree(tree.tree, featureCount))
+                    {
+                        clear();
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <typename Key>
+            bool predict(size_t tree, Key const& key) const
+            {
+                int32_t nodeIdx = roots[tree];
+                for(uint32_t step = 0; step < depths[tree]; step++)
+                {
+                    Node const& node = nodes[nodeIdx];
+                    nodeIdx          = node.next[!(key[node.featureIdx] <= node.threshold)];
+                }
+
+                return nodeIdx == TrueNode;
+            }
+
+            /**
+             * Predicts up to BlockSize trees starting at `first` in lockstep,
+             * which overlaps their memory accesses.  Bit `i` of the result is
+             * the prediction of tree `first + i`.
+             */
+            template <typename Key>
+            uint32_t predictBlock(size_t first, size_t count, Key const& key) const
+            {
+                int32_t  nodeIdx[BlockSize];
+                uint32_t depth = 0;
+
+                for(size_t i = 0; i < count; i++)
+                {
+                    nodeIdx[i] = roots[first + i];
+                    depth      = std::max(depth, depths[first + i]);
+                }
+
+                for(uint32_t step = 0; step < depth; step++)
+                {
+                    for(size_t i = 0; i < count; i++)
+                    {
+                        Node const& node = nodes[nodeIdx[i]];
+                        nodeIdx[i]       = node.next[!(key[node.featureIdx] <= node.threshold)];
+                    }
+                }
+
+                uint32_t result = 0;
+                for(size_t i = 0; i < count; i++)
+                    result |= uint32_t(nodeIdx[i] == TrueNode) << i;
+
+                return result;
+            }
+
+        private:
+            bool compileTree(std::vector<DecisionTree::Node> const& tree, size_t featureCount)
+            {
+                int32_t treeSize = tree.size();
+                if(tree.empty()
+                   || nodes.size() + tree.size() > size_t(std::numeric_limits<int32_t>::max()))
+                    return false;
+
+                // Pool index of each tree node, once it has been placed.
+                std::vector<int32_t> placed(tree.size(), -1);
+                std::vector<int32_t> queue{0};
+
+                int32_t  base  = nodes.size();
+                uint32_t depth = 0;
+
+                placed[0] = base;
+                for(size_t pos = 0; pos < queue.size(); pos++)
+                {
+                    int32_t nodeIdx = queue[pos];
+                    auto    node    = tree[nodeIdx];
+
+                    if(node.featureIdx < 0 || size_t(node.featureIdx) >= featureCount)
+                        return false;
+
+                    Node compiled{node.featureIdx, node.threshold, {}};
+
+                    int32_t children[2] = {node.nextIdxLTE, node.nextIdxGT};
+                    for(int side = 0; side < 2; side++)
+                    {
+                        int32_t child = children[side];
+                        if(child == IDX_RETURN_FALSE)
+                        {
+                            compiled.next[side] = FalseNode;
+                        }
+                        else if(child == IDX_RETURN_TRUE)
+                        {
+                            compiled.next[side] = TrueNode;
+                        }
+                        else
+                        {
+                            // Children must come later, so no walk can loop.
+                            if(child <= nodeIdx || child >= treeSize)
+                                return false;
+
+                            if(placed[child] < 0)
+                            {
+                                placed[child] = base + queue.size();
+                                queue.push_back(child);
+                            }
+
+                            compiled.next[side] = placed[child];
+                        }
+                    }
+
+                    nodes.push_back(compiled);
+                }
+
+                // Longest path to a result.  Children come after their
+                // parents, so one pass in index order sees every parent of a
+                // node before the node itself.
+                std::vector<uint32_t> longest(tree.size(), 0);
+                for(int32_t nodeIdx = 0; nodeIdx < treeSize; nodeIdx++)
+                {
+                    if(placed[nodeIdx] < 0)
+                        continue;
+
+                    auto const& node = tree[nodeIdx];
+                    depth            = std::max(depth, longest[nodeIdx] + 1);
+                    for(int32_t child : {node.nextIdxLTE, node.nextIdxGT})
+                        if(child >= 0)
+                            longest[child] = std::max(longest[child], longest[nodeIdx] + 1);
+                }
+
+                roots.push_back(base);
+                depths.push_back(depth);
+
+                return true;
+            }
+        };
+
         /**
          * @brief Abstract base class for a group of decision trees
          *
@@ -230,6 +427,34 @@ namespace Tensile
 
             virtual ReturnValue findBestMatch(Object const& problem, Transform transform) const = 0;
 
+            /**
+             * Transform over a group of problems: stores the result for
+             * `problems[i]` in `results[i]` for each `i` in the group.
+             */
+            using BatchTransform = std::function<void(
+                Value, std::vector<size_t> const&, std::vector<ReturnValue>&)>;
+
+            /**
+             * Batched form of findBestMatch().  For each `i` in `indices`,
+             * stores in `results[i]` what findBestMatch(problems[i], ...)
+             * would return.  By default each problem is searched on its own.
+             */
+            virtual void findBestMatches(std::vector<Object> const& problems,
+                                         std::vector<size_t> const& indices,
+                                         BatchTransform const&      transform,
+                                         std::vector<ReturnValue>&  results) const
+            {
+                std::vector<size_t> group(1);
+                for(size_t i : indices)
+                {
+                    group[0]   = i;
+                    results[i] = findBestMatch(problems[i], [&](Value value) {
+                        transform(value, group, results);
+                        return results[i];
+                    });
+                }
+            }
+
             virtual std::set<ReturnValue> matchesInOrder(Object const& problem,
                                                          Transform     transform) const = 0;
 
@@ -249,10 +474,11 @@ namespace Tensile
         template <typename Key, typename Object, typename Value, typename ReturnValue>
         struct BasicForest : public Forest<Object, Value, ReturnValue>
         {
-            using Base      = Forest<Object, Value, ReturnValue>;
-            using Tree      = Tree<Key, Value, ReturnValue>;
-            using Transform = typename Base::Transform;
-            using Features  = typename Base::Features;
+            using Base           = Forest<Object, Value, ReturnValue>;
+            using Tree           = Tree<Key, Value, ReturnValue>;
+            using Transform      = typename Base::Transform;
+            using BatchTransform = typename Base::BatchTransform;
+            using Features       = typename Base::Features;
 
             BasicForest() {}
 
@@ -268,6 +494,9 @@ namespace Tensile
 
                 Key key = ProblemKey::keyForProblem<Key, Object, float>(problem, this->features);
 
+                if(!debug && compiled.size() == trees.size())
+                    return findCompiledMatch(key, transform);
+
                 if(debug)
                 {
                     std::cout << "Forest " << this->description() << std::endl;
@@ -331,6 +560,113 @@ namespace Tensile
                 return transform(nullValue);
             }
 
+            /**
+             * Same result as the loop in findBestMatch(), from the compiled
+             * trees.  Each tree's solution is only looked up once it has
+             * predicted true.
+             */
+            ReturnValue findCompiledMatch(Key const& key, Transform const& transform) const
+            {
+                size_t const blockSize = CompiledForest::BlockSize;
+
+                for(size_t first = 0; first < trees.size(); first += blockSize)
+                {
+                    size_t   count  = std::min(blockSize, trees.size() - first);
+                    uint32_t result = compiled.predictBlock(first, count, key);
+
+                    for(size_t i = 0; result != 0; i++, result >>= 1)
+                    {
+                        if(result & 1)
+                        {
+                            ReturnValue rv = trees[first + i].getSolution(transform);
+                            if(rv != nullptr)
+                                return rv;
+                        }
+                    }
+                }
+
+                return transform(nullValue);
+            }
+
+            /**
+             * Walks the compiled trees once for the whole batch.  Each tree's
+             * value is transformed once, for every problem still waiting
+             * that the tree predicts true for, so a problem ends on the same
+             * tree as in findCompiledMatch().
+             */
+            virtual void findBestMatches(std::vector<Object> const& problems,
+                                         std::vector<size_t> const& indices,
+                                         BatchTransform const&      transform,
+                                         std::vector<ReturnValue>&  results) const override
+            {
+                if(Debug::Instance().getSolutionSelectionTrace()
+                   || compiled.size() != trees.size())
+                    return Base::findBestMatches(problems, indices, transform, results);
+
+                std::vector<size_t> pending = indices;
+                std::vector<Key>    keys;
+                keys.reserve(pending.size());
+                for(size_t i : pending)
+                    keys.push_back(
+                        ProblemKey::keyForProblem<Key, Object, float>(problems[i], this->features));
+
+                size_t const          blockSize = CompiledForest::BlockSize;
+                std::vector<uint32_t> predicted;
+                std::vector<size_t>   group;
+
+                for(size_t first = 0; first < trees.size() && !pending.empty(); first += blockSize)
+                {
+                    size_t count = std::min(blockSize, trees.size() - first);
+
+                    predicted.resize(pending.size());
+                    for(size_t p = 0; p < pending.size(); p++)
+                        predicted[p] = compiled.predictBlock(first, count, keys[p]);
+
+                    for(size_t t = 0; t < count && !pending.empty(); t++)
+                    {
+                        uint32_t const bit = uint32_t(1) << t;
+
+                        group.clear();
+                        for(size_t p = 0; p < pending.size(); p++)
+                            if(predicted[p] & bit)
+                                group.push_back(pending[p]);
+
+                        if(group.empty())
+                            continue;
+
+                        transform(trees[first + t].value, group, results);
+
+                        // Keep the problems the tree's value had no solution for.
+                        size_t kept = 0;
+                        for(size_t p = 0; p < pending.size(); p++)
+                        {
+                            if((predicted[p] & bit) && results[pending[p]] != nullptr)
+                                continue;
+
+                            pending[kept]   = pending[p];
+                            keys[kept]      = std::move(keys[p]);
+                            predicted[kept] = predicted[p];
+                            kept++;
+                        }
+                        pending.resize(kept);
+                        keys.resize(kept);
+                        predicted.resize(kept);
+                    }
+                }
+
+                if(!pending.empty())
+                    transform(nullValue, pending, results);
+            }
+
+            /**
+             * Builds `compiled` from `trees`.  Must be called again if
+             * `trees` changes; until then, the trees are walked one by one.
+             */
+            bool compile()
+            {
+                return compiled.compile(trees, this->features.size());
+            }
+
             virtual std::set<ReturnValue> matchesInOrder(Object const& problem,
                                                          Transform     transform) const override
             {
@@ -351,6 +687,7 @@ namespace Tensile
 
             std::vector<Tree> trees;
             Value             nullValue;
+            CompiledForest    compiled;
         };
     } // namespace DecisionTree
 } // namespace Tensile
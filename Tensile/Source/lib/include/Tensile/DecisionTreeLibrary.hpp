@@ -72,12 +72,43 @@ namespace Tensile
                                                              Hardware const&  hardware,
                                                              double*          fitness
                                                              = nullptr) const override
+        {
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
         {
             typename Forest::Transform transform
                 = [&](Element library) -> std::shared_ptr<MySolution> {
-                return library->findBestSolution(problem, hardware);
+                return library->findBestSolution(view, hardware);
             };
-            return forest->findBestMatch(problem, transform);
+            return forest->findBestMatch(view.problem(), transform);
+        }
+
+        /**
+         * Searches the forest once for the whole batch and hands each tree's
+         * library the problems that reach it as one batch.
+         */
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>& fitness) const override
+        {
+            // As in findBestSolution(), the fitness of a tree's library is not reported.
+            std::vector<double> treeFitness(problems.size());
+
+            typename Forest::BatchTransform transform
+                = [&](Element                                   library,
+                      std::vector<size_t> const&                group,
+                      std::vector<std::shared_ptr<MySolution>>& results) {
+                      library->findBestSolutions(problems, group, hardware, results, treeFitness);
+                  };
+            forest->findBestMatches(problems, indices, transform, solutions);
         }
 
         virtual SolutionSet<MySolution> findAllSolutions(MyProblem const& problem,
@@ -27,6 +27,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <limits>
 
 namespace Tensile
 {
@@ -62,6 +64,26 @@ namespace Tensile
  *
  * If that doesn't apply to the given distance metric, returning `true` will
  * give the correct result.
+ *
+ * Distance functions with `HasColumns` set also implement
+ *
+ *      static void columnDistances(double const* key, size_t dims,
+ * double const* columns, size_t stride, size_t count, double* out,
+ * double* bounds)
+ *
+ * Stores in `out` the distances from `key` to `count` rows whose keys are
+ * stored column by column, column `d` starting at `columns + d * stride`.
+ * Must give exactly the same values as operator().  Stores in `bounds` a
+ * value such that `improvementPossible(key, row, 0, bestDistance)` is
+ * `bounds[r] < bestDistance || out[r] == 0`.
+ *
+ * Distance functions with `Separable` set are a sum over the dimensions of
+ *
+ *      static double dimensionDistance(double difference)
+ *
+ * applied to `p1[i] - p2[i]`, which never decreases as the magnitude of
+ * `difference` grows.  This lets a spatial index bound the distance to a
+ * region of key space.
  */
         template <typename Key>
         class Distance
@@ -77,8 +99,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = false,
+                Separable  = false
             };
             static std::string Type()
             {
@@ -107,8 +131,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = true,
+                Separable  = false
             };
             static std::string Type()
             {
@@ -130,6 +156,30 @@ namespace Tensile
                 return distance;
             }
 
+            static void columnDistances(double const* key,
+                                        size_t        dims,
+                                        double const* columns,
+                                        size_t        stride,
+                                        size_t        count,
+                                        double*       out,
+                                        double*       bounds)
+            {
+                // Every row has to be considered.
+                for(size_t r = 0; r < count; r++)
+                {
+                    out[r]    = 1.0;
+                    bounds[r] = -std::numeric_limits<double>::infinity();
+                }
+
+                for(size_t d = 0; d < dims; d++)
+                {
+                    double const  k   = key[d];
+                    double const* col = columns + d * stride;
+                    for(size_t r = 0; r < count; r++)
+                        out[r] += std::abs(std::log(k / col[r]));
+                }
+            }
+
             inline bool improvementPossible(Key const& p1,
                                             Key const& p2,
                                             size_t     idx,
@@ -144,8 +194,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = true,
+                Separable  = true
             };
             static std::string Type()
             {
@@ -166,6 +218,34 @@ namespace Tensile
                 return distance;
             }
 
+            static double dimensionDistance(double difference)
+            {
+                return std::abs(difference);
+            }
+
+            static void columnDistances(double const* key,
+                                        size_t        dims,
+                                        double const* columns,
+                                        size_t        stride,
+                                        size_t        count,
+                                        double*       out,
+                                        double*       bounds)
+            {
+                for(size_t r = 0; r < count; r++)
+                {
+                    out[r]    = 0.0;
+                    bounds[r] = std::abs(key[0] - columns[r]);
+                }
+
+                for(size_t d = 0; d < dims; d++)
+                {
+                    double const  k   = key[d];
+                    double const* col = columns + d * stride;
+                    for(size_t r = 0; r < count; r++)
+                        out[r] += std::abs(k - col[r]);
+                }
+            }
+
             inline bool improvementPossible(Key const& p1,
                                             Key const& p2,
                                             size_t     idx,
@@ -181,8 +261,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = true,
+                Separable  = true
             };
 
             static std::string Type()
@@ -206,6 +288,38 @@ namespace Tensile
                 return distance;
             }
 
+            static double dimensionDistance(double difference)
+            {
+                return difference * difference;
+            }
+
+            static void columnDistances(double const* key,
+                                        size_t        dims,
+                                        double const* columns,
+                                        size_t        stride,
+                                        size_t        count,
+                                        double*       out,
+                                        double*       bounds)
+            {
+                for(size_t r = 0; r < count; r++)
+                {
+                    double d0 = key[0] - columns[r];
+                    out[r]    = 0.0;
+                    bounds[r] = d0 * d0;
+                }
+
+                for(size_t d = 0; d < dims; d++)
+                {
+                    double const  k   = key[d];
+                    double const* col = columns + d * stride;
+                    for(size_t r = 0; r < count; r++)
+                    {
+                        double di = k - col[r];
+                        out[r] += di * di;
+                    }
+                }
+            }
+
             inline bool improvementPossible(Key const& p1,
                                             Key const& p2,
                                             size_t     idx,
@@ -221,8 +335,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = false,
+                Separable  = false
             };
 
             static std::string Type()
@@ -308,8 +424,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = false,
+                Separable  = false
             };
 
             static std::string Type()
@@ -340,8 +458,10 @@ namespace Tensile
         {
             enum
             {
-                HasIndex = false,
-                HasValue = false
+                HasIndex   = false,
+                HasValue   = false,
+                HasColumns = false,
+                Separable  = false
             };
 
             static std::string Type()
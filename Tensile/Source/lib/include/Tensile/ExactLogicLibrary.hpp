@@ -30,6 +30,8 @@
 #include <Tensile/Predicates.hpp>
 #include <Tensile/SolutionLibrary.hpp>
 
+#include <deque>
+
 namespace Tensile
 {
     /**
@@ -70,14 +72,23 @@ namespace Tensile
                                                              Hardware const&  hardware,
                                                              double*          fitness
                                                              = nullptr) const override
+        {
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
         {
             std::shared_ptr<MySolution> rv;
 
             for(auto const& row : rows)
             {
-                if(row.first(problem, hardware))
+                if(row.first(view, hardware))
                 {
-                    rv = row.second->findBestSolution(problem, hardware, fitness);
+                    rv = row.second->findBestSolution(view, hardware, fitness);
                     if(rv)
                         return rv;
                 }
@@ -86,14 +97,57 @@ namespace Tensile
             return rv;
         }
 
+        /**
+         * Evaluates each row's predicate once per pending problem and hands
+         * the problems that pass to the row's library as a single batch.
+         * Problems that library can't solve fall through to later rows.  Each
+         * problem has one view, shared by the predicates of every row.
+         */
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>& fitness) const override
+        {
+            std::vector<size_t> pending(indices);
+            std::vector<size_t> matched, unmatched;
+
+            std::deque<typename MyProblem::View> views;
+            for(auto const& problem : problems)
+                views.emplace_back(problem);
+
+            for(auto const& row : rows)
+            {
+                if(pending.empty())
+                    break;
+
+                matched.clear();
+                unmatched.clear();
+                row.first.partition(views, pending, hardware, matched, unmatched);
+
+                if(matched.empty())
+                    continue;
+
+                row.second->findBestSolutions(problems, matched, hardware, solutions, fitness);
+
+                pending.swap(unmatched);
+                for(size_t i : matched)
+                {
+                    if(!solutions[i])
+                        pending.push_back(i);
+                }
+            }
+        }
+
         virtual SolutionSet<MySolution> findAllSolutions(MyProblem const& problem,
                                                          Hardware const&  hardware) const override
         {
             SolutionSet<MySolution> rv;
+            typename MyProblem::View view(problem);
 
             for(auto const& row : rows)
             {
-                if(row.first(problem, hardware))
+                if(row.first(view, hardware))
                 {
                     auto rowSolutions = row.second->findAllSolutions(problem, hardware);
                     rv.insert(rowSolutions.begin(), rowSolutions.end());
@@ -108,10 +162,11 @@ namespace Tensile
                                          Hardware const&  hardware) const override
         {
             SolutionSet<MySolution> rv;
+            typename MyProblem::View view(problem);
 
             for(auto const& row : rows)
             {
-                if(row.first(problem, hardware))
+                if(row.first(view, hardware))
                 {
                     auto rowSolutions = row.second->findAllSolutionsMatchingType(problem, hardware);
                     rv.insert(rowSolutions.begin(), rowSolutions.end());
@@ -150,6 +205,21 @@ namespace Tensile
 
             return (*value)(hardware);
         }
+
+        /**
+         * Hardware predicates don't depend on the problem, so the whole batch
+         * goes one way or the other.
+         */
+        template <typename View>
+        void partition(std::deque<View>&          views,
+                       std::vector<size_t> const& indices,
+                       Hardware const&            hardware,
+                       std::vector<size_t>&       matched,
+                       std::vector<size_t>&       unmatched) const
+        {
+            auto& dest = (*this)(views[indices.front()], hardware) ? matched : unmatched;
+            dest.insert(dest.end(), indices.begin(), indices.end());
+        }
     };
 
     template <typename MyProblem, typename MySolution>
@@ -179,14 +249,21 @@ namespace Tensile
         }
     };
 
+    /**
+     * Selects rows by a predicate on the problem.  Holds the predicate tree,
+     * `value`, and the program compiled from it when it is constructed.  A
+     * value assigned afterwards is evaluated as a tree.
+     */
     template <typename MyProblem>
     struct ProblemPredicate
     {
         std::shared_ptr<Predicates::Predicate<MyProblem>> value;
+        typename MyProblem::Program                       program;
 
         ProblemPredicate() = default;
         ProblemPredicate(std::shared_ptr<Predicates::Predicate<MyProblem>> init)
             : value(init)
+            , program(MyProblem::Program::Compile(init))
         {
         }
 
@@ -202,6 +279,30 @@ namespace Tensile
 
             return (*value)(problem);
         }
+
+        bool operator()(typename MyProblem::View& view, Hardware const& hardware) const
+        {
+            if(Debug::Instance().printPredicateEvaluation()
+               || !program.compiledFrom(value.get()))
+                return (*this)(view.problem(), hardware);
+
+            return program(view);
+        }
+
+        void partition(std::deque<typename MyProblem::View>& views,
+                       std::vector<size_t> const&            indices,
+                       Hardware const&                       hardware,
+                       std::vector<size_t>&                  matched,
+                       std::vector<size_t>&                  unmatched) const
+        {
+            for(size_t i : indices)
+            {
+                if((*this)(views[i], hardware))
+                    matched.push_back(i);
+                else
+                    unmatched.push_back(i);
+            }
+        }
     };
 
     template <typename MyProblem, typename MySolution>
@@ -80,16 +80,29 @@ namespace Tensile
                                                              double*          fitness
                                                              = nullptr) const override
         {
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
+        {
+            using View = typename MyProblem::View;
+
             const bool debug = Debug::Instance().printPropertyEvaluation();
 
+            MyProblem const& problem = view.problem();
+
             std::vector<size_t> key;
-            size_t              M = problem.freeSizeA(0);
+            size_t              M = view.get(View::FreeSizeA0);
             key.push_back(M);
-            size_t N = problem.freeSizeB(0);
+            size_t N = view.get(View::FreeSizeB0);
             key.push_back(N);
-            size_t NumBatches = problem.batchSize(0);
+            size_t NumBatches = view.get(View::BatchSize0);
             key.push_back(NumBatches);
-            size_t K = problem.boundSize(0);
+            size_t K = view.get(View::BoundSize0);
             key.push_back(K);
 
             auto exactMatch = exactMap.find(key);
@@ -108,7 +121,7 @@ namespace Tensile
                     std::cout << std::endl;
                 }
 
-                if((*rv->problemPredicate)(problem) && (*rv->hardwarePredicate)(hardware))
+                if(rv->checkProblemPredicate(view) && (*rv->hardwarePredicate)(hardware))
                 {
                     return rv;
                 }
@@ -133,7 +146,7 @@ namespace Tensile
 
                 if(myPerformance > bestPerformance)
                 {
-                    if((*row.second->problemPredicate)(problem)
+                    if(row.second->checkProblemPredicate(view)
                        && (*row.second->hardwarePredicate)(hardware))
                     {
                         bestPerformance = myPerformance;
@@ -165,7 +178,8 @@ namespace Tensile
         {
             bool debug = Debug::Instance().printPropertyEvaluation();
 
-            SolutionSet<MySolution> rv;
+            SolutionSet<MySolution>  rv;
+            typename MyProblem::View view(problem);
 
             for(auto const& row : solutions)
             {
@@ -174,7 +188,7 @@ namespace Tensile
                     std::cout << row.second->description() << ": ";
                 }
 
-                if((*row.second->problemPredicate)(problem)
+                if(row.second->checkProblemPredicate(view)
                    && (*row.second->hardwarePredicate)(hardware))
                 {
                     rv.insert(row.second);
@@ -38,23 +38,55 @@
 namespace Tensile
 {
 
+    /**
+     * Packs the arguments of one kernel launch.  Without logging, the values
+     * are written to a buffer held inline, so building the arguments of a
+     * typical kernel does not allocate; names are only recorded when
+     * logging.
+     */
     class TENSILE_API KernelArguments
     {
     public:
+        /// Bytes of arguments held without a separate allocation.
+        static constexpr size_t InlineBytes = 1024;
+
         KernelArguments(bool log = true);
         virtual ~KernelArguments();
 
         void reserve(size_t bytes, size_t count);
 
+        /**
+         * Removes all arguments, keeping the storage already allocated so
+         * the object can be refilled for the next launch.
+         */
+        void reset(bool log);
+
+        template <typename T>
+        void append(char const* name, T value);
+
         template <typename T>
         void append(std::string const& name, T value);
 
         template <typename T>
-        void appendUnbound(std::string const& name);
+        void appendUnbound(char const* name);
 
         template <typename T>
         void bind(std::string const& name, T value);
 
+        /**
+         * Offset of the argument `name` within data(), or -1 if there is no
+         * such argument.  Requires logging.
+         */
+        ptrdiff_t offset(std::string const& name) const;
+
+        /**
+         * Replaces the value of the argument appended at `offset`, which
+         * must have the size of T.  Lets the arguments of a call be reused
+         * with some of their values changed.
+         */
+        template <typename T>
+        void overwrite(size_t offset, T value);
+
         bool isFullyBound() const;
 
         void const* data() const;
@@ -106,8 +138,13 @@ namespace Tensile
 
         void alignTo(size_t alignment);
 
+        void resize(size_t bytes);
+
+        uint8_t*       bytes();
+        uint8_t const* bytes() const;
+
         template <typename T>
-        void append(std::string const& name, T value, bool bound);
+        void append(char const* name, T value, bool bound);
 
         template <typename T>
         std::string stringForValue(T value, bool bound);
@@ -117,7 +154,9 @@ namespace Tensile
         template <typename T>
         void writeValue(size_t offset, T value);
 
-        std::vector<uint8_t> m_data;
+        alignas(16) uint8_t  m_inline[InlineBytes];
+        std::vector<uint8_t> m_heap;
+        size_t               m_size = 0;
 
         std::vector<std::string>             m_names;
         std::unordered_map<std::string, Arg> m_argRecords;
@@ -129,13 +168,19 @@ namespace Tensile
     TENSILE_API KernelArguments::const_iterator end(KernelArguments const&);
 
     template <typename T>
-    inline void KernelArguments::append(std::string const& name, T value)
+    inline void KernelArguments::append(char const* name, T value)
     {
         append(name, value, true);
     }
 
     template <typename T>
-    inline void KernelArguments::appendUnbound(std::string const& name)
+    inline void KernelArguments::append(std::string const& name, T value)
+    {
+        append(name.c_str(), value, true);
+    }
+
+    template <typename T>
+    inline void KernelArguments::appendUnbound(char const* name)
     {
         append(name, static_cast<T>(0), false);
     }
@@ -179,6 +224,28 @@ namespace Tensile
         std::get<ArgBound>(record)  = true;
     }
 
+    template <typename T>
+    inline void KernelArguments::overwrite(size_t offset, T value)
+    {
+        if(m_log)
+        {
+            for(auto& record : m_argRecords)
+            {
+                if(std::get<ArgOffset>(record.second) != offset)
+                    continue;
+
+                if(std::get<ArgSize>(record.second) != sizeof(T))
+                    throw std::runtime_error("Size mismatch in overwriting argument "
+                                             + record.first);
+
+                std::get<ArgString>(record.second) = stringForValue(value, true);
+                std::get<ArgBound>(record.second)  = true;
+            }
+        }
+
+        writeValue(offset, value);
+    }
+
     template <typename T>
     inline std::string KernelArguments::stringForValue(T value, bool bound)
     {
@@ -194,11 +261,11 @@ namespace Tensile
     }
 
     template <typename T>
-    inline void KernelArguments::append(std::string const& name, T value, bool bound)
+    inline void KernelArguments::append(char const* name, T value, bool bound)
     {
         alignTo(alignof(T));
 
-        size_t offset = m_data.size();
+        size_t offset = m_size;
         size_t size   = sizeof(T);
 
         if(m_log)
@@ -207,27 +274,52 @@ namespace Tensile
             appendRecord(name, Arg(offset, size, bound, valueString));
         }
 
-        m_data.insert(m_data.end(), sizeof(value), 0);
+        resize(offset + size);
         writeValue(offset, value);
     }
 
     template <typename T>
     inline void KernelArguments::writeValue(size_t offset, T value)
     {
-        if(offset + sizeof(T) > m_data.size())
+        if(offset + sizeof(T) > m_size)
         {
             throw std::runtime_error("Value exceeds allocated bounds.");
         }
 
-        std::memcpy(&m_data[offset], &value, sizeof(T));
+        std::memcpy(bytes() + offset, &value, sizeof(T));
+    }
+
+    inline uint8_t* KernelArguments::bytes()
+    {
+        return m_heap.empty() ? m_inline : m_heap.data();
+    }
+
+    inline uint8_t const* KernelArguments::bytes() const
+    {
+        return m_heap.empty() ? m_inline : m_heap.data();
+    }
+
+    inline void KernelArguments::resize(size_t bytes)
+    {
+        if(!m_heap.empty() || bytes > InlineBytes)
+        {
+            if(m_heap.empty())
+                m_heap.assign(m_inline, m_inline + m_size);
+
+            m_heap.resize(bytes, 0);
+        }
+        else if(bytes > m_size)
+            std::memset(m_inline + m_size, 0, bytes - m_size);
+
+        m_size = bytes;
     }
 
     inline void KernelArguments::alignTo(size_t alignment)
     {
-        size_t extraElements = m_data.size() % alignment;
+        size_t extraElements = m_size % alignment;
         size_t padding       = (alignment - extraElements) % alignment;
 
-        m_data.insert(m_data.end(), padding, 0);
+        resize(m_size + padding);
     }
 
     inline void KernelArguments::appendRecord(std::string const& name, KernelArguments::Arg record)
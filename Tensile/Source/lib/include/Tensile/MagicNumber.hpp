@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Tensile/Macros.hpp>
+
+namespace Tensile
+{
+    /**
+     * \ingroup Utilities
+     *
+     * Magic numbers let a kernel divide by a value known only at launch
+     * time with a multiply and a shift.  The kernel arguments carry one for
+     * each packed size and for the summation loop counts.
+     */
+    struct MagicNumber
+    {
+        uint32_t value = 0;
+        uint32_t shift = 0;
+    };
+
+    /**
+     * Algorithm 1: `value = 2^shift / x + 1` with a shift of 33, or 31 if
+     * that does not fit in 32 bits.  `x` must not be 0.
+     */
+    constexpr MagicNumber MagicNumberAlg1(uint32_t x)
+    {
+        MagicNumber rv;
+        rv.shift       = 33;
+        uint64_t value = (uint64_t(1) << rv.shift) / x + 1;
+        if((value >> 32) != 0)
+        {
+            rv.shift = 31;
+            value    = (uint64_t(1) << rv.shift) / x + 1;
+        }
+
+        rv.value = static_cast<uint32_t>(value);
+        return rv;
+    }
+
+    /**
+     * Algorithm 2: unsigned division by `d` from Hacker's Delight (magicu).
+     * The top bit of the shift is set if the kernel must add the dividend
+     * back in.  A divisor of 0 gives 0 for any dividend.
+     */
+    constexpr MagicNumber MagicNumberAlg2(uint32_t d)
+    {
+        MagicNumber rv;
+        if(d == 0)
+            return rv;
+
+        // Must have 1 <= d <= 2**32-1.
+        bool     add   = false;
+        uint32_t nc    = -1 - (-d) % d;
+        int      p     = 31;
+        uint32_t q1    = 0x80000000 / nc; // 2**p/nc
+        uint32_t r1    = 0x80000000 - q1 * nc; // rem(2**p, nc)
+        uint32_t q2    = 0x7FFFFFFF / d; // (2**p - 1)/d
+        uint32_t r2    = 0x7FFFFFFF - q2 * d; // rem(2**p - 1, d)
+        uint32_t delta = 0;
+        do
+        {
+            p = p + 1;
+            if(r1 >= nc - r1)
+            {
+                q1 = 2 * q1 + 1;
+                r1 = 2 * r1 - nc;
+            }
+            else
+            {
+                q1 = 2 * q1;
+                r1 = 2 * r1;
+            }
+            if(r2 + 1 >= d - r2)
+            {
+                if(q2 >= 0x7FFFFFFF)
+                    add = true;
+                q2 = 2 * q2 + 1;
+                r2 = 2 * r2 + 1 - d;
+            }
+            else
+            {
+                if(q2 >= 0x80000000)
+                    add = true;
+                q2 = 2 * q2;
+                r2 = 2 * r2 + 1;
+            }
+            delta = d - 1 - r2;
+        } while(p < 64 && (q1 < delta || (q1 == delta && r1 == 0)));
+
+        rv.value = q2 + 1;
+        rv.shift = p - 32;
+        if(add)
+            rv.shift |= 0x80000000;
+
+        return rv;
+    }
+
+    /**
+     * The magic number of `x` for `magicDivAlg` (1 or 2).  Divisors below
+     * `MagicNumberTableSize` are read from tables computed at compile time.
+     * Larger divisors for algorithm 2, whose search loop is the expensive
+     * one, go through a small cache of recent divisors kept per thread,
+     * since a run of launches tends to reuse the same few sizes.
+     */
+    TENSILE_API MagicNumber CachedMagicNumber(int magicDivAlg, uint32_t x);
+
+    constexpr size_t MagicNumberTableSize = 4096;
+} // namespace Tensile
@@ -109,12 +109,59 @@ namespace Tensile
                                                              double*          fitness
                                                              = nullptr) const override
         {
-            auto library = lookup(problem, hardware);
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
+        {
+            auto library = lookup(view.problem(), hardware);
 
             if(library == nullptr)
                 return std::shared_ptr<MySolution>();
 
-            return library->findBestSolution(problem, hardware, fitness);
+            return library->findBestSolution(view, hardware, fitness);
+        }
+
+        /**
+         * Computes each problem's key once and forwards one batch per
+         * distinct sub-library.
+         */
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>& fitness) const override
+        {
+            using Library = SolutionLibrary<MyProblem, MySolution>;
+
+            std::vector<std::pair<Library const*, std::vector<size_t>>> groups;
+            std::unordered_map<Library const*, size_t>                  groupIndex;
+
+            for(size_t i : indices)
+            {
+                auto library = lookup(problems[i], hardware);
+                if(library == nullptr)
+                {
+                    solutions[i] = nullptr;
+                    continue;
+                }
+
+                auto iter = groupIndex.find(library.get());
+                if(iter == groupIndex.end())
+                {
+                    iter = groupIndex.emplace(library.get(), groups.size()).first;
+                    groups.emplace_back(library.get(), std::vector<size_t>());
+                }
+
+                groups[iter->second].second.push_back(i);
+            }
+
+            for(auto const& group : groups)
+                group.first->findBestSolutions(problems, group.second, hardware, solutions, fitness);
         }
 
         virtual SolutionSet<MySolution> findAllSolutions(MyProblem const& problem,
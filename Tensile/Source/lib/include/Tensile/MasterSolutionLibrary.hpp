@@ -26,12 +26,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
+#include <Tensile/CachingLibrary.hpp>
 #include <Tensile/Debug.hpp>
+#include <Tensile/SolutionCacheFile.hpp>
 #include <Tensile/SolutionLibrary.hpp>
+#include <Tensile/SolutionMap.hpp>
 #include <Tensile/Tensile.hpp>
 
 namespace Tensile
@@ -39,18 +51,36 @@ namespace Tensile
 
     /**
      * \ingroup SolutionLibrary
+     *
+     * A placeholder library read along with a master library.  The persistent
+     * solution cache refers to it by its position in the master library file.
      */
     template <typename MySolution>
-    using SolutionMap = std::map<int, std::shared_ptr<MySolution>>;
+    struct LazyLibraryFile
+    {
+        std::function<void()>                                          load;
+        std::function<std::string(Hardware const&, MySolution const&)> codeObjectFilename;
+    };
 
     template <typename MySolution>
     struct LibraryIOContext
     {
         std::string                  filename;
         std::vector<LazyLoadingInit> preloaded;
-        // If lazy loading is used, this may be updated in const functions
+        // If lazy loading is used, this may be updated in const functions;
+        // solutionsGuard serializes those inserts.
         SolutionMap<MySolution>* solutions;
         std::mutex*              solutionsGuard;
+        // Set while loading a file referenced by a PlaceholderLibrary.
+        bool lazyLoading = false;
+        // Placeholder libraries to load once the master library is read,
+        // as selected by `preloaded`.
+        std::vector<std::function<void()>> preloads;
+        std::vector<std::function<void()>> backgroundPreloads;
+        // Placeholder libraries read so far, in file order, and where to
+        // record which of them each lazily-loaded solution came from.
+        std::vector<LazyLibraryFile<MySolution>> lazyFiles;
+        std::unordered_map<int, int32_t>*        lazySolutionFiles = nullptr;
     };
 
     /**
@@ -87,19 +117,113 @@ namespace Tensile
         std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> library;
         SolutionMap<MySolution>                                 solutions;
         std::string                                             version;
+        // Serializes inserts into `solutions` by lazy loading; lookups take no lock.
         mutable std::mutex                                      solutionsGuard;
 
+        // File this library was loaded from, used to identify it to the
+        // persistent solution cache.
+        std::string libraryFile;
+        bool        lazyLoading = false;
+
+        // Placeholder libraries read with this library, in file order, and
+        // the position of the one each lazily-loaded solution came from
+        // (guarded by solutionsGuard).  Both are stored in the persistent
+        // solution cache so that a hit can load the solution's library.
+        std::vector<LazyLibraryFile<MySolution>> lazyFiles;
+        std::unordered_map<int, int32_t>         lazySolutionFiles;
+
         MasterSolutionLibrary() = default;
 
+        ~MasterSolutionLibrary()
+        {
+            joinPreload();
+        }
+
+        /// Upper bound on the worker threads started by each call to preload().
+        static constexpr size_t MaxPreloadThreads = 4;
+
+        /**
+         * Runs `tasks`, which load placeholder libraries, on a pool of up to
+         * MaxPreloadThreads worker threads.
+         *
+         * Unless `background` is set, returns once every task has finished
+         * and rethrows the first exception raised by any of them.  Otherwise
+         * returns straight away.  A lookup that reaches a placeholder that is
+         * still being loaded waits for that library only, and one that
+         * reaches a placeholder no worker has started on loads it itself.
+         * The first error in the background is rethrown by waitForPreload();
+         * the placeholder is left unloaded and the error recurs when a lookup
+         * loads it.
+         */
+        void preload(std::vector<std::function<void()>> tasks, bool background)
+        {
+            if(tasks.empty())
+                return;
+
+            auto queue   = std::make_shared<PreloadQueue>();
+            queue->tasks = std::move(tasks);
+
+            size_t threads = std::min(MaxPreloadThreads, queue->tasks.size());
+
+            std::vector<std::thread> workers;
+            for(size_t t = 0; t < threads; t++)
+                workers.emplace_back([queue]() { queue->run(); });
+
+            if(background)
+            {
+                std::lock_guard<std::mutex> guard(m_preloadGuard);
+                for(auto& worker : workers)
+                    m_preloadThreads.push_back(std::move(worker));
+                m_preloadQueues.push_back(queue);
+                return;
+            }
+
+            for(auto& worker : workers)
+                worker.join();
+
+            if(queue->error)
+                std::rethrow_exception(queue->error);
+        }
+
+        /**
+         * Loads the placeholder libraries selected by `context.preloaded`
+         * while this library was read.  Called once reading has succeeded.
+         */
+        void preload(LibraryIOContext<MySolution>& context)
+        {
+            preload(std::move(context.preloads), false);
+            preload(std::move(context.backgroundPreloads), true);
+        }
+
+        /**
+         * Blocks until placeholder libraries loading in the background are
+         * loaded, then rethrows the first exception raised by any of them.
+         */
+        void waitForPreload() const
+        {
+            auto error = joinPreload();
+            if(error)
+                std::rethrow_exception(error);
+        }
+
         virtual std::shared_ptr<MySolution> findBestSolution(MyProblem const& problem,
                                                              Hardware const&  hardware,
                                                              double*          fitness
                                                              = nullptr) const override
+        {
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
         {
             if(Debug::Instance().printSolutionSelectionTime())
             {
                 auto start  = std::chrono::steady_clock::now();
-                auto result = findBestSolution_runner(problem, hardware, fitness);
+                auto result = findBestSolution_runner(view, hardware, fitness);
                 auto end    = std::chrono::steady_clock::now();
 
                 double time = std::chrono::duration<double, std::micro>(end - start).count();
@@ -109,17 +233,19 @@ namespace Tensile
             }
             else
             {
-                return findBestSolution_runner(problem, hardware, fitness);
+                return findBestSolution_runner(view, hardware, fitness);
             }
         }
 
-        std::shared_ptr<MySolution> findBestSolution_runner(MyProblem const& problem,
-                                                            Hardware const&  hardware,
+        std::shared_ptr<MySolution> findBestSolution_runner(typename MyProblem::View& view,
+                                                            Hardware const&           hardware,
                                                             double* fitness = nullptr) const
         {
             const int                   solution_index = Debug::Instance().getSolutionIndex();
             std::shared_ptr<MySolution> rv;
 
+            attachPersistentCache();
+
             if(solution_index >= 0)
             {
                 std::cout << "Tensile will use solution index: " << solution_index << std::endl;
@@ -132,14 +258,14 @@ namespace Tensile
                 {
                     auto selected_solution = getSolutionByIndex(solution_index);
 
-                    if(selected_solution && selected_solution->canSolve(problem, hardware))
+                    if(selected_solution && selected_solution->canSolve(view, hardware))
                         rv = selected_solution;
                     else
                         return nullptr;
                 }
             }
             else
-                rv = library->findBestSolution(problem, hardware, fitness);
+                rv = library->findBestSolution(view, hardware, fitness);
 
             if(Debug::Instance().printLibraryLogicIndex())
             {
@@ -152,15 +278,160 @@ namespace Tensile
             return rv;
         }
 
+        /**
+         * Finds the best solution for each of `problems`.  Problems which
+         * take the same path through the library share predicate evaluation
+         * and key lookups, and are resolved by each sub-library in one call.
+         *
+         * With `threads` > 1 the batch is split into that many contiguous
+         * chunks which are resolved concurrently.
+         *
+         * \param fitness If not null, receives the fitness of each solution.
+         */
+        std::vector<std::shared_ptr<MySolution>>
+            findBestSolutions(std::vector<MyProblem> const& problems,
+                              Hardware const&               hardware,
+                              std::vector<double>*          fitness = nullptr,
+                              size_t                        threads = 1) const
+        {
+            std::vector<std::shared_ptr<MySolution>> solutions(problems.size());
+            std::vector<double> localFitness(problems.size(), std::numeric_limits<double>::max());
+
+            // These debug modes report on each lookup individually.
+            auto const& debug = Debug::Instance();
+            if(debug.getSolutionIndex() >= 0 || debug.printSolutionSelectionTime()
+               || debug.printLibraryLogicIndex())
+            {
+                for(size_t i = 0; i < problems.size(); i++)
+                    solutions[i] = findBestSolution(problems[i], hardware, &localFitness[i]);
+            }
+            else
+            {
+                threads = std::max<size_t>(1, std::min(threads, problems.size()));
+
+                std::vector<std::vector<size_t>> chunks(threads);
+                for(size_t i = 0; i < problems.size(); i++)
+                    chunks[i * threads / problems.size()].push_back(i);
+
+                std::vector<std::thread> workers;
+                for(size_t t = 1; t < threads; t++)
+                    workers.emplace_back([&, t]() {
+                        findBestSolutions(problems, chunks[t], hardware, solutions, localFitness);
+                    });
+
+                findBestSolutions(problems, chunks[0], hardware, solutions, localFitness);
+
+                for(auto& worker : workers)
+                    worker.join();
+            }
+
+            if(fitness)
+                fitness->swap(localFitness);
+
+            return solutions;
+        }
+
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>& fitness) const override
+        {
+            attachPersistentCache();
+
+            library->findBestSolutions(problems, indices, hardware, solutions, fitness);
+        }
+
+        /**
+         * Backs the top-level solution cache with the on-disk cache in
+         * `filename` (TENSILE_SOLUTION_CACHE_FILE).  Called once, from the
+         * first lookup, so that libraries nested inside lazy-loaded files
+         * never attach to (and overwrite) the same file.
+         *
+         * \return false if this library has no solution cache.
+         */
+        bool usePersistentCache(std::string const& filename) const
+        {
+            using Caching = CachingLibrary<MyProblem, MySolution>;
+
+            auto cache = std::dynamic_pointer_cast<Caching>(library);
+            if(!cache)
+                return false;
+
+            // Lazy libraries gain solutions as placeholders load, so they
+            // are identified by their placeholder count instead.
+            size_t count = lazyLoading ? lazyFiles.size() : solutions.size();
+            auto   hash  = SolutionCacheFile::LibraryHash(libraryFile, version, count);
+            auto   file  = std::make_shared<SolutionCacheFile>(filename, hash);
+
+            auto resolve = [this](SolutionCacheFile::Record const& record,
+                                  AMDGPU const& hardware) -> std::shared_ptr<MySolution> {
+                LazyLibraryFile<MySolution> const* lazyFile = nullptr;
+                if(record.placeholder >= 0)
+                {
+                    if(static_cast<size_t>(record.placeholder) >= lazyFiles.size())
+                        return nullptr;
+
+                    lazyFile = &lazyFiles[record.placeholder];
+                    lazyFile->load();
+                }
+
+                auto iter = solutions.find(record.solutionIndex);
+                if(iter == solutions.end())
+                    return nullptr;
+
+                // Solutions from lazily-loaded files only learn their code
+                // object file from their placeholder library.
+                if(lazyFile)
+                    iter->second->codeObjectFilename
+                        = lazyFile->codeObjectFilename(hardware, *iter->second);
+                else if(lazyLoading && iter->second->codeObjectFilename.load().empty())
+                    return nullptr;
+
+                return iter->second;
+            };
+
+            auto locate = [this](MySolution const& solution) -> int32_t {
+                std::lock_guard<std::mutex> guard(solutionsGuard);
+                auto iter = lazySolutionFiles.find(solution.index);
+                return iter == lazySolutionFiles.end() ? -1 : iter->second;
+            };
+
+            cache->setPersistentCache(file, resolve, locate);
+
+            if(Debug::Instance().printLibraryVersion())
+                std::cout << "Solution cache file: " << filename << " (" << file->size()
+                          << " entries)" << std::endl;
+
+            return true;
+        }
+
+        /**
+         * Writes the selections made so far to the persistent solution cache
+         * file, if one is attached and anything was selected since it was
+         * last written.  Nothing is written automatically; owners call this
+         * at a point of their choosing, such as before exiting.
+         *
+         * \return false if the file could not be written.
+         */
+        bool savePersistentCache() const
+        {
+            auto cache = std::dynamic_pointer_cast<CachingLibrary<MyProblem, MySolution>>(library);
+            if(!cache || !cache->persistentCache() || !cache->persistentCacheDirty())
+                return true;
+
+            return cache->savePersistentCache();
+        }
+
         std::shared_ptr<MySolution> getSolutionByIndex(int index) const
         {
             bool debug = Debug::Instance().printSelectedKernelName();
 
             // will only return solution if already loaded; does not load solutions
-            std::lock_guard<std::mutex> guard(solutionsGuard);
-            if(solutions.find(index) != solutions.end())
+            auto iter = solutions.find(index);
+            if(iter != solutions.end())
             {
-                std::shared_ptr<MySolution> solution = solutions.at(index);
+                std::shared_ptr<MySolution> solution = iter->second;
                 if(debug)
                 {
                     std::cout << "Selection solution with index: " << index << " and name: '"
@@ -191,6 +462,66 @@ namespace Tensile
         {
             return library->findAllSolutionsMatchingType(problem, hardware);
         }
+
+    private:
+        struct PreloadQueue
+        {
+            std::vector<std::function<void()>> tasks;
+            std::atomic<size_t>                next{0};
+            std::mutex                         errorGuard;
+            std::exception_ptr                 error;
+
+            void run()
+            {
+                for(size_t i = next++; i < tasks.size(); i = next++)
+                {
+                    try
+                    {
+                        tasks[i]();
+                    }
+                    catch(...)
+                    {
+                        std::lock_guard<std::mutex> guard(errorGuard);
+                        if(!error)
+                            error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        std::exception_ptr joinPreload() const
+        {
+            std::vector<std::thread>                   threads;
+            std::vector<std::shared_ptr<PreloadQueue>> queues;
+            {
+                std::lock_guard<std::mutex> guard(m_preloadGuard);
+                threads.swap(m_preloadThreads);
+                queues.swap(m_preloadQueues);
+            }
+
+            for(auto& thread : threads)
+                thread.join();
+
+            for(auto const& queue : queues)
+                if(queue->error)
+                    return queue->error;
+
+            return nullptr;
+        }
+
+        void attachPersistentCache() const
+        {
+            std::call_once(m_persistentCacheOnce, [this]() {
+                auto const& filename = Debug::Instance().solutionCacheFile();
+                if(!filename.empty())
+                    usePersistentCache(filename);
+            });
+        }
+
+        mutable std::once_flag                             m_persistentCacheOnce;
+        mutable std::mutex                                 m_preloadGuard;
+        mutable std::vector<std::thread>                   m_preloadThreads;
+        mutable std::vector<std::shared_ptr<PreloadQueue>> m_preloadQueues;
     };
 
 } // namespace Tensile
@@ -68,18 +68,27 @@ namespace Tensile
                                                              Hardware const&  hardware,
                                                              double*          fitness
                                                              = nullptr) const override
+        {
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
         {
             bool useDebugSelection = Debug::Instance().enableDebugSelection();
 
             typename Table::Transform transform
                 = [&](Element library) -> std::shared_ptr<MySolution> {
-                return library->findBestSolution(problem, hardware);
+                return library->findBestSolution(view, hardware);
             };
 
             if(useDebugSelection)
             {
                 std::shared_ptr<MySolution> evaluationSolution
-                    = table->findBestEvaluationSolution(problem, hardware, transform);
+                    = table->findBestEvaluationSolution(view.problem(), hardware, transform);
                 return evaluationSolution;
             }
             else
@@ -87,7 +96,7 @@ namespace Tensile
                 double localFitness = std::numeric_limits<double>::max();
                 fitness             = (fitness) ? fitness : &localFitness;
                 std::shared_ptr<MySolution> solution;
-                std::tie(solution, *fitness) = table->findBestMatch(problem, transform);
+                std::tie(solution, *fitness) = table->findBestMatch(view, transform);
                 return solution;
             }
         }
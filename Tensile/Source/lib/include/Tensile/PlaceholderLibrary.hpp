@@ -31,6 +31,8 @@
 #include <Tensile/Tensile.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <unordered_map>
 
 namespace Tensile
 {
@@ -38,7 +40,11 @@ namespace Tensile
     // To be extended in the future
     enum class LazyLoadingInit
     {
-        All
+        // Loaded in parallel before the master library is returned.
+        All,
+        // Loaded in parallel in the background; the master library is
+        // returned straight away.
+        AllBackground
     };
 
     //Regex patterns for initializing libraries on startup
@@ -47,6 +53,7 @@ namespace Tensile
         switch(condition)
         {
         case LazyLoadingInit::All:
+        case LazyLoadingInit::AllBackground:
             return "TensileLibrary_.*";
         }
 
@@ -60,9 +67,15 @@ namespace Tensile
         mutable SolutionMap<MySolution>*                                masterSolutions;
         mutable std::mutex*                                             solutionsGuard;
         mutable std::mutex                                              lazyLoadingGuard;
+        // Set once `library` may be read without holding lazyLoadingGuard.
+        mutable std::atomic<bool> loaded{false};
         std::string                                                     filePrefix;
         std::string                                                     suffix;
         std::string                                                     libraryDirectory;
+        // Where to record that this library's solutions come from it, as
+        // its position `fileIndex` in the master library.
+        mutable std::unordered_map<int, int32_t>* masterSolutionFiles = nullptr;
+        int32_t                                   fileIndex           = -1;
 
         PlaceholderLibrary() = default;
 
@@ -70,15 +83,25 @@ namespace Tensile
         {
             std::lock_guard<std::mutex> lock(lazyLoadingGuard);
             // If condition in case two threads got into this function
-            if(!library)
+            if(!loaded.load(std::memory_order_relaxed))
             {
                 auto newLibrary = LoadLibraryFile<MyProblem, MySolution>(
                     (libraryDirectory + "/" + filePrefix + suffix).c_str());
                 auto mLibrary
                     = static_cast<MasterSolutionLibrary<MyProblem, MySolution>*>(newLibrary.get());
+                if(!mLibrary)
+                    throw std::runtime_error(concatenate("Failed to load library ", filePrefix));
+
                 library = mLibrary->library;
-                std::lock_guard<std::mutex> lock(*solutionsGuard);
-                masterSolutions->insert(mLibrary->solutions.begin(), mLibrary->solutions.end());
+                {
+                    std::lock_guard<std::mutex> lock(*solutionsGuard);
+                    masterSolutions->insert(mLibrary->solutions.begin(),
+                                            mLibrary->solutions.end());
+                    if(masterSolutionFiles)
+                        for(auto const& pair : mLibrary->solutions)
+                            (*masterSolutionFiles)[pair.first] = fileIndex;
+                }
+                loaded.store(true, std::memory_order_release);
 
                 return mLibrary;
             }
@@ -115,10 +138,19 @@ namespace Tensile
                                                              double*          fitness
                                                              = nullptr) const override
         {
-            if(!library)
+            typename MyProblem::View view(problem);
+            return findBestSolution(view, hardware, fitness);
+        }
+
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
+        {
+            if(!loaded.load(std::memory_order_acquire))
                 loadPlaceholderLibrary();
 
-            auto solution = library->findBestSolution(problem, hardware, fitness);
+            auto solution = library->findBestSolution(view, hardware, fitness);
 
             if(solution)
                 solution->codeObjectFilename = getCodeObjectFileName(hardware, *solution);
@@ -126,6 +158,25 @@ namespace Tensile
             return solution;
         }
 
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>& fitness) const override
+        {
+            if(!loaded.load(std::memory_order_acquire))
+                loadPlaceholderLibrary();
+
+            library->findBestSolutions(problems, indices, hardware, solutions, fitness);
+
+            for(size_t i : indices)
+            {
+                if(solutions[i])
+                    solutions[i]->codeObjectFilename
+                        = getCodeObjectFileName(hardware, *solutions[i]);
+            }
+        }
+
         /**
          * Returns all `Solution` objects that are capable of correctly solving this
          * `problem` on this `hardware`.
@@ -135,7 +186,7 @@ namespace Tensile
         virtual SolutionSet<MySolution> findAllSolutions(MyProblem const& problem,
                                                          Hardware const&  hardware) const override
         {
-            if(!library)
+            if(!loaded.load(std::memory_order_acquire))
             {
                 loadPlaceholderLibrary();
             }
@@ -154,7 +205,7 @@ namespace Tensile
             findAllSolutionsMatchingType(MyProblem const& problem,
                                          Hardware const&  hardware) const override
         {
-            if(!library)
+            if(!loaded.load(std::memory_order_acquire))
             {
                 loadPlaceholderLibrary();
             }
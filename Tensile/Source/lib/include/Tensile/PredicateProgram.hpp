@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Tensile/ContractionProblemView.hpp>
+#include <Tensile/ContractionProblem_fwd.hpp>
+#include <Tensile/Macros.hpp>
+#include <Tensile/Predicates.hpp>
+
+namespace Tensile
+{
+    namespace Predicates
+    {
+        namespace Contraction
+        {
+            /**
+             * \ingroup Predicates
+             *
+             * A ContractionProblem predicate lowered into a flat list of checks.
+             *
+             * And/Or/Not are resolved at compile time into the two successors of
+             * each check, so evaluation walks forward through one array without
+             * virtual calls or shared_ptr dereferences.  The values each check
+             * reads come from a ContractionProblemView.  Predicates with no
+             * compiled form become a check that calls the original object.
+             */
+            class TENSILE_API Program
+            {
+            public:
+                Program() = default;
+
+                /**
+                 * Compiles `predicate`.  The program keeps a reference to it
+                 * and to the predicates it calls, so `compiledFrom()` can't be
+                 * fooled by another predicate allocated at the same address.
+                 */
+                static Program
+                    Compile(std::shared_ptr<Predicate<ContractionProblem>> const& predicate);
+
+                /// True if this program was compiled from `predicate`.
+                bool compiledFrom(Predicate<ContractionProblem> const* predicate) const
+                {
+                    return predicate != nullptr && m_source.get() == predicate;
+                }
+
+                bool operator()(ContractionProblemView& view) const;
+
+                /// Number of checks.
+                size_t size() const
+                {
+                    return m_checks.size();
+                }
+
+                /// Number of checks that call a predicate object.
+                size_t callCount() const
+                {
+                    return m_calls.size();
+                }
+
+            private:
+                // `value` and `value2` name view values; `a` and `b` are constants.
+                enum class Op : uint8_t
+                {
+                    Equal, // value == a
+                    Greater, // value > a
+                    GreaterEqual, // value >= a
+                    Less, // value < a
+                    InRange, // a <= value < b
+                    Multiple, // value % a == 0
+                    EqualOrAny, // value == a || value == b
+                    EqualValues, // value == value2
+                    OffsetBelow4G, // (value * a + b) * value2 < 2^32
+                    ScaledAtMost, // value * a <= value2
+                    OperationIdentifier, // problem.operationId() == a
+                    Call // (*m_calls[a])(problem)
+                };
+
+                static constexpr int32_t Accept = -1;
+                static constexpr int32_t Reject = -2;
+
+                // next[0] is the successor if the check fails, next[1] if it passes.
+                struct Check
+                {
+                    Op       op;
+                    uint8_t  value;
+                    uint8_t  value2;
+                    int32_t  next[2];
+                    uint64_t a;
+                    uint64_t b;
+                };
+
+                struct Compiler;
+
+                int32_t                                                     m_entry = Accept;
+                std::vector<Check>                                          m_checks;
+                std::vector<std::shared_ptr<Predicate<ContractionProblem>>> m_calls;
+                std::shared_ptr<Predicate<ContractionProblem>>              m_source;
+            };
+        } // namespace Contraction
+    } // namespace Predicates
+} // namespace Tensile
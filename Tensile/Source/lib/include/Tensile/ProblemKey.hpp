@@ -81,5 +81,34 @@ namespace Tensile
 
             return myKey;
         }
+
+        /**
+         * Same as above, reading each property that has a value in `view`
+         * (`values[i]` >= 0) from the view.
+         */
+        template <typename Key, typename Problem, typename Value = size_t>
+        Key keyForProblem(typename Problem::View&                                      view,
+                          std::vector<std::shared_ptr<Property<Problem, Value>>> const& properties,
+                          std::vector<int> const&                                       values)
+        {
+            if(values.size() != properties.size())
+                return keyForProblem<Key, Problem, Value>(view.problem(), properties);
+
+            bool debug = Debug::Instance().printPropertyEvaluation();
+
+            Key myKey = ProblemKey::KeyFactory<Key>::MakeKey(properties.size());
+
+            for(int i = 0; i < properties.size(); i++)
+                myKey[i] = values[i] >= 0 ? view.get(values[i]) : (*properties[i])(view.problem());
+
+            if(debug)
+            {
+                std::cout << "Object key: ";
+                streamJoin(std::cout, myKey, ", ");
+                std::cout << std::endl;
+            }
+
+            return myKey;
+        }
     }
 }
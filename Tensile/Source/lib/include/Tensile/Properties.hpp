@@ -27,7 +27,9 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <Tensile/Utils.hpp>
 
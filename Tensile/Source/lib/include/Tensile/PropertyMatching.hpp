@@ -26,10 +26,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <numeric>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include <Tensile/Debug.hpp>
@@ -64,6 +68,59 @@ namespace Tensile
             double speed;
         };
 
+        /**
+         * Structure-of-arrays copy of a matching table's keys and speeds.
+         * Each key dimension is a contiguous column of doubles, so the
+         * distances to a block of rows are a few loops over plain arrays that
+         * the compiler can vectorize.
+         */
+        struct KeyColumns
+        {
+            size_t              rows = 0;
+            size_t              dims = 0;
+            std::vector<double> values; //< `dims` columns of `rows` values each.
+            std::vector<double> speeds;
+
+            double const* column(size_t dim) const
+            {
+                return values.data() + dim * rows;
+            }
+
+            /**
+             * Copies the keys and speeds of `table`.  Left empty if the keys
+             * don't all have the same number of dimensions.
+             */
+            template <typename Entry>
+            void assign(std::vector<Entry> const& table)
+            {
+                rows = 0;
+                dims = 0;
+                values.clear();
+                speeds.clear();
+
+                if(table.empty())
+                    return;
+
+                size_t width = table.front().key.size();
+                for(auto const& entry : table)
+                    if(entry.key.size() != width)
+                        return;
+
+                values.resize(width * table.size());
+                speeds.resize(table.size());
+
+                for(size_t row = 0; row < table.size(); row++)
+                {
+                    for(size_t dim = 0; dim < width; dim++)
+                        values[dim * table.size() + row] = table[row].key[dim];
+                    speeds[row] = table[row].speed;
+                }
+
+                rows = table.size();
+                dims = width;
+            }
+        };
+
         template <typename Object, typename Value, typename ReturnValue>
         struct MatchingTable
         {
@@ -81,6 +138,16 @@ namespace Tensile
             virtual std::tuple<ReturnValue, double> findBestMatch(Object const& object,
                                                                   Transform transform) const = 0;
 
+            /**
+             * Same as above, reading the key properties from `view` where it
+             * has them.
+             */
+            virtual std::tuple<ReturnValue, double>
+                findBestMatch(typename Object::View& view, Transform transform) const
+            {
+                return findBestMatch(view.problem(), transform);
+            }
+
             virtual ReturnValue findBestEvaluationSolution(Object const&   object,
                                                            Hardware const& hardware,
                                                            Transform       transform) const = 0;
@@ -91,7 +158,21 @@ namespace Tensile
 
             virtual std::string distanceType() const = 0;
 
+            /**
+             * Looks up the view value read by each property.  Must be called
+             * again whenever `properties` changes.
+             */
+            void resolvePropertyValues()
+            {
+                propertyValues.clear();
+                for(auto const& property : properties)
+                    propertyValues.push_back(Object::View::PropertyValue(*property));
+            }
+
             Properties properties;
+
+            /// View value read by each property, or -1 if it has none.
+            std::vector<int> propertyValues;
         };
 
         /**
@@ -141,6 +222,14 @@ namespace Tensile
                     ProblemKey::keyForProblem<Key, Object>(object, this->properties), transform);
             }
 
+            virtual std::tuple<ReturnValue, double>
+                findBestMatch(typename Object::View& view, Transform transform) const override
+            {
+                return findBestKeyMatch(ProblemKey::keyForProblem<Key, Object>(
+                                            view, this->properties, this->propertyValues),
+                                        transform);
+            }
+
             virtual ReturnValue findBestEvaluationSolution(Object const&   object,
                                                            Hardware const& hardware,
                                                            Transform       transform) const override
@@ -249,7 +338,7 @@ namespace Tensile
                 std::string rv = concatenate(
                     "Table: Properties: ", this->properties, ", ", table.size(), " row(s), ");
 
-                rv += concatenate("Distance: ", Distance::Type());
+                rv += concatenate("Distance: ", this->distanceType());
 
                 return rv;
             }
@@ -259,8 +348,21 @@ namespace Tensile
                 return Distance::Type();
             }
 
+            /**
+             * Builds the column copy of `table` used by the non-debug search,
+             * for distance functions which support it.  Must be called again
+             * if `table` changes; until then, a table whose size no longer
+             * matches is searched row by row.
+             */
+            void buildColumns()
+            {
+                if(Distance::HasColumns)
+                    columns.assign(table);
+            }
+
             std::vector<Entry> table;
             Distance           distance;
+            KeyColumns         columns;
 
             ReturnValue nullValue;
         };
@@ -281,6 +383,7 @@ namespace Tensile
             using Transform  = typename Base::Transform;
             using Properties = typename Base::Properties;
             using Common     = DistanceMatchingCommon<Key, Object, Value, ReturnValue, Distance>;
+            using Common::columns;
             using Common::distance;
             using Common::nullValue;
             using Common::table;
@@ -320,11 +423,167 @@ namespace Tensile
                 {
                     if(debug)
                         return findBestKeyMatch_BinSearch<true>(key, transform);
+                    else if(columns.rows == table.size() && columns.dims <= MaxColumnDims)
+                        return findBestKeyMatch_Columns(
+                            key, transform, std::integral_constant<bool, Distance::HasColumns>());
                     else
                         return findBestKeyMatch_BinSearch<false>(key, transform);
                 }
             }
 
+            /**
+             * Same search as findBestKeyMatch_BinSearch(), working a block of
+             * rows at a time from `columns`.  Distances for a block come from
+             * one call to Distance::columnDistances(), and groups of rows that
+             * can neither improve on the best match nor end the search are
+             * skipped with a branch-free test.  Blocks start small and grow,
+             * since the search often stops after a few rows.
+             */
+            std::tuple<ReturnValue, double> findBestKeyMatch_Columns(Key const& key,
+                                                                     Transform  transform,
+                                                                     std::true_type) const
+            {
+                if(this->table.empty())
+                    return std::make_tuple(this->nullValue, std::numeric_limits<double>::max());
+
+                auto comp = [](Entry const& e, Key const& key) { return e.key < key; };
+
+                size_t const rows = table.size();
+                size_t const orig
+                    = std::lower_bound(table.begin(), table.end(), key, comp) - table.begin();
+
+                double keyValues[MaxColumnDims];
+                for(size_t dim = 0; dim < columns.dims; dim++)
+                    keyValues[dim] = key[dim];
+
+                double const* column0 = columns.column(0);
+
+                double bestDistance = std::numeric_limits<double>::max();
+                auto   bestMatch    = this->nullValue;
+                double bestSpeed    = 0.0;
+
+                ptrdiff_t count = 0;
+
+                alignas(64) double distances[MaxColumnBlock];
+                alignas(64) double bounds[MaxColumnBlock];
+
+                // Returns false once no later row in this direction can be an
+                // improvement.
+                auto consider = [&](size_t row, size_t i) {
+                    if(bestMatch && bounds[i] >= bestDistance && distances[i] != 0.0)
+                        return false;
+
+                    count++;
+
+                    double myDistance = distances[i];
+
+                    if(myDistance < bestDistance
+                       || (myDistance == bestDistance && columns.speeds[row] > bestSpeed))
+                    {
+                        auto myMatch = transform(table[row].value);
+
+                        if(myMatch)
+                        {
+                            bestDistance = myDistance;
+                            bestMatch    = myMatch;
+                            bestSpeed    = columns.speeds[row];
+                        }
+                    }
+
+                    return true;
+                };
+
+                // True if none of the ColumnGroup rows starting at `i` could
+                // either improve on the best match or stop the search, so
+                // consider() would do nothing but count them.
+                auto skippable = [&](size_t i) {
+                    bool interesting = false;
+                    for(size_t g = i; g < i + ColumnGroup; g++)
+                        interesting |= (distances[g] <= bestDistance)
+                                       | (bool(bestMatch) & (bounds[g] >= bestDistance)
+                                          & (distances[g] != 0.0));
+                    return !interesting;
+                };
+
+                auto scanForward = [&](size_t begin, size_t n) {
+                    for(size_t i = 0; i < n;)
+                    {
+                        if(i + ColumnGroup <= n && skippable(i))
+                        {
+                            count += ColumnGroup;
+                            i += ColumnGroup;
+                        }
+                        else if(consider(begin + i, i))
+                            i++;
+                        else
+                            return false;
+                    }
+                    return true;
+                };
+
+                auto scanBackward = [&](size_t begin, size_t n) {
+                    for(size_t i = n; i > 0;)
+                    {
+                        if(i >= ColumnGroup && skippable(i - ColumnGroup))
+                        {
+                            count += ColumnGroup;
+                            i -= ColumnGroup;
+                        }
+                        else if(consider(begin + i - 1, i - 1))
+                            i--;
+                        else
+                            return false;
+                    }
+                    return true;
+                };
+
+                bool   searching = true;
+                size_t block     = MinColumnBlock;
+                for(size_t begin = orig; searching && begin < rows;)
+                {
+                    size_t n = std::min(block, rows - begin);
+                    Distance::columnDistances(
+                        keyValues, columns.dims, column0 + begin, rows, n, distances, bounds);
+
+                    searching = scanForward(begin, n);
+
+                    begin += n;
+                    block = std::min(block * 2, MaxColumnBlock);
+                }
+
+                searching = true;
+                block     = MinColumnBlock;
+                for(size_t end = orig; searching && end > 0;)
+                {
+                    size_t n     = std::min(block, end);
+                    size_t begin = end - n;
+                    Distance::columnDistances(
+                        keyValues, columns.dims, column0 + begin, rows, n, distances, bounds);
+
+                    searching = scanBackward(begin, n);
+
+                    end   = begin;
+                    block = std::min(block * 2, MaxColumnBlock);
+                }
+
+                if(Debug::Instance().printLookupEfficiency())
+                {
+                    double considered = count;
+                    considered /= table.size();
+                    considered *= 100;
+                    std::cout << "Considered " << considered << "% of entries." << std::endl;
+                }
+
+                return std::make_tuple(bestMatch, bestDistance);
+            }
+
+            std::tuple<ReturnValue, double> findBestKeyMatch_Columns(Key const& key,
+                                                                     Transform  transform,
+                                                                     std::false_type) const
+            {
+                return findBestKeyMatch_BinSearch<false>(key, transform);
+            }
+
             template <bool T_Debug>
             std::tuple<ReturnValue, double> findBestKeyMatch_BinSearch(Key const& key,
                                                                        Transform  transform) const
@@ -570,6 +829,11 @@ namespace Tensile
 
                 return std::make_tuple(bestMatch, bestDistance);
             }
+
+            static constexpr size_t MaxColumnDims  = 16;
+            static constexpr size_t MinColumnBlock = 8;
+            static constexpr size_t MaxColumnBlock = 256;
+            static constexpr size_t ColumnGroup    = 4;
         };
 
         /**
@@ -897,5 +1161,310 @@ namespace Tensile
                 return std::make_tuple(bestMatch, bestDistance);
             }
         };
+
+        /**
+         * DistanceMatchingTable searched through a k-d tree over its keys,
+         * which buildIndex() builds when the table is loaded.  Selected in a
+         * library file by appending "KDTree" to the distance name, e.g.
+         * "EuclideanKDTree".
+         *
+         * The sorted-table search examines every row whose first key element
+         * is close to the key's, which approaches a full scan when the rows
+         * cluster in that element.  The tree prunes on every element instead,
+         * which needs a `Separable` distance.  It returns the same match as
+         * the sorted-table search, including which of several equally
+         * distant rows wins.
+         */
+        template <typename Key,
+                  typename Object,
+                  typename Value,
+                  typename ReturnValue,
+                  typename Distance>
+        struct KDTreeMatchingTable
+            : public DistanceMatchingTable<Key, Object, Value, ReturnValue, Distance>
+        {
+            static_assert(Distance::Separable,
+                          "KDTreeMatchingTable requires a separable distance.");
+
+            using Base       = MatchingTable<Object, Value, ReturnValue>;
+            using Entry      = MatchingTableEntry<Key, Value>;
+            using Transform  = typename Base::Transform;
+            using Properties = typename Base::Properties;
+            using Parent
+                = DistanceMatchingTable<Key, Object, Value, ReturnValue, Distance>;
+            using Parent::columns;
+            using Parent::distance;
+            using Parent::nullValue;
+            using Parent::table;
+
+            KDTreeMatchingTable(ReturnValue nullValue = ReturnValue())
+                : Parent(nullValue)
+            {
+            }
+
+            KDTreeMatchingTable(Properties const& properties,
+                                ReturnValue       nullValue = ReturnValue())
+                : Parent(properties, nullValue)
+            {
+            }
+
+            KDTreeMatchingTable(Distance const&   distance,
+                                Properties const& properties,
+                                ReturnValue       nullValue = ReturnValue())
+                : Parent(distance, properties, nullValue)
+            {
+            }
+
+            static std::string Type()
+            {
+                return Distance::Type() + "KDTree";
+            }
+
+            virtual std::string distanceType() const override
+            {
+                return Type();
+            }
+
+            /**
+             * Builds the tree over the current contents of `table`, which must
+             * already be sorted.  Must be called again if `table` changes;
+             * until then, the sorted-table search is used.
+             */
+            void buildIndex()
+            {
+                this->buildColumns();
+
+                order.clear();
+                splitDims.clear();
+
+                if(columns.rows != table.size() || columns.dims == 0
+                   || columns.dims > MaxIndexDims)
+                    return;
+
+                order.resize(table.size());
+                std::iota(order.begin(), order.end(), 0);
+                splitDims.assign(table.size(), 0);
+
+                buildNode(0, order.size());
+            }
+
+            std::tuple<ReturnValue, double> findBestKeyMatch(Key const& key,
+                                                             Transform  transform) const override
+            {
+                if(order.empty() || order.size() != table.size() || columns.rows != table.size()
+                   || Debug::Instance().printPropertyEvaluation()
+                   || Debug::Instance().naivePropertySearch())
+                    return Parent::findBestKeyMatch(key, transform);
+
+                Search search{key, transform};
+
+                for(size_t dim = 0; dim < columns.dims; dim++)
+                {
+                    search.keyValues[dim] = key[dim];
+                    search.offsets[dim]   = 0.0;
+                }
+
+                searchNode(search, 0, order.size(), 0.0);
+
+                if(Debug::Instance().printLookupEfficiency())
+                {
+                    double considered = search.count;
+                    considered /= table.size();
+                    considered *= 100;
+                    std::cout << "Considered " << considered << "% of entries." << std::endl;
+                }
+
+                return resolveTies(key, search);
+            }
+
+            std::vector<uint32_t> order;     //< Row indices, arranged as an implicit tree.
+            std::vector<uint8_t>  splitDims; //< Split element of the node at each position.
+
+            static constexpr size_t MaxIndexDims = 16;
+            static constexpr size_t LeafSize     = 8;
+
+        private:
+            struct Search
+            {
+                Key const&       key;
+                Transform const& transform;
+
+                double keyValues[MaxIndexDims];
+                double offsets[MaxIndexDims]; //< Per-element distance to the current node.
+
+                double    bestDistance = std::numeric_limits<double>::max();
+                ptrdiff_t count        = 0;
+
+                //< Every matching row found at `bestDistance`.
+                std::vector<std::pair<size_t, ReturnValue>> candidates;
+            };
+
+            /**
+             * Node covering `order[begin, end)`: its row is at the middle
+             * position, rows no greater in the split element before it, and
+             * rows no less after it.  Short ranges are leaves.
+             */
+            void buildNode(size_t begin, size_t end)
+            {
+                if(end - begin <= LeafSize)
+                    return;
+
+                size_t dim    = 0;
+                double spread = -1.0;
+                for(size_t d = 0; d < columns.dims; d++)
+                {
+                    double const* column = columns.column(d);
+                    auto          range  = std::minmax_element(
+                        order.begin() + begin,
+                        order.begin() + end,
+                        [column](uint32_t a, uint32_t b) { return column[a] < column[b]; });
+
+                    double mySpread = column[*range.second] - column[*range.first];
+                    if(mySpread > spread)
+                    {
+                        dim    = d;
+                        spread = mySpread;
+                    }
+                }
+
+                double const* column = columns.column(dim);
+                size_t        mid    = begin + (end - begin) / 2;
+                auto          less
+                    = [column](uint32_t a, uint32_t b) { return column[a] < column[b]; };
+                std::nth_element(
+                    order.begin() + begin, order.begin() + mid, order.begin() + end, less);
+                splitDims[mid] = dim;
+
+                buildNode(begin, mid);
+                buildNode(mid + 1, end);
+            }
+
+            void considerRow(Search& search, size_t row) const
+            {
+                search.count++;
+
+                double myDistance = distance(search.key, table[row].key);
+                if(myDistance > search.bestDistance)
+                    return;
+
+                auto myMatch = search.transform(table[row].value);
+                if(!myMatch)
+                    return;
+
+                if(myDistance < search.bestDistance)
+                {
+                    search.bestDistance = myDistance;
+                    search.candidates.clear();
+                }
+
+                search.candidates.emplace_back(row, myMatch);
+            }
+
+            /**
+             * `bound` is a lower bound on the distance to any row of the node,
+             * built up from `search.offsets`.  Subtrees which can only hold
+             * rows farther than the best match are skipped, but equally
+             * distant ones are not, since they may win on speed.
+             */
+            void searchNode(Search& search, size_t begin, size_t end, double bound) const
+            {
+                if(bound > search.bestDistance)
+                    return;
+
+                if(end - begin <= LeafSize)
+                {
+                    for(size_t pos = begin; pos < end; pos++)
+                        considerRow(search, order[pos]);
+                    return;
+                }
+
+                size_t mid = begin + (end - begin) / 2;
+                size_t dim = splitDims[mid];
+
+                double difference = search.keyValues[dim] - columns.column(dim)[order[mid]];
+
+                considerRow(search, order[mid]);
+
+                if(difference < 0)
+                    searchNode(search, begin, mid, bound);
+                else
+                    searchNode(search, mid + 1, end, bound);
+
+                double oldOffset = search.offsets[dim];
+                double newOffset = std::max(oldOffset, std::abs(difference));
+                double farBound  = bound - Distance::dimensionDistance(oldOffset)
+                                  + Distance::dimensionDistance(newOffset);
+
+                search.offsets[dim] = newOffset;
+
+                if(difference < 0)
+                    searchNode(search, mid + 1, end, farBound);
+                else
+                    searchNode(search, begin, mid, farBound);
+
+                search.offsets[dim] = oldOffset;
+            }
+
+            /**
+             * Picks from the rows at the best distance the one the
+             * sorted-table search would return.  That search walks rightward
+             * from the key's lower_bound position and then leftward, and keeps
+             * the first of the fastest rows it visits.  It visits every row
+             * for which improvementPossible() holds at the best distance.
+             * In each direction it stops at the first row for which it
+             * doesn't, once it has seen a row at the best distance, so that
+             * row is only visited if none has been seen before it.
+             */
+            std::tuple<ReturnValue, double> resolveTies(Key const& key, Search& search) const
+            {
+                auto& candidates = search.candidates;
+
+                if(candidates.empty())
+                    return std::make_tuple(nullValue, std::numeric_limits<double>::max());
+
+                auto comp = [](Entry const& e, Key const& key) { return e.key < key; };
+                size_t const orig
+                    = std::lower_bound(table.begin(), table.end(), key, comp) - table.begin();
+
+                auto visitRank = [&](size_t row) {
+                    return row >= orig ? row - orig : table.size() + orig - row;
+                };
+
+                std::sort(candidates.begin(),
+                          candidates.end(),
+                          [&](std::pair<size_t, ReturnValue> const& a,
+                              std::pair<size_t, ReturnValue> const& b) {
+                              return visitRank(a.first) < visitRank(b.first);
+                          });
+
+                auto   bestMatch = nullValue;
+                double bestSpeed = 0.0;
+                bool   stopped[2]{false, false};
+
+                for(auto const& candidate : candidates)
+                {
+                    size_t row       = candidate.first;
+                    size_t direction = row >= orig ? 0 : 1;
+
+                    if(stopped[direction])
+                        continue;
+
+                    if(!distance.improvementPossible(key, table[row].key, 0, search.bestDistance))
+                    {
+                        stopped[direction] = true;
+                        if(bestMatch)
+                            continue;
+                    }
+
+                    if(!bestMatch || table[row].speed > bestSpeed)
+                    {
+                        bestMatch = candidate.second;
+                        bestSpeed = table[row].speed;
+                    }
+                }
+
+                return std::make_tuple(bestMatch, search.bestDistance);
+            }
+        };
     } // namespace Matching
 } // namespace Tensile
@@ -58,6 +58,10 @@ namespace Tensile
                 iot::mapRequired(io, "hardwarePredicate", s.hardwarePredicate);
                 iot::mapRequired(io, "problemPredicate", s.problemPredicate);
 
+                if(!iot::outputting(io))
+                    s.problemProgram
+                        = Predicates::Contraction::Program::Compile(s.problemPredicate);
+
                 iot::mapRequired(io, "debugKernel", s.debugKernel);
                 iot::mapOptional(io, "libraryLogicIndex", s.libraryLogicIndex);
                 iot::mapOptional(io, "ideals", s.ideals);
@@ -61,6 +61,9 @@ namespace Tensile
                 int32_t index = -1;
                 iot::mapRequired(io, "trees", lib.trees);
                 iot::mapRequired(io, "nullValue", lib.nullValue);
+
+                if(!iot::outputting(io))
+                    lib.compile();
             }
 
             const static bool flow = false;
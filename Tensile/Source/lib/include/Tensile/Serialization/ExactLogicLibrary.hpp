@@ -73,6 +73,9 @@ namespace Tensile
             {
                 iot::mapRequired(io, "predicate", row.first.value);
                 iot::mapRequired(io, "library", row.second);
+
+                if(!iot::outputting(io))
+                    row.first = MyPredicate(row.first.value);
             }
 
             const static bool flow = false;
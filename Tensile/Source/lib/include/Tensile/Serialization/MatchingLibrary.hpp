@@ -63,12 +63,39 @@ namespace Tensile
                         return e1.key < e2.key || (e1.key == e2.key && e1.speed > e2.speed);
                     };
                     std::sort(table.table.begin(), table.table.end(), comp);
+                    table.buildColumns();
                 }
             }
 
             const static bool flow = false;
         };
 
+        template <typename Key,
+                  typename MyProblem,
+                  typename Element,
+                  typename Return,
+                  typename Distance,
+                  typename IO>
+        struct MappingTraits<
+            Matching::KDTreeMatchingTable<Key, MyProblem, Element, Return, Distance>,
+            IO>
+        {
+            using Table = Matching::KDTreeMatchingTable<Key, MyProblem, Element, Return, Distance>;
+            using Parent
+                = Matching::DistanceMatchingTable<Key, MyProblem, Element, Return, Distance>;
+            using iot = IOTraits<IO>;
+
+            static void mapping(IO& io, Table& table)
+            {
+                MappingTraits<Parent, IO>::mapping(io, table);
+
+                if(!iot::outputting(io))
+                    table.buildIndex();
+            }
+
+            const static bool flow = false;
+        };
+
         template <typename MyProblem, typename MySolution, typename IO>
         struct MappingTraits<ProblemMatchingLibrary<MyProblem, MySolution>, IO>
         {
@@ -155,6 +182,16 @@ namespace Tensile
                     success = mappingDistance<Key, Matching::ManhattanDistance<Key>>(
                         io, lib, properties);
                 }
+                else if(distanceType == "EuclideanKDTree")
+                {
+                    success = mappingKDTree<Key, Matching::EuclideanDistance<Key>>(
+                        io, lib, properties);
+                }
+                else if(distanceType == "ManhattanKDTree")
+                {
+                    success = mappingKDTree<Key, Matching::ManhattanDistance<Key>>(
+                        io, lib, properties);
+                }
                 else if(distanceType == "Ratio")
                 {
                     success
@@ -187,6 +224,24 @@ namespace Tensile
                                                               std::shared_ptr<MySolution>,
                                                               Distance>;
 
+                return mappingTable<Table>(io, lib, properties);
+            }
+
+            template <typename Key, typename Distance>
+            static bool mappingKDTree(IO& io, Library& lib, Properties const& properties)
+            {
+                using Table = Matching::KDTreeMatchingTable<Key,
+                                                            MyProblem,
+                                                            Element,
+                                                            std::shared_ptr<MySolution>,
+                                                            Distance>;
+
+                return mappingTable<Table>(io, lib, properties);
+            }
+
+            template <typename Table>
+            static bool mappingTable(IO& io, Library& lib, Properties const& properties)
+            {
                 std::shared_ptr<Table> table;
 
                 if(iot::outputting(io))
@@ -200,6 +255,7 @@ namespace Tensile
                     table             = std::make_shared<Table>();
                     table->properties = properties;
                     lib.table         = table;
+                    table->resolvePropertyValues();
                 }
 
                 MappingTraits<Table, IO>::mapping(io, *table);
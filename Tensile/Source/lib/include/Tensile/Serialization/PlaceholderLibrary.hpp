@@ -50,8 +50,20 @@ namespace Tensile
                 if(!iot::outputting(io))
                 {
                     auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
-                    lib.masterSolutions = ctx->solutions;
-                    lib.solutionsGuard  = ctx->solutionsGuard;
+                    lib.masterSolutions     = ctx->solutions;
+                    lib.solutionsGuard      = ctx->solutionsGuard;
+                    lib.masterSolutionFiles = ctx->lazySolutionFiles;
+                    lib.fileIndex           = ctx->lazyFiles.size();
+                    ctx->lazyLoading        = true;
+
+                    ctx->lazyFiles.push_back(
+                        {[&lib]() {
+                             if(!lib.loaded.load(std::memory_order_acquire))
+                                 lib.loadPlaceholderLibrary();
+                         },
+                         [&lib](Hardware const& hardware, MySolution const& solution) {
+                             return lib.getCodeObjectFileName(hardware, solution);
+                         }});
 
                     //Extract directory where TensileLibrary.dat/yaml file is located
                     lib.libraryDirectory = ctx->filename;
@@ -70,7 +82,11 @@ namespace Tensile
                         std::string pattern = RegexPattern(condition);
                         if(std::regex_search(lib.filePrefix, std::regex(pattern)))
                         {
-                            lib.loadPlaceholderLibrary();
+                            // Loaded by the master library once it has been read.
+                            auto& preloads = condition == LazyLoadingInit::AllBackground
+                                                 ? ctx->backgroundPreloads
+                                                 : ctx->preloads;
+                            preloads.push_back([&lib]() { lib.loadPlaceholderLibrary(); });
                             break;
                         }
                     }
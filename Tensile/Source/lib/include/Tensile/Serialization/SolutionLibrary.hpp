@@ -180,11 +180,12 @@ namespace Tensile
                 if(!iot::outputting(io))
                 {
                     for(auto const& s : solutions)
-                        lib.solutions[s->index] = s;
+                        lib.solutions.insert_or_assign(s->index, s);
 
                     auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
-                    ctx->solutions      = &lib.solutions;
-                    ctx->solutionsGuard = &lib.solutionsGuard;
+                    ctx->solutions         = &lib.solutions;
+                    ctx->solutionsGuard    = &lib.solutionsGuard;
+                    ctx->lazySolutionFiles = &lib.lazySolutionFiles;
                 }
 
                 std::shared_ptr<SolutionLibrary<MyProblem, MySolution>> innerLibrary;
@@ -211,6 +212,11 @@ namespace Tensile
                         = std::make_shared<CachingLibrary<MyProblem, MySolution>>(innerLibrary);
 
                     lib.library = cache;
+
+                    auto ctx = static_cast<LibraryIOContext<MySolution>*>(iot::getContext(io));
+                    lib.libraryFile = ctx->filename;
+                    lib.lazyLoading = ctx->lazyLoading;
+                    lib.lazyFiles   = std::move(ctx->lazyFiles);
                 }
             }
 
@@ -99,6 +99,21 @@ namespace Tensile
             return std::shared_ptr<MySolution>();
         }
 
+        virtual std::shared_ptr<MySolution> findBestSolution(typename MyProblem::View& view,
+                                                             Hardware const&           hardware,
+                                                             double*                   fitness
+                                                             = nullptr) const override
+        {
+            if(Debug::Instance().printPredicateEvaluation())
+                return findBestSolution(view.problem(), hardware, fitness);
+
+            if(solution && (*solution->hardwarePredicate)(hardware)
+               && solution->checkProblemPredicate(view))
+                return solution;
+
+            return std::shared_ptr<MySolution>();
+        }
+
         virtual SolutionSet<MySolution> findAllSolutions(MyProblem const& problem,
                                                          Hardware const&  hardware) const override
         {
@@ -0,0 +1,396 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace Tensile
+{
+    /**
+ * \ingroup Utilities
+ */
+
+    /**
+ * Sequence container with room for `N` elements inside the object.  Up to
+ * `N` elements it never touches the heap; past that the elements move to a
+ * `std::vector`, and move back when the size drops to `N` again.  The
+ * interface is the subset of `std::vector` used for tensor dimensions and
+ * contraction indices, so it can stand in for one.
+ *
+ * `T` must be default-constructible and copyable: the inline slots are
+ * ordinary elements, not raw storage.
+ */
+    template <typename T, size_t N>
+    class SmallVector
+    {
+    public:
+        using value_type             = T;
+        using size_type              = size_t;
+        using difference_type        = ptrdiff_t;
+        using reference              = T&;
+        using const_reference        = T const&;
+        using pointer                = T*;
+        using const_pointer          = T const*;
+        using iterator               = T*;
+        using const_iterator         = T const*;
+        using reverse_iterator       = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_t InlineCapacity = N;
+
+        SmallVector() = default;
+
+        explicit SmallVector(size_t count, T const& value = T())
+        {
+            resize(count, value);
+        }
+
+        template <typename Iter,
+                  typename = typename std::iterator_traits<Iter>::iterator_category>
+        SmallVector(Iter first, Iter last)
+        {
+            assign(first, last);
+        }
+
+        SmallVector(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+        }
+
+        SmallVector(std::vector<T> const& other)
+        {
+            assign(other.begin(), other.end());
+        }
+
+        SmallVector(SmallVector const& other) = default;
+
+        SmallVector(SmallVector&& other)
+            : m_inline(other.m_inline)
+            , m_heap(std::move(other.m_heap))
+            , m_size(other.m_size)
+        {
+            other.clear();
+        }
+
+        SmallVector& operator=(SmallVector const& other) = default;
+
+        SmallVector& operator=(SmallVector&& other)
+        {
+            if(this != &other)
+            {
+                m_inline = other.m_inline;
+                m_heap   = std::move(other.m_heap);
+                m_size   = other.m_size;
+                other.clear();
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        template <typename Iter>
+        void assign(Iter first, Iter last)
+        {
+            clear();
+            for(; first != last; ++first)
+                push_back(*first);
+        }
+
+        /// True while the elements are held inside the object.
+        bool isInline() const
+        {
+            return m_size <= N;
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        size_t capacity() const
+        {
+            return isInline() ? N : m_heap.capacity();
+        }
+
+        /// Bytes held on the heap, beyond sizeof(SmallVector).
+        size_t heapBytes() const
+        {
+            return m_heap.capacity() * sizeof(T);
+        }
+
+        T* data()
+        {
+            return isInline() ? m_inline.data() : m_heap.data();
+        }
+
+        T const* data() const
+        {
+            return isInline() ? m_inline.data() : m_heap.data();
+        }
+
+        iterator begin()
+        {
+            return data();
+        }
+
+        iterator end()
+        {
+            return data() + m_size;
+        }
+
+        const_iterator begin() const
+        {
+            return data();
+        }
+
+        const_iterator end() const
+        {
+            return data() + m_size;
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        reverse_iterator rbegin()
+        {
+            return reverse_iterator(end());
+        }
+
+        reverse_iterator rend()
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        T& operator[](size_t idx)
+        {
+            return data()[idx];
+        }
+
+        T const& operator[](size_t idx) const
+        {
+            return data()[idx];
+        }
+
+        T& at(size_t idx)
+        {
+            if(idx >= m_size)
+                throw std::out_of_range("SmallVector index out of range.");
+            return data()[idx];
+        }
+
+        T const& at(size_t idx) const
+        {
+            if(idx >= m_size)
+                throw std::out_of_range("SmallVector index out of range.");
+            return data()[idx];
+        }
+
+        T& front()
+        {
+            return data()[0];
+        }
+
+        T const& front() const
+        {
+            return data()[0];
+        }
+
+        T& back()
+        {
+            return data()[m_size - 1];
+        }
+
+        T const& back() const
+        {
+            return data()[m_size - 1];
+        }
+
+        void push_back(T const& value)
+        {
+            if(m_size < N)
+            {
+                m_inline[m_size] = value;
+            }
+            else
+            {
+                if(m_size == N)
+                    m_heap.assign(m_inline.begin(), m_inline.end());
+                m_heap.push_back(value);
+            }
+            m_size++;
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args)
+        {
+            push_back(T(std::forward<Args>(args)...));
+        }
+
+        void pop_back()
+        {
+            resize(m_size - 1);
+        }
+
+        void resize(size_t count, T value = T())
+        {
+            if(count <= N)
+            {
+                if(!isInline())
+                {
+                    std::copy(m_heap.begin(), m_heap.begin() + count, m_inline.begin());
+                    m_heap.clear();
+                }
+                else if(count > m_size)
+                {
+                    std::fill(m_inline.begin() + m_size, m_inline.begin() + count, value);
+                }
+            }
+            else
+            {
+                if(isInline())
+                    m_heap.assign(m_inline.begin(), m_inline.begin() + m_size);
+                m_heap.resize(count, value);
+            }
+            m_size = count;
+        }
+
+        void reserve(size_t count)
+        {
+            if(count > N)
+                m_heap.reserve(count);
+        }
+
+        void clear()
+        {
+            m_heap.clear();
+            m_size = 0;
+        }
+
+        template <typename Iter,
+                  typename = typename std::iterator_traits<Iter>::iterator_category>
+        iterator insert(const_iterator pos, Iter first, Iter last)
+        {
+            size_t idx   = pos - begin();
+            size_t count = std::distance(first, last);
+            size_t old   = m_size;
+
+            resize(old + count);
+            std::move_backward(begin() + idx, begin() + old, end());
+            std::copy(first, last, begin() + idx);
+
+            return begin() + idx;
+        }
+
+        iterator insert(const_iterator pos, T value)
+        {
+            return insert(pos, &value, &value + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_t idx   = first - begin();
+            size_t count = last - first;
+
+            std::move(begin() + idx + count, end(), begin() + idx);
+            resize(m_size - count);
+
+            return begin() + idx;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        bool operator==(SmallVector const& rhs) const
+        {
+            return m_size == rhs.m_size && std::equal(begin(), end(), rhs.begin());
+        }
+
+        bool operator!=(SmallVector const& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        bool operator<(SmallVector const& rhs) const
+        {
+            return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+        }
+
+        bool operator>(SmallVector const& rhs) const
+        {
+            return rhs < *this;
+        }
+
+        bool operator<=(SmallVector const& rhs) const
+        {
+            return !(rhs < *this);
+        }
+
+        bool operator>=(SmallVector const& rhs) const
+        {
+            return !(*this < rhs);
+        }
+
+    private:
+        std::array<T, N> m_inline{};
+        std::vector<T>   m_heap;
+        size_t           m_size = 0;
+    };
+} // namespace Tensile
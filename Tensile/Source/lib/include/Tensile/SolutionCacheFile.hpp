@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Tensile/AMDGPU.hpp>
+#include <Tensile/Comparison.hpp>
+#include <Tensile/Macros.hpp>
+#include <Tensile/MappedFile.hpp>
+
+namespace Tensile
+{
+    /**
+     * \ingroup SolutionLibrary
+     *
+     * On-disk solution selection cache, so that a restarted process can
+     * resolve problems it has seen before without traversing the library.
+     *
+     * Maps (problem fingerprint, processor, CU count) to a solution index,
+     * its fitness and, for lazily-loaded libraries, the placeholder library
+     * the solution is read from.  The file is a fixed header followed by an open-addressed
+     * table of fixed-size records, so it is used in place once memory-mapped.
+     * A hash identifying the library is stored in the header; a file written
+     * for a different library is ignored.
+     */
+    class TENSILE_API SolutionCacheFile
+    {
+    public:
+        static constexpr uint32_t FormatVersion = 2;
+
+        struct Record
+        {
+            uint64_t fingerprintLo;
+            uint64_t fingerprintHi;
+            uint32_t processor;
+            uint32_t computeUnitCount;
+            int64_t  solutionIndex; //< -1 marks an empty slot.
+            double   fitness;
+            int32_t  placeholder; //< Position of the placeholder library, or -1.
+            uint32_t reserved;
+        };
+
+        /**
+         * Maps `filename` if it exists and was written for `libraryHash`;
+         * otherwise the cache starts out empty.
+         */
+        SolutionCacheFile(std::string const& filename, uint64_t libraryHash);
+
+        /**
+         * Identifies a library by its file's size and modification time, its
+         * version string and its solution count.
+         */
+        static uint64_t LibraryHash(std::string const& libraryFile,
+                                    std::string const& version,
+                                    size_t             solutionCount);
+
+        static Record MakeRecord(Fingerprint const& problem,
+                                 AMDGPU const&      hardware,
+                                 int64_t            solutionIndex,
+                                 double             fitness,
+                                 int32_t            placeholder = -1);
+
+        Record const* find(Fingerprint const& problem, AMDGPU const& hardware) const;
+
+        /// All records currently in the file.
+        std::vector<Record> records() const;
+
+        size_t size() const;
+
+        std::string const& filename() const
+        {
+            return m_filename;
+        }
+
+        uint64_t libraryHash() const
+        {
+            return m_libraryHash;
+        }
+
+        /**
+         * Writes `records` to `filename`.  The file is written under a
+         * temporary name and renamed into place so concurrent readers never
+         * see a partial file.
+         */
+        static bool
+            Write(std::string const& filename, uint64_t libraryHash, std::vector<Record> const& records);
+
+    private:
+        struct Header
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t recordSize;
+            uint64_t libraryHash;
+            uint64_t capacity;
+            uint64_t count;
+        };
+
+        static size_t Slot(Record const& record);
+
+        std::string                 m_filename;
+        uint64_t                    m_libraryHash;
+        std::unique_ptr<MappedFile> m_file;
+        Header const*               m_header  = nullptr;
+        Record const*               m_records = nullptr;
+    };
+} // namespace Tensile
@@ -29,6 +29,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <Tensile/Tensile.hpp>
 
@@ -84,6 +85,42 @@ namespace Tensile
                                                              Hardware const&  hardware,
                                                              double* fitness = nullptr) const = 0;
 
+        /**
+   * Form of `findBestSolution()` used between the levels of a library.
+   * `view` memoizes the properties of the problem, so a property read by
+   * several levels (or by several candidate solutions) is computed once.
+   *
+   * The top of the library creates the view; each level passes it on to
+   * the next.  By default the view is dropped and the problem is looked up
+   * directly.
+   */
+        virtual std::shared_ptr<MySolution>
+            findBestSolution(typename MyProblem::View& view,
+                             Hardware const&           hardware,
+                             double*                   fitness = nullptr) const
+        {
+            return findBestSolution(view.problem(), hardware, fitness);
+        }
+
+        /**
+   * Batched form of `findBestSolution()`.  For each `i` in `indices`, stores
+   * the best solution for `problems[i]` in `solutions[i]` and its fitness in
+   * `fitness[i]`.  Entries not named in `indices` are left untouched.
+   *
+   * Libraries which can share work between problems (predicate evaluation,
+   * key lookups) override this; by default each problem is looked up on its
+   * own.
+   */
+        virtual void findBestSolutions(std::vector<MyProblem> const&             problems,
+                                       std::vector<size_t> const&                indices,
+                                       Hardware const&                           hardware,
+                                       std::vector<std::shared_ptr<MySolution>>& solutions,
+                                       std::vector<double>&                      fitness) const
+        {
+            for(size_t i : indices)
+                solutions[i] = findBestSolution(problems[i], hardware, &fitness[i]);
+        }
+
         /**
    * Returns all `Solution` objects that are capable of correctly solving this
    * `problem` on this `hardware`.
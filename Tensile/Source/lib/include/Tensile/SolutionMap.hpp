@@ -0,0 +1,348 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Tensile
+{
+    /**
+     * \ingroup SolutionLibrary
+     *
+     * Solutions of a library by index.  Held in a dense, append-only array
+     * split into segments which double in size, so growing it never moves an
+     * entry and each slot is published with a single atomic store.  Lookups
+     * and iteration take no locks and may run while another thread inserts,
+     * as a PlaceholderLibrary does when it loads lazily.  Inserts must be
+     * serialized by the caller.
+     *
+     * The interface is the subset of std::map<int, std::shared_ptr<MySolution>>
+     * used for solution maps; iteration is in index order.
+     */
+    template <typename MySolution>
+    class SolutionMap
+    {
+    public:
+        using key_type    = int;
+        using mapped_type = std::shared_ptr<MySolution>;
+        using value_type  = std::pair<int const, std::shared_ptr<MySolution>>;
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type        = SolutionMap::value_type;
+            using difference_type   = ptrdiff_t;
+            using pointer           = value_type const*;
+            using reference         = value_type const&;
+
+            const_iterator() = default;
+
+            reference operator*() const
+            {
+                return *m_map->load(m_index);
+            }
+
+            pointer operator->() const
+            {
+                return m_map->load(m_index);
+            }
+
+            const_iterator& operator++()
+            {
+                int end = m_map->m_end.load(std::memory_order_acquire);
+                for(m_index++; m_index < end; m_index++)
+                    if(m_map->load(m_index))
+                        return *this;
+
+                m_index = End;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                auto rv = *this;
+                ++*this;
+                return rv;
+            }
+
+            const_iterator& operator--()
+            {
+                if(m_index == End)
+                    m_index = m_map->m_end.load(std::memory_order_acquire);
+
+                for(m_index--; m_index >= 0; m_index--)
+                    if(m_map->load(m_index))
+                        return *this;
+
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                auto rv = *this;
+                --*this;
+                return rv;
+            }
+
+            bool operator==(const_iterator const& rhs) const
+            {
+                return m_map == rhs.m_map && m_index == rhs.m_index;
+            }
+
+            bool operator!=(const_iterator const& rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+            friend class SolutionMap;
+
+            // Stays the end iterator while inserts extend the map.
+            static constexpr int End = std::numeric_limits<int>::max();
+
+            const_iterator(SolutionMap const* map, int index)
+                : m_map(map)
+                , m_index(index)
+            {
+            }
+
+            SolutionMap const* m_map   = nullptr;
+            int                m_index = End;
+        };
+
+        using iterator               = const_iterator;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        using reverse_iterator       = const_reverse_iterator;
+
+        SolutionMap() = default;
+
+        SolutionMap(std::initializer_list<value_type> init)
+        {
+            insert(init.begin(), init.end());
+        }
+
+        SolutionMap(SolutionMap const& other)
+        {
+            insert(other.begin(), other.end());
+        }
+
+        /// Not safe while other threads read either map.
+        SolutionMap& operator=(SolutionMap const& other)
+        {
+            if(this != &other)
+            {
+                clear();
+                insert(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        ~SolutionMap()
+        {
+            clear();
+        }
+
+        std::pair<iterator, bool> insert(value_type const& value)
+        {
+            auto& slot = this->slot(value.first);
+
+            if(auto const* existing = slot.load(std::memory_order_relaxed))
+                return {iterator(this, existing->first), false};
+
+            publish(slot, value);
+            return {iterator(this, value.first), true};
+        }
+
+        template <typename Iter>
+        void insert(Iter first, Iter last)
+        {
+            for(; first != last; ++first)
+                insert(*first);
+        }
+
+        /**
+         * Replaces any existing entry for `index`.  The replaced entry stays
+         * alive until the map is cleared, so readers which already hold a
+         * reference to it are not affected.
+         */
+        void insert_or_assign(int index, mapped_type const& solution)
+        {
+            auto& slot = this->slot(index);
+
+            if(slot.load(std::memory_order_relaxed))
+                m_size.fetch_sub(1, std::memory_order_relaxed);
+
+            publish(slot, value_type(index, solution));
+        }
+
+        const_iterator find(int index) const
+        {
+            if(load(index))
+                return const_iterator(this, index);
+
+            return end();
+        }
+
+        mapped_type const& at(int index) const
+        {
+            if(auto const* entry = load(index))
+                return entry->second;
+
+            throw std::out_of_range("SolutionMap index out of range.");
+        }
+
+        size_t count(int index) const
+        {
+            return load(index) ? 1 : 0;
+        }
+
+        size_t size() const
+        {
+            return m_size.load(std::memory_order_acquire);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return ++const_iterator(this, -1);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, const_iterator::End);
+        }
+
+        const_reverse_iterator rbegin() const
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator rend() const
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        /// Not safe while other threads read the map.
+        void clear()
+        {
+            for(size_t segment = 0; segment < SegmentCount; segment++)
+            {
+                delete[] m_segments[segment].load(std::memory_order_relaxed);
+                m_segments[segment].store(nullptr, std::memory_order_relaxed);
+            }
+
+            m_entries.clear();
+            m_size.store(0, std::memory_order_relaxed);
+            m_end.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        using Slot = std::atomic<value_type const*>;
+
+        // Segment s holds FirstSegmentSize << s slots, enough for every
+        // index up to MaxIndex in SegmentCount segments.  INT_MAX itself is
+        // the end iterator's index, so m_end never goes past it.
+        static constexpr size_t FirstSegmentSize = 64;
+        static constexpr size_t SegmentCount     = 26;
+        static constexpr int    MaxIndex         = const_iterator::End - 1;
+
+        static_assert((FirstSegmentSize << SegmentCount) - FirstSegmentSize
+                          > static_cast<size_t>(MaxIndex),
+                      "Segments must hold every index up to MaxIndex.");
+
+        static size_t segmentOf(size_t position)
+        {
+            size_t segment = 0;
+            while(position >= (FirstSegmentSize << (segment + 1)))
+                segment++;
+            return segment;
+        }
+
+        value_type const* load(int index) const
+        {
+            if(index < 0)
+                return nullptr;
+
+            size_t position = static_cast<size_t>(index) + FirstSegmentSize;
+            size_t segment  = segmentOf(position);
+
+            Slot const* slots = m_segments[segment].load(std::memory_order_acquire);
+            if(slots == nullptr)
+                return nullptr;
+
+            return slots[position - (FirstSegmentSize << segment)].load(
+                std::memory_order_acquire);
+        }
+
+        Slot& slot(int index)
+        {
+            if(index < 0 || index > MaxIndex)
+                throw std::out_of_range("Solution index out of range.");
+
+            size_t position = static_cast<size_t>(index) + FirstSegmentSize;
+            size_t segment  = segmentOf(position);
+
+            Slot* slots = m_segments[segment].load(std::memory_order_relaxed);
+            if(slots == nullptr)
+            {
+                slots = new Slot[FirstSegmentSize << segment]();
+                m_segments[segment].store(slots, std::memory_order_release);
+            }
+
+            return slots[position - (FirstSegmentSize << segment)];
+        }
+
+        void publish(Slot& slot, value_type const& value)
+        {
+            m_entries.push_back(std::make_unique<value_type>(value));
+            slot.store(m_entries.back().get(), std::memory_order_release);
+
+            m_size.fetch_add(1, std::memory_order_release);
+            if(value.first >= m_end.load(std::memory_order_relaxed))
+                m_end.store(value.first + 1, std::memory_order_release);
+        }
+
+        std::array<std::atomic<Slot*>, SegmentCount> m_segments{};
+        std::vector<std::unique_ptr<value_type>>     m_entries;
+        std::atomic<size_t>                          m_size{0};
+        std::atomic<int>                             m_end{0};
+    };
+} // namespace Tensile
@@ -38,6 +38,7 @@
 #include <Tensile/DataTypes.hpp>
 #include <Tensile/Debug.hpp>
 #include <Tensile/Macros.hpp>
+#include <Tensile/SmallVector.hpp>
 #include <Tensile/Utils.hpp>
 
 namespace Tensile
@@ -111,6 +112,9 @@ namespace Tensile
     public:
         static const size_t UseDefaultStride;
 
+        /// Sizes or strides of a tensor; held inline for up to 4 dimensions.
+        using Dimensions = SmallVector<size_t, 4>;
+
         TensorDescriptor()
         {
             this->calculate();
@@ -202,11 +206,11 @@ namespace Tensile
             }
         }
 
-        const std::vector<size_t>& sizes() const
+        const Dimensions& sizes() const
         {
             return m_sizes;
         }
-        const std::vector<size_t>& strides() const
+        const Dimensions& strides() const
         {
             return m_strides;
         }
@@ -330,9 +334,9 @@ namespace Tensile
         friend std::ostream& operator<<(std::ostream& stream, const TensorDescriptor& t);
 
     private:
-        std::vector<size_t> m_sizes;
-        std::vector<size_t> m_strides;
-        size_t              m_offset = 0;
+        Dimensions m_sizes;
+        Dimensions m_strides;
+        size_t     m_offset = 0;
 
         size_t m_totalLogicalElements   = 0;
         size_t m_totalAllocatedElements = 0;
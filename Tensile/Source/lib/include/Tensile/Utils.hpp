@@ -86,6 +86,13 @@ namespace Tensile
             return m_value;
         }
 
+        /// Copies the value into `value`, reusing its storage.
+        void load(T& value) const
+        {
+            std::lock_guard<std::mutex> lock(m_access);
+            value = m_value;
+        }
+
         T operator*() const
         {
             return load();
@@ -31,7 +31,12 @@
 #include <Tensile/Utils.hpp>
 
 #include <cctype>
+#include <atomic>
 #include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 
 namespace Tensile
@@ -862,9 +867,8 @@ namespace Tensile
         for(auto zp : m_bZeroPads)
             m_boundIndices[toBoundsPos(zp.boundIndex)].bZeroPad = zp;
 
-        getIndexNames(m_aNames, m_bNames, m_cNames, m_dNames, m_sumNames);
-
-        m_operationIdentifier = getOperationIdentifier();
+        m_operation   = getOperation();
+        m_fingerprint = getFingerprint();
 
         m_problemSizes.resize(0);
         m_problemSizes.reserve(m_c.dimensions() + m_boundSizes.size());
@@ -917,10 +921,10 @@ namespace Tensile
 
     void ContractionProblem::consistencyCheck() const
     {
-        std::vector<int> aUseCount(m_a.dimensions(), 0);
-        std::vector<int> bUseCount(m_b.dimensions(), 0);
-        std::vector<int> cUseCount(m_c.dimensions(), 0);
-        std::vector<int> dUseCount(m_d.dimensions(), 0);
+        SmallVector<int, 8> aUseCount(m_a.dimensions(), 0);
+        SmallVector<int, 8> bUseCount(m_b.dimensions(), 0);
+        SmallVector<int, 8> cUseCount(m_c.dimensions(), 0);
+        SmallVector<int, 8> dUseCount(m_d.dimensions(), 0);
 
         for(FreeIndex const& free : m_freeIndices)
         {
@@ -1073,11 +1077,11 @@ namespace Tensile
         return rv;
     }
 
-    void ContractionProblem::getIndexNames(std::string& aNames,
-                                           std::string& bNames,
-                                           std::string& cNames,
-                                           std::string& dNames,
-                                           std::string& sumNames) const
+    void ContractionProblem::getIndexNames(IndexNames& aNames,
+                                           IndexNames& bNames,
+                                           IndexNames& cNames,
+                                           IndexNames& dNames,
+                                           IndexNames& sumNames) const
     {
         aNames.resize(m_a.dimensions(), '_');
         bNames.resize(m_b.dimensions(), '_');
@@ -1134,48 +1138,336 @@ namespace Tensile
     {
         std::ostringstream rv;
 
-        rv << "D[" << m_dNames << "] = alpha * (";
+        rv << "D[" << dNames() << "] = alpha * (";
 
-        if(!m_sumNames.empty())
-            rv << "Sum[" << m_sumNames << "] ";
+        if(!sumNames().empty())
+            rv << "Sum[" << sumNames() << "] ";
 
-        rv << "A[" << m_aNames << "] * B[" << m_bNames << "])";
+        rv << "A[" << aNames() << "] * B[" << bNames() << "])";
 
         if(!m_c.empty() && m_beta != 0)
         {
             rv << " + ";
             if(m_beta != 1.0)
                 rv << "beta * ";
-            rv << "C[" << m_cNames << "]";
+            rv << "C[" << cNames() << "]";
         }
 
         return rv.str();
     }
 
-    std::string ContractionProblem::getOperationIdentifier() const
+    namespace
     {
-        std::string rv = "Contraction_";
-        rv += m_sumNames;
-        rv += "_A";
-        rv += m_aNames;
-        for(auto const& op : m_aOps)
-            rv += op.suffix();
+        /**
+         * Structural key of an operation: tensor ranks, index tuples and op
+         * kinds, one byte each.  Problems with equal keys have the same
+         * operation identifier (the converse need not hold).
+         */
+        struct OperationKey
+        {
+            SmallVector<uint8_t, 64> bytes;
+            bool                     valid = true; //< False if a value did not fit a byte.
 
-        rv += "_B";
-        rv += m_bNames;
-        for(auto const& op : m_bOps)
-            rv += op.suffix();
+            void add(size_t value)
+            {
+                valid = valid && value <= std::numeric_limits<uint8_t>::max();
+                bytes.push_back(static_cast<uint8_t>(value));
+            }
 
-        rv += "_C";
-        rv += m_cNames;
-        for(auto const& op : m_cOps)
-            rv += op.suffix();
+            uint64_t hash() const
+            {
+                // FNV-1a
+                uint64_t rv = 0xcbf29ce484222325ull;
+                for(uint8_t byte : bytes)
+                    rv = (rv ^ byte) * 0x100000001b3ull;
+                return rv;
+            }
+        };
+
+        /**
+         * Process-wide table of operations.  Operations are keyed by
+         * identifier, and also indexed by structural key so that building a
+         * problem whose structure has been seen before formats no strings
+         * and takes no lock.
+         *
+         * An identifier may be given an id before any problem with that
+         * operation is built (e.g. by a library predicate); its names are
+         * filled in by the first such problem.  Nothing is ever freed.
+         */
+        class OperationTable
+        {
+        public:
+            using Operation = ContractionProblem::Operation;
 
-        rv += "_D";
-        rv += m_dNames;
-        for(auto const& op : m_dOps)
-            rv += op.suffix();
+            static OperationTable& Instance()
+            {
+                static OperationTable table;
+                return table;
+            }
+
+            uint32_t id(std::string const& identifier)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return entry(identifier).id;
+            }
+
+            /// Lock-free.
+            Operation const* find(OperationKey const& key, uint64_t hash) const
+            {
+                Index const* index = m_index.load(std::memory_order_acquire);
+
+                for(size_t i = hash & index->mask;; i = (i + 1) & index->mask)
+                {
+                    Node const* node = index->slots[i].load(std::memory_order_acquire);
+                    if(node == nullptr)
+                        return nullptr;
+
+                    if(node->hash == hash && node->key.size() == key.bytes.size()
+                       && std::equal(key.bytes.begin(), key.bytes.end(), node->key.begin()))
+                        return node->operation;
+                }
+            }
+
+            /**
+             * Returns the operation named `operation->identifier`, adding
+             * `operation` if there is none, and indexes it under `key`.
+             */
+            Operation const* insert(OperationKey const&        key,
+                                    uint64_t                   hash,
+                                    std::unique_ptr<Operation> operation)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                auto& e = entry(operation->identifier);
+                if(!e.operation)
+                {
+                    operation->id = e.id;
+                    e.operation   = std::move(operation);
+                }
+
+                if(key.valid && find(key, hash) == nullptr)
+                {
+                    auto node       = std::make_unique<Node>();
+                    node->hash      = hash;
+                    node->key       = std::vector<uint8_t>(key.bytes.begin(), key.bytes.end());
+                    node->operation = e.operation.get();
+
+                    Index const* index = m_index.load(std::memory_order_relaxed);
+                    if((m_nodes.size() + 1) * 2 > index->mask + 1)
+                        index = grow();
+
+                    place(*index, node.get());
+                    m_nodes.push_back(std::move(node));
+                }
+
+                return e.operation.get();
+            }
+
+        private:
+            struct Entry
+            {
+                uint32_t                   id;
+                std::unique_ptr<Operation> operation;
+            };
+
+            struct Node
+            {
+                uint64_t             hash;
+                std::vector<uint8_t> key;
+                Operation const*     operation;
+            };
+
+            // Open-addressed and insert-only.  Replaced by a larger copy when
+            // half full; replaced indexes are kept, as readers may hold them.
+            struct Index
+            {
+                explicit Index(size_t capacity)
+                    : mask(capacity - 1)
+                    , slots(new std::atomic<Node const*>[capacity])
+                {
+                    for(size_t i = 0; i < capacity; i++)
+                        slots[i].store(nullptr, std::memory_order_relaxed);
+                }
+
+                size_t                                      mask;
+                std::unique_ptr<std::atomic<Node const*>[]> slots;
+            };
+
+            OperationTable()
+            {
+                m_indexes.push_back(std::make_unique<Index>(64));
+                m_index.store(m_indexes.back().get(), std::memory_order_release);
+            }
+
+            // Caller holds m_mutex.
+            Entry& entry(std::string const& identifier)
+            {
+                auto iter = m_entries.find(identifier);
+                if(iter == m_entries.end())
+                {
+                    // Id 0 is reserved for default-constructed problems.
+                    uint32_t id = m_entries.size() + 1;
+                    iter        = m_entries.emplace(identifier, Entry{id, nullptr}).first;
+                }
+
+                return iter->second;
+            }
+
+            // Caller holds m_mutex.
+            Index const* grow()
+            {
+                Index const* old = m_index.load(std::memory_order_relaxed);
+
+                m_indexes.push_back(std::make_unique<Index>((old->mask + 1) * 2));
+                Index const* index = m_indexes.back().get();
+
+                for(auto const& node : m_nodes)
+                    place(*index, node.get());
+
+                m_index.store(index, std::memory_order_release);
+                return index;
+            }
+
+            static void place(Index const& index, Node const* node)
+            {
+                size_t i = node->hash & index.mask;
+                while(index.slots[i].load(std::memory_order_relaxed) != nullptr)
+                    i = (i + 1) & index.mask;
 
+                index.slots[i].store(node, std::memory_order_release);
+            }
+
+            std::mutex                          m_mutex;
+            std::map<std::string, Entry>        m_entries;
+            std::atomic<Index const*>           m_index;
+            std::vector<std::unique_ptr<Index>> m_indexes;
+            std::vector<std::unique_ptr<Node>>  m_nodes;
+        };
+    } // namespace
+
+    uint32_t ContractionProblem::OperationId(std::string const& identifier)
+    {
+        return OperationTable::Instance().id(identifier);
+    }
+
+    ContractionProblem::Operation const& ContractionProblem::EmptyOperation()
+    {
+        static Operation const empty;
+        return empty;
+    }
+
+    ContractionProblem::Operation const* ContractionProblem::getOperation() const
+    {
+        OperationKey key;
+
+        for(auto const* tensor : {&m_a, &m_b, &m_c, &m_d})
+            key.add(tensor->dimensions());
+        key.add(m_c.empty() || m_beta == 0.0);
+
+        key.add(m_freeIndices.size());
+        for(auto const& free : m_freeIndices)
+        {
+            key.add(free.isA);
+            key.add(free.i);
+            key.add(free.c);
+            key.add(free.d);
+        }
+
+        key.add(m_batchIndices.size());
+        for(auto const& batch : m_batchIndices)
+        {
+            key.add(batch.a);
+            key.add(batch.b);
+            key.add(batch.c);
+            key.add(batch.d);
+        }
+
+        key.add(m_boundIndices.size());
+        for(auto const& bound : m_boundIndices)
+        {
+            key.add(bound.a);
+            key.add(bound.b);
+            key.add(bound.aMirror);
+            key.add(bound.bMirror);
+        }
+
+        for(auto const* ops : {&m_aOps, &m_bOps, &m_cOps, &m_dOps})
+        {
+            key.add(ops->size());
+            for(auto const& op : *ops)
+                key.add(static_cast<size_t>(op.type));
+        }
+
+        auto&    table = OperationTable::Instance();
+        uint64_t hash  = key.hash();
+        if(key.valid)
+        {
+            if(auto const* operation = table.find(key, hash))
+                return operation;
+        }
+
+        IndexNames aNames, bNames, cNames, dNames, sumNames;
+        getIndexNames(aNames, bNames, cNames, dNames, sumNames);
+
+        std::string identifier = "Contraction_";
+        auto        append     = [&identifier](auto const& names, TensorOps const* ops) {
+            identifier.append(names.begin(), names.end());
+            if(ops)
+                for(auto const& op : *ops)
+                    identifier += op.suffix();
+        };
+
+        append(sumNames, nullptr);
+        identifier += "_A";
+        append(aNames, &m_aOps);
+        identifier += "_B";
+        append(bNames, &m_bOps);
+        identifier += "_C";
+        append(cNames, &m_cOps);
+        identifier += "_D";
+        append(dNames, &m_dOps);
+
+        auto operation        = std::make_unique<Operation>();
+        operation->aNames     = std::string(aNames.begin(), aNames.end());
+        operation->bNames     = std::string(bNames.begin(), bNames.end());
+        operation->cNames     = std::string(cNames.begin(), cNames.end());
+        operation->dNames     = std::string(dNames.begin(), dNames.end());
+        operation->sumNames   = std::string(sumNames.begin(), sumNames.end());
+        operation->identifier = std::move(identifier);
+        operation->fingerprint.add(operation->identifier);
+
+        return table.insert(key, hash, std::move(operation));
+    }
+
+    Fingerprint ContractionProblem::getFingerprint() const
+    {
+        Fingerprint rv = m_operation->fingerprint;
+
+        for(auto const* tensor : {&m_a, &m_b, &m_c, &m_d})
+        {
+            rv.add(static_cast<uint64_t>(tensor->dataType()));
+            rv.add(tensor->sizes().begin(), tensor->sizes().end());
+            rv.add(tensor->strides().begin(), tensor->strides().end());
+            rv.add(tensor->offset());
+        }
+
+        return rv;
+    }
+
+    Fingerprint ContractionProblem::fingerprint() const
+    {
+        uint64_t flags = static_cast<uint64_t>(m_highPrecisionAccumulate)
+                         | static_cast<uint64_t>(m_deterministicMode) << 1
+                         | static_cast<uint64_t>(m_stridedBatched) << 2
+                         | static_cast<uint64_t>(m_fp16AltImpl) << 3
+                         | static_cast<uint64_t>(m_fp16AltImplRound) << 4
+                         | static_cast<uint64_t>(m_kernelLanguage) << 8
+                         | static_cast<uint64_t>(m_arithmeticUnit) << 16
+                         | static_cast<uint64_t>(performanceMetric()) << 24;
+
+        Fingerprint rv = m_fingerprint;
+        rv.add(flags);
+        rv.add(m_workspaceSize);
         return rv;
     }
 
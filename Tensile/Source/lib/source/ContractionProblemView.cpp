@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <Tensile/ContractionProblemView.hpp>
+
+#include <Tensile/ContractionProblem.hpp>
+#include <Tensile/ContractionProblemProperties.hpp>
+
+#include <typeindex>
+#include <unordered_map>
+
+namespace Tensile
+{
+    namespace
+    {
+        using ValueFn = int (*)(Property<ContractionProblem> const&);
+
+        template <typename MyProperty, ContractionProblemView::Value First>
+        int indexedValue(Property<ContractionProblem> const& property)
+        {
+            size_t index = static_cast<MyProperty const&>(property).index;
+            return index < ContractionProblemView::MaxIndex ? First + index : -1;
+        }
+    }
+
+    int ContractionProblemView::PropertyValue(Property<ContractionProblem> const& property)
+    {
+        using namespace Contraction;
+
+        static const std::unordered_map<std::type_index, ValueFn> values
+            = {{typeid(FreeSizeA), indexedValue<FreeSizeA, FreeSizeA0>},
+               {typeid(FreeSizeB), indexedValue<FreeSizeB, FreeSizeB0>},
+               {typeid(BatchSize), indexedValue<BatchSize, BatchSize0>},
+               {typeid(BoundSize), indexedValue<BoundSize, BoundSize0>},
+               {typeid(AStride), indexedValue<AStride, StrideA0>},
+               {typeid(BStride), indexedValue<BStride, StrideB0>},
+               {typeid(CStride), indexedValue<CStride, StrideC0>},
+               {typeid(DStride), indexedValue<DStride, StrideD0>}};
+
+        auto iter = values.find(typeid(property));
+        if(iter == values.end())
+            return -1;
+
+        return iter->second(property);
+    }
+
+    uint64_t ContractionProblemView::compute(uint8_t value) const
+    {
+        ContractionProblem const& problem = m_problem;
+
+        if(value < Free0Size0)
+            return problem.size(value - Size0);
+        if(value < Free1Size0)
+            return !problem.transposeC01() ? problem.freeSizeA(value - Free0Size0)
+                                           : problem.freeSizeB(value - Free0Size0);
+        if(value < FreeSizeA0)
+            return !problem.transposeC01() ? problem.freeSizeB(value - Free1Size0)
+                                           : problem.freeSizeA(value - Free1Size0);
+        if(value < FreeSizeB0)
+            return problem.freeSizeA(value - FreeSizeA0);
+        if(value < BatchSize0)
+            return problem.freeSizeB(value - FreeSizeB0);
+        if(value < BoundSize0)
+            return problem.batchSize(value - BatchSize0);
+        if(value < StrideA0)
+            return problem.boundSize(value - BoundSize0);
+        if(value < StrideB0)
+            return problem.a().strides()[value - StrideA0];
+        if(value < StrideC0)
+            return problem.b().strides()[value - StrideB0];
+        if(value < StrideD0)
+            return problem.c().strides()[value - StrideC0];
+        if(value < ElementBytesA)
+            return problem.d().strides()[value - StrideD0];
+
+        switch(value)
+        {
+        case ElementBytesA:
+            return problem.a().elementBytes();
+        case ElementBytesB:
+            return problem.b().elementBytes();
+        case ElementBytesD:
+            return problem.d().elementBytes();
+        case TypeA:
+            return static_cast<uint64_t>(problem.a().dataType());
+        case TypeB:
+            return static_cast<uint64_t>(problem.b().dataType());
+        case TypeC:
+            return static_cast<uint64_t>(problem.c().dataType());
+        case TypeD:
+            return static_cast<uint64_t>(problem.d().dataType());
+        case HighPrecisionAccumulate:
+            return problem.highPrecisionAccumulate();
+        case DeterministicMode:
+            return problem.deterministicMode();
+        case KernelLanguage:
+            return static_cast<uint64_t>(problem.kernelLanguage());
+        case ArithmeticUnit:
+            return static_cast<uint64_t>(problem.arithmeticUnit());
+        case StridedBatched:
+            return problem.stridedBatched();
+        case PersistentKernelEligible:
+            return problem.getPersistentKernelEligibility();
+        case LeadingFree0Size:
+            return problem.freeIndicesA().size() ? problem.freeSizeA(0) : problem.batchSize(0);
+        case LeadingFree1Size:
+            return problem.freeIndicesB().size() ? problem.freeSizeB(0) : problem.batchSize(0);
+        case ElementsD:
+            return problem.d().totalLogicalElements();
+        case WorkspaceSize:
+            return problem.workspaceSize();
+        }
+
+        throw std::runtime_error(concatenate("Invalid problem value ", int(value)));
+    }
+} // namespace Tensile
@@ -28,6 +28,7 @@
 
 #include <Tensile/AMDGPU.hpp>
 #include <Tensile/ContractionProblem.hpp>
+#include <Tensile/MagicNumber.hpp>
 #include <Tensile/Utils.hpp>
 
 #include <cmath>
@@ -66,106 +67,26 @@ namespace Tensile
         return staggerUIter;
     }
 
-    // Return magic number.  If magicShift is 0, compute and return it.
     uint32_t ContractionSolution::magicNumberAlg1(uint32_t x, uint32_t* magicShift) const
     {
-        uint64_t magicNum;
-        *magicShift = 33;
-        magicNum    = (1L << *magicShift) / x + 1;
-        if((magicNum >> 32) != 0)
-        {
-            *magicShift = 31;
-            magicNum    = (1L << *magicShift) / x + 1;
-        }
-
-        assert(magicNum >> 32 == 0); // ensure magic number fits
-
-        return static_cast<uint32_t>(magicNum);
+        auto magic  = MagicNumberAlg1(x);
+        *magicShift = magic.shift;
+        return magic.value;
     }
 
     uint32_t ContractionSolution::magicNumberAlg2(uint32_t d, uint32_t* magicShift) const
     {
-        struct mu
-        {
-            unsigned M; // Magic number,
-            int      a; // "add" indicator,
-            int      s;
-        }; // and shift amount.
-
-        struct mu magu;
-        if(d == 0)
-        {
-            // Make dividend of 0 return 0
-            magu.M = 0;
-            magu.a = 0;
-            magu.s = 0;
-        }
-        else
-        {
-            // Must have 1 <= d <= 2**32-1.
-            int      p;
-            unsigned nc, delta, q1, r1, q2, r2;
-            magu.a = 0; // Initialize "add" indicator.
-            nc     = -1 - (-d) % d; // Unsigned arithmetic here.
-            p      = 31; // Init. p.
-            q1     = 0x80000000 / nc; // Init. q1 = 2**p/nc.
-            r1     = 0x80000000 - q1 * nc; // Init. r1 = rem(2**p, nc).
-            q2     = 0x7FFFFFFF / d; // Init. q2 = (2**p - 1)/d.
-            r2     = 0x7FFFFFFF - q2 * d; // Init. r2 = rem(2**p - 1, d).
-            do
-            {
-                p = p + 1;
-                if(r1 >= nc - r1)
-                {
-                    q1 = 2 * q1 + 1; // Update q1.
-                    r1 = 2 * r1 - nc;
-                } // Update r1.
-                else
-                {
-                    q1 = 2 * q1;
-                    r1 = 2 * r1;
-                }
-                if(r2 + 1 >= d - r2)
-                {
-                    if(q2 >= 0x7FFFFFFF)
-                        magu.a = 1;
-                    q2 = 2 * q2 + 1; // Update q2.
-                    r2 = 2 * r2 + 1 - d;
-                } // Update r2.
-                else
-                {
-                    if(q2 >= 0x80000000)
-                        magu.a = 1;
-                    q2 = 2 * q2;
-                    r2 = 2 * r2 + 1;
-                }
-                delta = d - 1 - r2;
-            } while(p < 64 && (q1 < delta || (q1 == delta && r1 == 0)));
-
-            magu.M = q2 + 1; // Magic number
-            magu.s = p - 32; // and shift amount to return
-        }
-
-        *magicShift         = magu.s;
-        const uint32_t abit = 0x80000000;
-        if(magu.a)
-            *magicShift |= abit;
-
-        // std::cout << " d=" << d << " M=" << magu.M << " a=" << magu.a << " s=" <<
-        // magu.s << "\n";
-
-        return magu.M;
+        auto magic  = MagicNumberAlg2(d);
+        *magicShift = magic.shift;
+        return magic.value;
     }
 
     uint32_t
         ContractionSolution::magicNumber(int magicDivAlg, uint32_t x, uint32_t* magicShift) const
     {
-        if(magicDivAlg == 1)
-            return magicNumberAlg1(x, magicShift);
-        else if(magicDivAlg == 2)
-            return magicNumberAlg2(x, magicShift);
-        else
-            throw std::runtime_error("bad magicDivAlg");
+        auto magic  = CachedMagicNumber(magicDivAlg, x);
+        *magicShift = magic.shift;
+        return magic.value;
     }
 
     uint32_t ContractionSolution::smallMagicNumber(uint32_t x) const
@@ -249,10 +170,10 @@ namespace Tensile
     }
 
     template <typename TypedInputs, bool T_Debug>
-    KernelInvocation
-        ContractionSolution::generateSingleCall(ContractionSolution::Problem const& problem,
-                                                TypedInputs const&                  inputs,
-                                                Hardware const&                     hardware) const
+    void ContractionSolution::generateSingleCall(ContractionSolution::Problem const& problem,
+                                                 TypedInputs const&                  inputs,
+                                                 Hardware const&                     hardware,
+                                                 KernelInvocation&                   rv) const
     {
         TENSILE_ASSERT_EXC(sizeMapping.workGroupMapping >= 0);
 
@@ -261,9 +182,7 @@ namespace Tensile
         TensorDescriptor const& c = problem.c();
         TensorDescriptor const& d = problem.d();
 
-        KernelInvocation rv;
-
-        rv.args = KernelArguments(T_Debug);
+        rv.args.reset(T_Debug);
 
         rv.args.reserve(1024, 128);
 
@@ -589,9 +508,7 @@ namespace Tensile
             rv.args.append<uint32_t>("pad", 0);
         }
 
-        rv.codeObjectFile = codeObjectFilename.load();
-
-        return rv;
+        codeObjectFilename.load(rv.codeObjectFile);
     }
 
     bool ContractionSolution::isSourceKernel() const
@@ -600,20 +517,19 @@ namespace Tensile
     }
 
     template <typename TypedInputs, bool T_Debug>
-    KernelInvocation ContractionSolution::generateBetaOnlyCall(Problem const&     problem,
-                                                               TypedInputs const& inputs,
-                                                               Hardware const&    hardware) const
+    void ContractionSolution::generateBetaOnlyCall(Problem const&     problem,
+                                                   TypedInputs const& inputs,
+                                                   Hardware const&    hardware,
+                                                   KernelInvocation&  rv) const
     {
         TensorDescriptor const& c = problem.c();
         TensorDescriptor const& d = problem.d();
 
-        KernelInvocation rv;
-
-        rv.args = KernelArguments(T_Debug);
+        rv.args.reset(T_Debug);
 
         rv.args.reserve(512, 64);
 
-        rv.kernelName = betaOnlyKernelName(problem, inputs, hardware);
+        betaOnlyKernelName(problem, inputs, hardware, rv.kernelName);
 
         rv.workGroupSize.x = 256;
         rv.workGroupSize.y = 1;
@@ -683,18 +599,20 @@ namespace Tensile
         rv.args.append<typename TypedInputs::BetaType>("beta", inputs.beta);
 
         //Pass along code object dependency
-        rv.codeObjectFile = codeObjectFilename.load();
-
-        return rv;
+        codeObjectFilename.load(rv.codeObjectFile);
     }
 
     template <typename TypedInputs>
-    std::string ContractionSolution::betaOnlyKernelName(Problem const&     problem,
-                                                        TypedInputs const& inputs,
-                                                        Hardware const&    hardware) const
+    void ContractionSolution::betaOnlyKernelName(Problem const&     problem,
+                                                 TypedInputs const& inputs,
+                                                 Hardware const&    hardware,
+                                                 std::string&       name) const
     {
-        std::string name = concatenate(
-            "C", problem.cNames(), "_", TypeInfo<typename TypedInputs::DType>::Abbrev());
+        // Built in place so that refilling an invocation reuses its storage.
+        name.assign("C");
+        name += problem.cNames();
+        name += "_";
+        name += TypeInfo<typename TypedInputs::DType>::Abbrev();
 
         if(!problemType.stridedBatched)
         {
@@ -705,24 +623,22 @@ namespace Tensile
         {
             name += "_GA";
         }
-
-        return name;
     }
 
     template <typename TypedInputs, bool T_Debug>
-    KernelInvocation ContractionSolution::generateOutputConversionCall(
-        Problem const& problem, TypedInputs const& inputs, Hardware const& hardware) const
+    void ContractionSolution::generateOutputConversionCall(Problem const&     problem,
+                                                           TypedInputs const& inputs,
+                                                           Hardware const&    hardware,
+                                                           KernelInvocation&  rv) const
     {
         TensorDescriptor const& c = problem.c();
         TensorDescriptor const& d = problem.d();
 
-        KernelInvocation rv;
-
-        rv.args = KernelArguments(T_Debug);
+        rv.args.reset(T_Debug);
 
         rv.args.reserve(512, 64);
 
-        rv.kernelName = outputConversionKernelName(problem, inputs, hardware);
+        outputConversionKernelName(problem, inputs, hardware, rv.kernelName);
 
         rv.workGroupSize.x = 256;
         rv.workGroupSize.y = 1;
@@ -797,9 +713,7 @@ namespace Tensile
             rv.args.append<uint32_t>("gsu", sizeMapping.globalSplitU);
 
         //@TODO determine if this is needed, may not end up in the same code object file
-        rv.codeObjectFile = codeObjectFilename.load();
-
-        return rv;
+        codeObjectFilename.load(rv.codeObjectFile);
     }
 
     bool ContractionSolution::canSolve(Problem const& problem, Hardware const& hardware) const
@@ -807,6 +721,19 @@ namespace Tensile
         return (*problemPredicate)(problem) && (*hardwarePredicate)(hardware);
     }
 
+    bool ContractionSolution::canSolve(ContractionProblemView& view, Hardware const& hardware) const
+    {
+        return checkProblemPredicate(view) && (*hardwarePredicate)(hardware);
+    }
+
+    bool ContractionSolution::checkProblemPredicate(ContractionProblemView& view) const
+    {
+        if(!problemProgram.compiledFrom(problemPredicate.get()))
+            return (*problemPredicate)(view.problem());
+
+        return problemProgram(view);
+    }
+
     bool ContractionSolution::matchesProblemType(Problem const&  problem,
                                                  Hardware const& hardware) const
     {
@@ -824,12 +751,15 @@ namespace Tensile
     }
 
     template <typename TypedInputs>
-    std::string ContractionSolution::outputConversionKernelName(Problem const&     problem,
-                                                                TypedInputs const& inputs,
-                                                                Hardware const&    hardware) const
+    void ContractionSolution::outputConversionKernelName(Problem const&     problem,
+                                                         TypedInputs const& inputs,
+                                                         Hardware const&    hardware,
+                                                         std::string&       name) const
     {
-        std::string name = concatenate(
-            "C", problem.cNames(), "_", TypeInfo<typename TypedInputs::DType>::Abbrev());
+        name.assign("C");
+        name += problem.cNames();
+        name += "_";
+        name += TypeInfo<typename TypedInputs::DType>::Abbrev();
 
         if(!problemType.stridedBatched)
         {
@@ -837,192 +767,370 @@ namespace Tensile
         }
 
         name += "_PostGSU";
-
-        return name;
     }
 
-    template <typename TypedInputs>
-    std::vector<KernelInvocation> ContractionSolution::solveTyped(Problem const&     problem,
-                                                                  TypedInputs const& inputs,
-                                                                  Hardware const&    hardware) const
+    namespace
     {
-        bool debug = Debug::Instance().printKernelArguments() || this->kernelArgsLog;
-
-        int boundSize = 1;
-        for(size_t i = 0; i < problem.boundIndices().size(); i++)
-            boundSize *= problem.boundSize(i);
+        template <typename TypedInputs>
+        void CheckInputs(ContractionProblem const& problem, TypedInputs const& inputs)
+        {
+            int boundSize = 1;
+            for(size_t i = 0; i < problem.boundIndices().size(); i++)
+                boundSize *= problem.boundSize(i);
+
+            // Check for nullptrs if alpha is non-zero.
+            bool nonZeroAlpha = inputs.alpha != static_cast<typename TypedInputs::AlphaType>(0);
+            if((nonZeroAlpha && (boundSize != 0))
+               && ((problem.stridedBatched() && (inputs.a == nullptr || inputs.b == nullptr))
+                   || (!problem.stridedBatched()
+                       && (inputs.batchA == nullptr || inputs.batchB == nullptr))))
+            {
+                std::string matrixID = inputs.a == nullptr ? "A" : "B";
+                std::string msg      = std::string("Unsupported nullptr for ") + matrixID
+                                       + std::string(" when (Alpha !=0) && (K != 0)\n");
+                throw std::runtime_error(msg.c_str());
+            }
 
-        // Check for nullptrs if alpha is non-zero.
-        if(((inputs.alpha != static_cast<typename TypedInputs::AlphaType>(0)) && (boundSize != 0))
-           && ((problem.stridedBatched() && (inputs.a == nullptr || inputs.b == nullptr))
-               || (!problem.stridedBatched()
-                   && (inputs.batchA == nullptr || inputs.batchB == nullptr))))
-        {
-            std::string matrixID = inputs.a == nullptr ? "A" : "B";
-            std::string msg      = std::string("Unsupported nullptr for ") + matrixID
-                              + std::string(" when (Alpha !=0) && (K != 0)\n");
-            throw std::runtime_error(msg.c_str());
-        }
+            // Check if alpha matches problem definition
+            if(problem.alphaRestriction() != ScalarValue::Any
+               && problem.alphaRestriction() != toScalarValueEnum(inputs.alpha))
+            {
+                std::stringstream inputValue;
+                inputValue << inputs.alpha;
+                std::string msg = std::string("Alpha value ") + inputValue.str()
+                                  + std::string(" doesn't match that set in problem: ")
+                                  + ToString(problem.alphaRestriction());
+                throw std::runtime_error(msg.c_str());
+            }
 
-        // Check if alpha matches problem definition
-        if(problem.alphaRestriction() != ScalarValue::Any
-           && problem.alphaRestriction() != toScalarValueEnum(inputs.alpha))
-        {
-            std::stringstream inputValue;
-            inputValue << inputs.alpha;
-            std::string msg = std::string("Alpha value ") + inputValue.str()
-                              + std::string(" doesn't match that set in problem: ")
-                              + ToString(problem.alphaRestriction());
-            throw std::runtime_error(msg.c_str());
-        }
+            // Check if beta matches problem definition
+            if(problem.betaRestriction() != ScalarValue::Any
+               && problem.betaRestriction() != toScalarValueEnum(inputs.beta))
+            {
+                std::stringstream inputValue;
+                inputValue << inputs.beta;
+                std::string msg = std::string("Beta value ") + inputValue.str()
+                                  + std::string(" doesn't match that set in problem: ")
+                                  + ToString(problem.betaRestriction());
+                throw std::runtime_error(msg.c_str());
+            }
 
-        // Check if beta matches problem definition
-        if(problem.betaRestriction() != ScalarValue::Any
-           && problem.betaRestriction() != toScalarValueEnum(inputs.beta))
-        {
-            std::stringstream inputValue;
-            inputValue << inputs.beta;
-            std::string msg = std::string("Beta value ") + inputValue.str()
-                              + std::string(" doesn't match that set in problem: ")
-                              + ToString(problem.betaRestriction());
-            throw std::runtime_error(msg.c_str());
-        }
+            if(problem.cEqualsD() && inputs.c != inputs.d)
+                throw std::runtime_error(
+                    "ContractionProblem has cEqualsD set, but pointers for c and d are not equal");
+        }
+
+        /**
+         * Calls `function` with `inputs` cast to the TypedContractionInputs
+         * matching the types of `problem`.
+         */
+        template <typename Function>
+        void VisitTypedInputs(ContractionSolution::ProblemType const& problemType,
+                              ContractionProblem const&               problem,
+                              ContractionInputs const&                inputs,
+                              Function&&                              function)
+        {
+            // retreive alpha/beta type set via setAlpha/BetaType()
+            auto alphaType = problem.alphaType();
+            auto betaType  = problem.betaType();
+
+            // TODO: Some gtests are passing the "problem" without actually defining the
+            // alpha/beta type (alphaType and betaType remain None).
+            // Until we fix those gtests, we need to keep this condition to adjust the missing
+            // alpha/beta data types.
+            if(alphaType == DataType::None)
+            {
+                alphaType
+                    = problemType.aType == DataType::BFloat16 ? DataType::Float : problemType.dType;
+            }
+            if(betaType == DataType::None)
+            {
+                betaType = alphaType;
+            }
 
-        if(problem.cEqualsD() && inputs.c != inputs.d)
-            throw std::runtime_error(
-                "ContractionProblem has cEqualsD set, but pointers for c and d are not equal");
+            auto contractionInputsTypeId = ContractionInputs::TypeId(problemType.aType,
+                                                                     problemType.bType,
+                                                                     problemType.cType,
+                                                                     problemType.dType,
+                                                                     alphaType,
+                                                                     betaType);
 
-        std::vector<KernelInvocation> rv;
+            switch(contractionInputsTypeId)
+            {
+            case ContractionInputs_S_S_S::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_S_S_S const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_D_D_D::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_D_D_D const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_C_C_C::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_C_C_C const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_Z_Z_Z::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_Z_Z_Z const&>(inputs);
+                return function(typedInputs);
+            }
+#ifdef TENSILE_USE_HALF
+            case ContractionInputs_H_H_H::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_H_H_H const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_H_H_S::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_H_H_S const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_H_S_S::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_H_S_S const&>(inputs);
+                return function(typedInputs);
+            }
+#endif // TENSILE_USE_HALF
+            case ContractionInputs_I8x4_I32_I32::TypeId():
+            {
+                auto const& typedInputs
+                    = dynamic_cast<ContractionInputs_I8x4_I32_I32 const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_I32_I32_I32::TypeId():
+            {
+                auto const& typedInputs
+                    = dynamic_cast<ContractionInputs_I32_I32_I32 const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_I8_I32_I32::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_I8_I32_I32 const&>(inputs);
+                return function(typedInputs);
+            }
+#ifdef TENSILE_USE_BF16
+            case ContractionInputs_B_B_S::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_B_B_S const&>(inputs);
+                return function(typedInputs);
+            }
+            case ContractionInputs_B_S_S::TypeId():
+            {
+                auto const& typedInputs = dynamic_cast<ContractionInputs_B_S_S const&>(inputs);
+                return function(typedInputs);
+            }
+#endif // TENSILE_USE_BF16
 
-        if(sizeMapping.globalSplitU > 1 && sizeMapping.globalAccumulation != 2)
-        {
-            if(debug)
-                rv.push_back(generateBetaOnlyCall<TypedInputs, true>(problem, inputs, hardware));
-            else
-                rv.push_back(generateBetaOnlyCall<TypedInputs, false>(problem, inputs, hardware));
+            default:;
+            }
+            throw std::runtime_error("Data type not implemented.");
         }
+    }
+
+    template <typename TypedInputs>
+    void ContractionSolution::solveTyped(Problem const&                 problem,
+                                         TypedInputs const&             inputs,
+                                         Hardware const&                hardware,
+                                         std::vector<KernelInvocation>& rv) const
+    {
+        CheckInputs(problem, inputs);
 
-        if(debug)
-            rv.push_back(generateSingleCall<TypedInputs, true>(problem, inputs, hardware));
+        if(Debug::Instance().printKernelArguments() || this->kernelArgsLog)
+            generateCalls<TypedInputs, true>(problem, inputs, hardware, rv);
         else
-            rv.push_back(generateSingleCall<TypedInputs, false>(problem, inputs, hardware));
+            generateCalls<TypedInputs, false>(problem, inputs, hardware, rv);
+    }
 
-        if(sizeMapping.globalAccumulation)
-        {
-            if(debug)
-                rv.push_back(
-                    generateOutputConversionCall<TypedInputs, true>(problem, inputs, hardware));
-            else
-                rv.push_back(
-                    generateOutputConversionCall<TypedInputs, false>(problem, inputs, hardware));
-        }
+    template <typename TypedInputs, bool T_Debug>
+    void ContractionSolution::generateCalls(Problem const&                 problem,
+                                            TypedInputs const&             inputs,
+                                            Hardware const&                hardware,
+                                            std::vector<KernelInvocation>& rv) const
+    {
+        bool betaOnly   = sizeMapping.globalSplitU > 1 && sizeMapping.globalAccumulation != 2;
+        bool conversion = sizeMapping.globalAccumulation;
 
-        return rv;
+        rv.resize(1 + betaOnly + conversion);
+
+        auto kernel = rv.begin();
+
+        if(betaOnly)
+            generateBetaOnlyCall<TypedInputs, T_Debug>(problem, inputs, hardware, *kernel++);
+
+        generateSingleCall<TypedInputs, T_Debug>(problem, inputs, hardware, *kernel++);
+
+        if(conversion)
+            generateOutputConversionCall<TypedInputs, T_Debug>(
+                problem, inputs, hardware, *kernel++);
     }
 
     std::vector<KernelInvocation>
         ContractionSolution::solve(ContractionSolution::Problem const& problem,
                                    ContractionSolution::Inputs const&  inputs,
                                    Hardware const&                     hardware) const
+    {
+        std::vector<KernelInvocation> rv;
+        solve(problem, inputs, hardware, rv);
+        return rv;
+    }
+
+    void ContractionSolution::solve(ContractionSolution::Problem const& problem,
+                                    ContractionSolution::Inputs const&  inputs,
+                                    Hardware const&                     hardware,
+                                    std::vector<KernelInvocation>&      kernels) const
     {
         if(Debug::Instance().printWinningKernelName())
             std::cout << "Running kernel: " << this->KernelName() << std::endl;
 
-        // retreive alpha/beta type set via setAlpha/BetaType()
-        auto alphaType = problem.alphaType();
-        auto betaType  = problem.betaType();
+        VisitTypedInputs(problemType, problem, inputs, [&](auto const& typedInputs) {
+            solveTyped(problem, typedInputs, hardware, kernels);
+        });
+    }
 
-        // TODO: Some gtests are passing the "problem" without actually defining the
-        // alpha/beta type (alphaType and betaType remain None).
-        // Until we fix those gtests, we need to keep this condition to adjust the missing
-        // alpha/beta data types.
-        if(alphaType == DataType::None)
-        {
-            alphaType
-                = problemType.aType == DataType::BFloat16 ? DataType::Float : problemType.dType;
-        }
-        if(betaType == DataType::None)
-        {
-            betaType = alphaType;
-        }
+    template <typename TypedInputs>
+    void ContractionSolution::PreparedCall::BindTyped(PreparedCall& call, Inputs const& inputs)
+    {
+        auto const& typedInputs = dynamic_cast<TypedInputs const&>(inputs);
 
-        auto contractionInputsTypeId = ContractionInputs::TypeId(problemType.aType,
-                                                                 problemType.bType,
-                                                                 problemType.cType,
-                                                                 problemType.dType,
-                                                                 alphaType,
-                                                                 betaType);
+        CheckInputs(*call.m_problem, typedInputs);
 
-        switch(contractionInputsTypeId)
-        {
-        case ContractionInputs_S_S_S::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_S_S_S const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_D_D_D::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_D_D_D const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_C_C_C::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_C_C_C const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_Z_Z_Z::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_Z_Z_Z const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-#ifdef TENSILE_USE_HALF
-        case ContractionInputs_H_H_H::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_H_H_H const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_H_H_S::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_H_H_S const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_H_S_S::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_H_S_S const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-#endif // TENSILE_USE_HALF
-        case ContractionInputs_I8x4_I32_I32::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_I8x4_I32_I32 const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_I32_I32_I32::TypeId():
+        for(auto const& slot : call.m_slots)
         {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_I32_I32_I32 const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-        case ContractionInputs_I8_I32_I32::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_I8_I32_I32 const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-#ifdef TENSILE_USE_BF16
-        case ContractionInputs_B_B_S::TypeId():
-        {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_B_B_S const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
+            auto& args = call.m_kernels[slot.kernel].args;
+
+            switch(slot.field)
+            {
+            case Field::A:
+                args.overwrite(slot.offset, typedInputs.a);
+                break;
+            case Field::B:
+                args.overwrite(slot.offset, typedInputs.b);
+                break;
+            case Field::C:
+                args.overwrite(slot.offset, typedInputs.c);
+                break;
+            case Field::D:
+                args.overwrite(slot.offset, typedInputs.d);
+                break;
+            case Field::BatchA:
+                args.overwrite(slot.offset, typedInputs.batchA);
+                break;
+            case Field::BatchB:
+                args.overwrite(slot.offset, typedInputs.batchB);
+                break;
+            case Field::BatchC:
+                args.overwrite(slot.offset, typedInputs.batchC);
+                break;
+            case Field::BatchD:
+                args.overwrite(slot.offset, typedInputs.batchD);
+                break;
+            case Field::Workspace:
+                args.overwrite(slot.offset, typedInputs.ws);
+                break;
+            case Field::Alpha:
+                args.overwrite(slot.offset, typedInputs.alpha);
+                break;
+            case Field::Beta:
+                args.overwrite(slot.offset, typedInputs.beta);
+                break;
+            }
         }
-        case ContractionInputs_B_S_S::TypeId():
+    }
+
+    void ContractionSolution::PreparedCall::bind(Inputs const& inputs)
+    {
+        if(m_bind == nullptr)
+            throw std::runtime_error("PreparedCall was not prepared.");
+
+        m_bind(*this, inputs);
+    }
+
+    template <typename TypedInputs>
+    void ContractionSolution::prepareTyped(Problem const&     problem,
+                                           TypedInputs const& inputs,
+                                           Hardware const&    hardware,
+                                           PreparedCall&      rv) const
+    {
+        using Field = PreparedCall::Field;
+
+        solveTyped(problem, inputs, hardware, rv.m_kernels);
+
+        // Offsets come from the argument records, which are only kept when logging.
+        std::vector<KernelInvocation> logged;
+        generateCalls<TypedInputs, true>(problem, inputs, hardware, logged);
+
+        auto addSlots = [&](uint32_t                                             kernel,
+                            std::initializer_list<std::pair<char const*, Field>> fields) {
+            for(auto const& field : fields)
+            {
+                ptrdiff_t offset = logged[kernel].args.offset(field.first);
+                if(offset >= 0)
+                    rv.m_slots.push_back({kernel, static_cast<uint32_t>(offset), field.second});
+            }
+        };
+
+        // Names and order follow generateCalls(); only arguments taken from the inputs.
+        uint32_t kernel = 0;
+
+        if(sizeMapping.globalSplitU > 1 && sizeMapping.globalAccumulation != 2)
+            addSlots(kernel++,
+                     {{"WS", Field::Workspace},
+                      {"D", Field::D},
+                      {"batchD", Field::BatchD},
+                      {"C", Field::C},
+                      {"batchC", Field::BatchC},
+                      {"beta", Field::Beta}});
+
+        addSlots(kernel++,
+                 {{"ws_d", Field::Workspace},
+                  {"ws_c", Field::Workspace},
+                  {"d", Field::D},
+                  {"c", Field::C},
+                  {"batchD", Field::BatchD},
+                  {"batchC", Field::BatchC},
+                  {"a", Field::A},
+                  {"b", Field::B},
+                  {"batchA", Field::BatchA},
+                  {"batchB", Field::BatchB},
+                  {"alpha", Field::Alpha},
+                  {"alpha_2", Field::Alpha},
+                  {"beta", Field::Beta},
+                  {"beta_2", Field::Beta}});
+
+        if(sizeMapping.globalAccumulation)
         {
-            auto const& typedInputs = dynamic_cast<ContractionInputs_B_S_S const&>(inputs);
-            return solveTyped(problem, typedInputs, hardware);
-        }
-#endif // TENSILE_USE_BF16
+            addSlots(kernel++,
+                     {{"D", Field::D},
+                      {"batchD", Field::BatchD},
+                      {"WS", Field::Workspace},
+                      {"C", Field::C},
+                      {"batchC", Field::BatchC}});
 
-        default:;
+            // Otherwise alpha and beta are constants of the conversion.
+            if(sizeMapping.globalAccumulation == 2)
+                addSlots(kernel - 1, {{"alpha", Field::Alpha}});
+            if(sizeMapping.globalAccumulation == 2 && problemType.useBeta)
+                addSlots(kernel - 1, {{"beta", Field::Beta}});
         }
-        throw std::runtime_error("Data type not implemented.");
+
+        rv.m_problem = std::make_shared<Problem const>(problem);
+        rv.m_bind    = &PreparedCall::BindTyped<TypedInputs>;
+    }
+
+    ContractionSolution::PreparedCall ContractionSolution::prepare(Problem const&  problem,
+                                                                   Inputs const&   inputs,
+                                                                   Hardware const& hardware) const
+    {
+        PreparedCall rv;
+
+        VisitTypedInputs(problemType, problem, inputs, [&](auto const& typedInputs) {
+            prepareTyped(problem, typedInputs, hardware, rv);
+        });
+
+        return rv;
     }
 
     ContractionSolution::StaticPerformanceModel
@@ -26,6 +26,10 @@
 
 #include <Tensile/Debug.hpp>
 
+#include <cctype>
+#include <cerrno>
+#include <iostream>
+#include <limits>
 #include <mutex>
 
 #ifndef DEBUG_SM
@@ -153,11 +157,63 @@ namespace Tensile
         return m_solution_index;
     }
 
+    size_t Debug::solutionCacheEntries() const
+    {
+        return m_solutionCacheEntries;
+    }
+
+    size_t Debug::solutionCacheBytes() const
+    {
+        return m_solutionCacheBytes;
+    }
+
+    std::string Debug::solutionCacheFile() const
+    {
+        return m_solutionCacheFile;
+    }
+
     bool Debug::getSolutionSelectionTrace() const
     {
         return m_solselTrace;
     }
 
+    bool Debug::ParseSolutionCacheSize(char const* text, size_t& entries, size_t& bytes)
+    {
+        if(!isdigit(static_cast<unsigned char>(*text)))
+            return false;
+
+        char* suffix = nullptr;
+        errno        = 0;
+        size_t value = strtoull(text, &suffix, 10);
+        if(errno == ERANGE)
+            return false;
+
+        int shift = 0;
+        switch(toupper(static_cast<unsigned char>(*suffix)))
+        {
+        case '\0':
+            entries = value;
+            return true;
+        case 'K':
+            shift = 10;
+            break;
+        case 'M':
+            shift = 20;
+            break;
+        case 'G':
+            shift = 30;
+            break;
+        default:
+            return false;
+        }
+
+        if(suffix[1] != '\0' || value > (std::numeric_limits<size_t>::max() >> shift))
+            return false;
+
+        bytes = value << shift;
+        return true;
+    }
+
     Debug::Debug()
         : m_value(DEBUG_SM)
         , m_value2(DEBUG_SM2)
@@ -193,6 +249,19 @@ namespace Tensile
         const char* tensile_metric = std::getenv("TENSILE_METRIC");
         if(tensile_metric)
             m_metric = tensile_metric;
+
+        // A plain number is an entry count; a K, M or G suffix makes it a
+        // byte count, e.g. TENSILE_SOLUTION_CACHE_SIZE=256M.
+        const char* cache_size = std::getenv("TENSILE_SOLUTION_CACHE_SIZE");
+        if(cache_size
+           && !ParseSolutionCacheSize(cache_size, m_solutionCacheEntries, m_solutionCacheBytes))
+            std::cerr << "Ignoring TENSILE_SOLUTION_CACHE_SIZE=" << cache_size
+                      << ": expected a decimal number, optionally followed by K, M or G."
+                      << std::endl;
+
+        const char* cache_file = std::getenv("TENSILE_SOLUTION_CACHE_FILE");
+        if(cache_file)
+            m_solutionCacheFile = cache_file;
     }
 
 } // namespace Tensile
@@ -60,7 +60,7 @@ namespace Tensile
                 stream << std::hex;
                 for(size_t i = offset; i < offset + size; i++)
                     stream << " " << std::setfill('0') << std::setw(2)
-                           << static_cast<uint32_t>(t.m_data[i]);
+                           << static_cast<uint32_t>(t.bytes()[i]);
                 stream << std::dec;
                 stream.fill(oldFill);
                 stream.width(oldWidth);
@@ -92,10 +92,34 @@ namespace Tensile
 
     void KernelArguments::reserve(size_t bytes, size_t count)
     {
-        m_data.reserve(bytes);
-        m_names.reserve(count);
+        if(bytes > InlineBytes)
+            m_heap.reserve(bytes);
         if(m_log)
+        {
+            m_names.reserve(count);
             m_argRecords.reserve(count);
+        }
+    }
+
+    void KernelArguments::reset(bool log)
+    {
+        m_log  = log;
+        m_size = 0;
+        m_heap.clear();
+        m_names.clear();
+        m_argRecords.clear();
+    }
+
+    ptrdiff_t KernelArguments::offset(std::string const& name) const
+    {
+        if(!m_log)
+            throw std::runtime_error("Argument offsets require logging.");
+
+        auto iter = m_argRecords.find(name);
+        if(iter == m_argRecords.end())
+            return -1;
+
+        return std::get<ArgOffset>(iter->second);
     }
 
     bool KernelArguments::isFullyBound() const
@@ -117,12 +141,12 @@ namespace Tensile
         if(!isFullyBound())
             throw std::runtime_error("Arguments not fully bound.");
 
-        return reinterpret_cast<void const*>(m_data.data());
+        return reinterpret_cast<void const*>(bytes());
     }
 
     size_t KernelArguments::size() const
     {
-        return m_data.size();
+        return m_size;
     }
 
     KernelArguments::const_iterator::const_iterator(KernelArguments const& args)
@@ -229,7 +253,7 @@ namespace Tensile
             }
 
             m_value = std::make_pair(
-                static_cast<void const*>(m_args.m_data.data()
+                static_cast<void const*>(m_args.bytes()
                                          + std::get<KernelArguments::ArgOffset>(record)),
                 (size_t)std::get<KernelArguments::ArgSize>(record));
         }
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <Tensile/MagicNumber.hpp>
+
+#include <array>
+#include <stdexcept>
+
+namespace Tensile
+{
+    namespace
+    {
+        using MagicNumberTable = std::array<MagicNumber, MagicNumberTableSize>;
+
+        template <MagicNumber (*Algorithm)(uint32_t)>
+        constexpr MagicNumberTable MakeTable()
+        {
+            MagicNumberTable rv{};
+            // Algorithm 1 is undefined for 0, which is never read from the table.
+            for(uint32_t x = 1; x < MagicNumberTableSize; x++)
+                rv[x] = Algorithm(x);
+            return rv;
+        }
+
+        constexpr MagicNumberTable Alg1Table = MakeTable<MagicNumberAlg1>();
+        constexpr MagicNumberTable Alg2Table = MakeTable<MagicNumberAlg2>();
+
+        /// Direct-mapped, so a lookup is one compare; a collision evicts the older divisor.
+        constexpr size_t CacheBits = 8;
+
+        struct CacheEntry
+        {
+            uint32_t    divisor = 0;
+            MagicNumber magic;
+        };
+
+        using Cache = std::array<CacheEntry, size_t(1) << CacheBits>;
+
+        MagicNumber CachedAlg2(Cache& cache, uint32_t x)
+        {
+            // Table divisors never reach the cache, so a divisor of 0 marks an empty entry.
+            auto& entry = cache[(x * 0x9E3779B1u) >> (32 - CacheBits)];
+            if(entry.divisor != x)
+            {
+                entry.divisor = x;
+                entry.magic   = MagicNumberAlg2(x);
+            }
+
+            return entry.magic;
+        }
+    }
+
+    MagicNumber CachedMagicNumber(int magicDivAlg, uint32_t x)
+    {
+        if(magicDivAlg == 1)
+        {
+            // Past the table this is a single division, cheaper than a cache lookup.
+            if(x != 0 && x < MagicNumberTableSize)
+                return Alg1Table[x];
+            return MagicNumberAlg1(x);
+        }
+        else if(magicDivAlg == 2)
+        {
+            if(x < MagicNumberTableSize)
+                return Alg2Table[x];
+
+            thread_local Cache alg2Cache;
+            return CachedAlg2(alg2Cache, x);
+        }
+        else
+            throw std::runtime_error("bad magicDivAlg");
+    }
+} // namespace Tensile
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/MappedFile.hpp>
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Tensile
+{
+    MappedFile::MappedFile(std::string const& filename)
+    {
+#ifndef _WIN32
+        int fd = open(filename.c_str(), O_RDONLY);
+        if(fd < 0)
+            return;
+
+        struct stat info;
+        if(fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            void* addr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr != MAP_FAILED)
+            {
+                m_data   = static_cast<uint8_t const*>(addr);
+                m_size   = info.st_size;
+                m_mapped = true;
+            }
+        }
+
+        close(fd);
+
+        if(m_mapped)
+            return;
+#endif
+
+        std::ifstream in(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if(!in.is_open())
+            return;
+
+        m_buffer.resize(in.tellg());
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size());
+
+        if(in && !m_buffer.empty())
+        {
+            m_data = m_buffer.data();
+            m_size = m_buffer.size();
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifndef _WIN32
+        if(m_mapped)
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+} // namespace Tensile
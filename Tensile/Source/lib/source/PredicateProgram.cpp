@@ -0,0 +1,630 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+
+#include <Tensile/PredicateProgram.hpp>
+
+#include <Tensile/ContractionProblem.hpp>
+#include <Tensile/ContractionProblemPredicates.hpp>
+
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+
+namespace Tensile
+{
+    namespace Predicates
+    {
+        namespace Contraction
+        {
+            namespace
+            {
+                /// Predicates with a compiled form.
+                enum class Kind
+                {
+                    True,
+                    False,
+                    And,
+                    Or,
+                    Not,
+                    Free0SizeMultiple,
+                    Free1SizeMultiple,
+                    BatchSizeMultiple,
+                    BatchSizeEqual,
+                    BoundSizeMultiple,
+                    SizeEqual,
+                    SizeGreaterThan,
+                    SizeLessThan,
+                    SizeMultiple,
+                    SizeInRange,
+                    LeadingFree0SizesGreaterOrEqual,
+                    LeadingFree1SizesGreaterOrEqual,
+                    StrideAEqual,
+                    StrideBEqual,
+                    StrideCEqual,
+                    StrideDEqual,
+                    LDCEqualsLDD,
+                    HighPrecisionAccumulateEqual,
+                    KernelLanguageCompatible,
+                    DeterministicModeEqual,
+                    ArithmeticUnitCompatible,
+                    TypesEqual,
+                    OperationIdentifierEqual,
+                    BufferLoadOffsetLimitCheck,
+                    BufferStoreOffsetLimitCheck,
+                    WorkspaceCheck,
+                    PersistentKernelCheck,
+                    GlobalSplitUCheckMinK,
+                    StridedBatchedEqual
+                };
+
+                bool findKind(Predicate<ContractionProblem> const& predicate, Kind& kind)
+                {
+                    using Problem = ContractionProblem;
+
+                    static const std::unordered_map<std::type_index, Kind> kinds = {
+                        {typeid(True<Problem>), Kind::True},
+                        {typeid(False<Problem>), Kind::False},
+                        {typeid(And<Problem>), Kind::And},
+                        {typeid(Or<Problem>), Kind::Or},
+                        {typeid(Not<Problem>), Kind::Not},
+                        {typeid(Free0SizeMultiple), Kind::Free0SizeMultiple},
+                        {typeid(Free1SizeMultiple), Kind::Free1SizeMultiple},
+                        {typeid(BatchSizeMultiple), Kind::BatchSizeMultiple},
+                        {typeid(BatchSizeEqual), Kind::BatchSizeEqual},
+                        {typeid(BoundSizeMultiple), Kind::BoundSizeMultiple},
+                        {typeid(SizeEqual), Kind::SizeEqual},
+                        {typeid(SizeGreaterThan), Kind::SizeGreaterThan},
+                        {typeid(SizeLessThan), Kind::SizeLessThan},
+                        {typeid(SizeMultiple), Kind::SizeMultiple},
+                        {typeid(SizeInRange), Kind::SizeInRange},
+                        {typeid(LeadingFree0SizesGreaterOrEqual),
+                         Kind::LeadingFree0SizesGreaterOrEqual},
+                        {typeid(LeadingFree1SizesGreaterOrEqual),
+                         Kind::LeadingFree1SizesGreaterOrEqual},
+                        {typeid(StrideAEqual), Kind::StrideAEqual},
+                        {typeid(StrideBEqual), Kind::StrideBEqual},
+                        {typeid(StrideCEqual), Kind::StrideCEqual},
+                        {typeid(StrideDEqual), Kind::StrideDEqual},
+                        {typeid(LDCEqualsLDD), Kind::LDCEqualsLDD},
+                        {typeid(HighPrecisionAccumulateEqual), Kind::HighPrecisionAccumulateEqual},
+                        {typeid(KernelLanguageCompatible), Kind::KernelLanguageCompatible},
+                        {typeid(DeterministicModeEqual), Kind::DeterministicModeEqual},
+                        {typeid(ArithmeticUnitCompatible), Kind::ArithmeticUnitCompatible},
+                        {typeid(TypesEqual), Kind::TypesEqual},
+                        {typeid(OperationIdentifierEqual), Kind::OperationIdentifierEqual},
+                        {typeid(BufferLoadOffsetLimitCheck), Kind::BufferLoadOffsetLimitCheck},
+                        {typeid(BufferStoreOffsetLimitCheck), Kind::BufferStoreOffsetLimitCheck},
+                        {typeid(WorkspaceCheck), Kind::WorkspaceCheck},
+                        {typeid(PersistentKernelCheck), Kind::PersistentKernelCheck},
+                        {typeid(GlobalSplitUCheckMinK), Kind::GlobalSplitUCheckMinK},
+                        {typeid(StridedBatchedEqual), Kind::StridedBatchedEqual}};
+
+                    auto iter = kinds.find(typeid(predicate));
+                    if(iter == kinds.end())
+                        return false;
+
+                    kind = iter->second;
+                    return true;
+                }
+            }
+
+            /**
+             * Emits checks successor-first: each predicate is compiled once the
+             * checks it branches to already exist, so every jump goes to a lower
+             * index until Compile() reverses the list.
+             */
+            struct Program::Compiler
+            {
+                using PredicatePtr = std::shared_ptr<Predicate<ContractionProblem>>;
+                using PV           = ContractionProblemView;
+
+                Program& program;
+
+                int32_t emit(Op       op,
+                             uint8_t  value,
+                             uint8_t  value2,
+                             uint64_t a,
+                             uint64_t b,
+                             int32_t  onTrue,
+                             int32_t  onFalse)
+                {
+                    program.m_checks.push_back(Check{op, value, value2, {onFalse, onTrue}, a, b});
+                    return program.m_checks.size() - 1;
+                }
+
+                int32_t emit(Op op, uint8_t value, uint64_t a, int32_t onTrue, int32_t onFalse)
+                {
+                    return emit(op, value, 0, a, 0, onTrue, onFalse);
+                }
+
+                int32_t call(PredicatePtr const& predicate, int32_t onTrue, int32_t onFalse)
+                {
+                    program.m_calls.push_back(predicate);
+                    return emit(Op::Call, 0, program.m_calls.size() - 1, onTrue, onFalse);
+                }
+
+                /// Emits `op` on value `first + index`, or a call if `index` has no value.
+                int32_t indexed(Op                  op,
+                                uint8_t             first,
+                                size_t              index,
+                                size_t              count,
+                                uint64_t            a,
+                                PredicatePtr const& predicate,
+                                int32_t             onTrue,
+                                int32_t             onFalse)
+                {
+                    if(index >= count)
+                        return call(predicate, onTrue, onFalse);
+
+                    return emit(op, first + index, a, onTrue, onFalse);
+                }
+
+                /// value % divisor == 0; a zero divisor is left to the predicate object.
+                int32_t multiple(uint8_t             first,
+                                 size_t              index,
+                                 size_t              count,
+                                 uint64_t            divisor,
+                                 PredicatePtr const& predicate,
+                                 int32_t             onTrue,
+                                 int32_t             onFalse)
+                {
+                    if(divisor == 0)
+                        return call(predicate, onTrue, onFalse);
+
+                    return indexed(Op::Multiple,
+                                   first,
+                                   index,
+                                   count,
+                                   divisor,
+                                   predicate,
+                                   onTrue,
+                                   onFalse);
+                }
+
+                int32_t compile(PredicatePtr const& predicate, int32_t onTrue, int32_t onFalse)
+                {
+                    Kind kind;
+                    if(!findKind(*predicate, kind))
+                        return call(predicate, onTrue, onFalse);
+
+                    auto const& p = *predicate;
+
+                    switch(kind)
+                    {
+                    case Kind::True:
+                        return onTrue;
+                    case Kind::False:
+                        return onFalse;
+                    case Kind::And:
+                    {
+                        auto const& terms = static_cast<And<ContractionProblem> const&>(p).value;
+                        int32_t     entry = onTrue;
+                        for(auto iter = terms.rbegin(); iter != terms.rend(); iter++)
+                            entry = compile(*iter, entry, onFalse);
+                        return entry;
+                    }
+                    case Kind::Or:
+                    {
+                        auto const& terms = static_cast<Or<ContractionProblem> const&>(p).value;
+                        int32_t     entry = onFalse;
+                        for(auto iter = terms.rbegin(); iter != terms.rend(); iter++)
+                            entry = compile(*iter, onTrue, entry);
+                        return entry;
+                    }
+                    case Kind::Not:
+                        return compile(
+                            static_cast<Not<ContractionProblem> const&>(p).value, onFalse, onTrue);
+                    case Kind::Free0SizeMultiple:
+                    {
+                        auto const& q = static_cast<Free0SizeMultiple const&>(p);
+                        return multiple(PV::Free0Size0,
+                                        q.index,
+                                        PV::MaxIndex,
+                                        q.value,
+                                        predicate,
+                                        onTrue,
+                                        onFalse);
+                    }
+                    case Kind::Free1SizeMultiple:
+                    {
+                        auto const& q = static_cast<Free1SizeMultiple const&>(p);
+                        return multiple(PV::Free1Size0,
+                                        q.index,
+                                        PV::MaxIndex,
+                                        q.value,
+                                        predicate,
+                                        onTrue,
+                                        onFalse);
+                    }
+                    case Kind::BatchSizeMultiple:
+                    {
+                        auto const& q = static_cast<BatchSizeMultiple const&>(p);
+                        return multiple(PV::BatchSize0,
+                                        q.index,
+                                        PV::MaxIndex,
+                                        q.value,
+                                        predicate,
+                                        onTrue,
+                                        onFalse);
+                    }
+                    case Kind::BatchSizeEqual:
+                    {
+                        auto const& q = static_cast<BatchSizeEqual const&>(p);
+                        return indexed(Op::Equal,
+                                       PV::BatchSize0,
+                                       q.index,
+                                       PV::MaxIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::BoundSizeMultiple:
+                    {
+                        // Negative indices count from the last bound index.
+                        auto const& q = static_cast<BoundSizeMultiple const&>(p);
+                        if(q.index < 0)
+                            return call(predicate, onTrue, onFalse);
+                        return multiple(PV::BoundSize0,
+                                        q.index,
+                                        PV::MaxIndex,
+                                        q.value,
+                                        predicate,
+                                        onTrue,
+                                        onFalse);
+                    }
+                    case Kind::SizeEqual:
+                    {
+                        auto const& q = static_cast<SizeEqual const&>(p);
+                        return indexed(Op::Equal,
+                                       PV::Size0,
+                                       q.index,
+                                       PV::MaxSizeIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::SizeGreaterThan:
+                    {
+                        auto const& q = static_cast<SizeGreaterThan const&>(p);
+                        return indexed(Op::Greater,
+                                       PV::Size0,
+                                       q.index,
+                                       PV::MaxSizeIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::SizeLessThan:
+                    {
+                        auto const& q = static_cast<SizeLessThan const&>(p);
+                        return indexed(Op::Less,
+                                       PV::Size0,
+                                       q.index,
+                                       PV::MaxSizeIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::SizeMultiple:
+                    {
+                        auto const& q = static_cast<SizeMultiple const&>(p);
+                        return multiple(PV::Size0,
+                                        q.index,
+                                        PV::MaxSizeIndex,
+                                        q.value,
+                                        predicate,
+                                        onTrue,
+                                        onFalse);
+                    }
+                    case Kind::SizeInRange:
+                    {
+                        auto const& q = static_cast<SizeInRange const&>(p);
+                        if(q.index >= PV::MaxSizeIndex)
+                            return call(predicate, onTrue, onFalse);
+                        return emit(Op::InRange,
+                                    PV::Size0 + q.index,
+                                    0,
+                                    q.value.min,
+                                    q.value.max,
+                                    onTrue,
+                                    onFalse);
+                    }
+                    case Kind::LeadingFree0SizesGreaterOrEqual:
+                        return emit(Op::GreaterEqual,
+                                    PV::LeadingFree0Size,
+                                    static_cast<LeadingFree0SizesGreaterOrEqual const&>(p).value,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::LeadingFree1SizesGreaterOrEqual:
+                        return emit(Op::GreaterEqual,
+                                    PV::LeadingFree1Size,
+                                    static_cast<LeadingFree1SizesGreaterOrEqual const&>(p).value,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::StrideAEqual:
+                    {
+                        auto const& q = static_cast<StrideAEqual const&>(p);
+                        return indexed(Op::Equal,
+                                       PV::StrideA0,
+                                       q.index,
+                                       PV::MaxIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::StrideBEqual:
+                    {
+                        auto const& q = static_cast<StrideBEqual const&>(p);
+                        return indexed(Op::Equal,
+                                       PV::StrideB0,
+                                       q.index,
+                                       PV::MaxIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::StrideCEqual:
+                    {
+                        auto const& q = static_cast<StrideCEqual const&>(p);
+                        return indexed(Op::Equal,
+                                       PV::StrideC0,
+                                       q.index,
+                                       PV::MaxIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::StrideDEqual:
+                    {
+                        auto const& q = static_cast<StrideDEqual const&>(p);
+                        return indexed(Op::Equal,
+                                       PV::StrideD0,
+                                       q.index,
+                                       PV::MaxIndex,
+                                       q.value,
+                                       predicate,
+                                       onTrue,
+                                       onFalse);
+                    }
+                    case Kind::LDCEqualsLDD:
+                        return emit(Op::EqualValues,
+                                    PV::StrideC0 + 1,
+                                    PV::StrideD0 + 1,
+                                    0,
+                                    0,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::HighPrecisionAccumulateEqual:
+                        return emit(Op::Equal,
+                                    PV::HighPrecisionAccumulate,
+                                    static_cast<HighPrecisionAccumulateEqual const&>(p).value,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::KernelLanguageCompatible:
+                        return emit(Op::EqualOrAny,
+                                    PV::KernelLanguage,
+                                    0,
+                                    static_cast<uint64_t>(
+                                        static_cast<KernelLanguageCompatible const&>(p).value),
+                                    static_cast<uint64_t>(KernelLanguage::Any),
+                                    onTrue,
+                                    onFalse);
+                    case Kind::DeterministicModeEqual:
+                        return emit(Op::Equal,
+                                    PV::DeterministicMode,
+                                    static_cast<DeterministicModeEqual const&>(p).value,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::ArithmeticUnitCompatible:
+                        return emit(Op::EqualOrAny,
+                                    PV::ArithmeticUnit,
+                                    0,
+                                    static_cast<uint64_t>(
+                                        static_cast<ArithmeticUnitCompatible const&>(p).value),
+                                    static_cast<uint64_t>(ArithmeticUnit::Any),
+                                    onTrue,
+                                    onFalse);
+                    case Kind::TypesEqual:
+                    {
+                        auto const& types = static_cast<TypesEqual const&>(p).value;
+                        int32_t     entry = onTrue;
+                        for(int i = 3; i >= 0; i--)
+                            entry = emit(Op::Equal,
+                                         PV::TypeA + i,
+                                         static_cast<uint64_t>(types[i]),
+                                         entry,
+                                         onFalse);
+                        return entry;
+                    }
+                    case Kind::OperationIdentifierEqual:
+                    {
+                        auto const& identifier
+                            = static_cast<OperationIdentifierEqual const&>(p).value;
+                        return emit(Op::OperationIdentifier,
+                                    0,
+                                    ContractionProblem::OperationId(identifier),
+                                    onTrue,
+                                    onFalse);
+                    }
+                    case Kind::BufferLoadOffsetLimitCheck:
+                    {
+                        auto const& q     = static_cast<BufferLoadOffsetLimitCheck const&>(p).value;
+                        int32_t     entry = emit(Op::OffsetBelow4G,
+                                             PV::StrideB0 + 1,
+                                             PV::ElementBytesB,
+                                             q.depthUorMT1,
+                                             q.shiftPtrElemB,
+                                             onTrue,
+                                             onFalse);
+                        return emit(Op::OffsetBelow4G,
+                                    PV::StrideA0 + 1,
+                                    PV::ElementBytesA,
+                                    q.depthUorMT0,
+                                    q.shiftPtrElemA,
+                                    entry,
+                                    onFalse);
+                    }
+                    case Kind::BufferStoreOffsetLimitCheck:
+                        return emit(Op::OffsetBelow4G,
+                                    PV::StrideD0 + 1,
+                                    PV::ElementBytesD,
+                                    static_cast<BufferStoreOffsetLimitCheck const&>(p).value,
+                                    0,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::WorkspaceCheck:
+                        return emit(Op::ScaledAtMost,
+                                    PV::ElementsD,
+                                    PV::WorkspaceSize,
+                                    static_cast<WorkspaceCheck const&>(p).value,
+                                    0,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::PersistentKernelCheck:
+                        return emit(Op::Equal, PV::PersistentKernelEligible, 1, onTrue, onFalse);
+                    case Kind::GlobalSplitUCheckMinK:
+                        return emit(Op::GreaterEqual,
+                                    PV::BoundSize0,
+                                    static_cast<GlobalSplitUCheckMinK const&>(p).value,
+                                    onTrue,
+                                    onFalse);
+                    case Kind::StridedBatchedEqual:
+                        return emit(Op::Equal,
+                                    PV::StridedBatched,
+                                    static_cast<StridedBatchedEqual const&>(p).value,
+                                    onTrue,
+                                    onFalse);
+                    }
+
+                    return call(predicate, onTrue, onFalse);
+                }
+            };
+
+            Program
+                Program::Compile(std::shared_ptr<Predicate<ContractionProblem>> const& predicate)
+            {
+                Program rv;
+                if(!predicate)
+                    return rv;
+
+                Compiler compiler{rv};
+                int32_t  entry = compiler.compile(predicate, Accept, Reject);
+
+                int32_t last  = rv.m_checks.size() - 1;
+                auto    remap = [last](int32_t index) { return index < 0 ? index : last - index; };
+
+                std::reverse(rv.m_checks.begin(), rv.m_checks.end());
+                for(auto& check : rv.m_checks)
+                {
+                    check.next[0] = remap(check.next[0]);
+                    check.next[1] = remap(check.next[1]);
+                }
+
+                rv.m_entry  = remap(entry);
+                rv.m_source = predicate;
+
+                return rv;
+            }
+
+            bool Program::operator()(ContractionProblemView& view) const
+            {
+                const uint64_t TWO_POW_32 = 4294967296;
+
+                int32_t index = m_entry;
+                while(index >= 0)
+                {
+                    Check const& check = m_checks[index];
+
+                    bool pass = false;
+                    switch(check.op)
+                    {
+                    case Op::Equal:
+                        pass = view.get(check.value) == check.a;
+                        break;
+                    case Op::Greater:
+                        pass = view.get(check.value) > check.a;
+                        break;
+                    case Op::GreaterEqual:
+                        pass = view.get(check.value) >= check.a;
+                        break;
+                    case Op::Less:
+                        pass = view.get(check.value) < check.a;
+                        break;
+                    case Op::InRange:
+                    {
+                        uint64_t value = view.get(check.value);
+                        pass           = value >= check.a && value < check.b;
+                        break;
+                    }
+                    case Op::Multiple:
+                        pass = view.get(check.value) % check.a == 0;
+                        break;
+                    case Op::EqualOrAny:
+                    {
+                        uint64_t value = view.get(check.value);
+                        pass           = value == check.a || value == check.b;
+                        break;
+                    }
+                    case Op::EqualValues:
+                        pass = view.get(check.value) == view.get(check.value2);
+                        break;
+                    case Op::OffsetBelow4G:
+                        pass = (view.get(check.value) * check.a + check.b)
+                                   * view.get(check.value2)
+                               < TWO_POW_32;
+                        break;
+                    case Op::ScaledAtMost:
+                        pass = view.get(check.value) * check.a <= view.get(check.value2);
+                        break;
+                    case Op::OperationIdentifier:
+                        pass = view.problem().operationId() == check.a;
+                        break;
+                    case Op::Call:
+                        pass = (*m_calls[check.a])(view.problem());
+                        break;
+                    }
+
+                    // A branch rather than `next[pass]`: most checks have a predictable
+                    // outcome, so the next check can start before this one resolves.
+                    if(pass)
+                        index = check.next[1];
+                    else
+                        index = check.next[0];
+                }
+
+                return index == Accept;
+            }
+        } // namespace Contraction
+    } // namespace Predicates
+} // namespace Tensile
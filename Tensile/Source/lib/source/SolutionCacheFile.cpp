@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (C) 2022 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <Tensile/SolutionCacheFile.hpp>
+
+#include <Tensile/Utils.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include <sys/stat.h>
+
+namespace Tensile
+{
+    static char const SolutionCacheMagic[8] = {'T', 'N', 'S', 'L', 'S', 'C', 'F', '\0'};
+
+    SolutionCacheFile::SolutionCacheFile(std::string const& filename, uint64_t libraryHash)
+        : m_filename(filename)
+        , m_libraryHash(libraryHash)
+        , m_file(std::make_unique<MappedFile>(filename))
+    {
+        if(!m_file->valid() || m_file->size() < sizeof(Header))
+            return;
+
+        auto header = reinterpret_cast<Header const*>(m_file->data());
+
+        if(std::memcmp(header->magic, SolutionCacheMagic, sizeof(SolutionCacheMagic)) != 0
+           || header->version != FormatVersion || header->recordSize != sizeof(Record)
+           || header->libraryHash != libraryHash || header->capacity == 0
+           || (header->capacity & (header->capacity - 1)) != 0
+           || m_file->size() != sizeof(Header) + header->capacity * sizeof(Record))
+            return;
+
+        m_header  = header;
+        m_records = reinterpret_cast<Record const*>(m_file->data() + sizeof(Header));
+    }
+
+    uint64_t SolutionCacheFile::LibraryHash(std::string const& libraryFile,
+                                            std::string const& version,
+                                            size_t             solutionCount)
+    {
+        Fingerprint rv;
+        rv.add(libraryFile);
+        rv.add(version);
+        rv.add(solutionCount);
+
+        struct stat info;
+        if(stat(libraryFile.c_str(), &info) == 0)
+        {
+            rv.add(info.st_size);
+            rv.add(info.st_mtime);
+        }
+
+        return rv.lo ^ rv.hi;
+    }
+
+    SolutionCacheFile::Record SolutionCacheFile::MakeRecord(Fingerprint const& problem,
+                                                            AMDGPU const&      hardware,
+                                                            int64_t            solutionIndex,
+                                                            double             fitness,
+                                                            int32_t            placeholder)
+    {
+        return Record{problem.lo,
+                      problem.hi,
+                      static_cast<uint32_t>(hardware.processor),
+                      static_cast<uint32_t>(hardware.computeUnitCount),
+                      solutionIndex,
+                      fitness,
+                      placeholder,
+                      0};
+    }
+
+    size_t SolutionCacheFile::Slot(Record const& record)
+    {
+        return Fingerprint::mix(record.fingerprintLo
+                                ^ (static_cast<uint64_t>(record.processor) << 32
+                                   | record.computeUnitCount));
+    }
+
+    SolutionCacheFile::Record const* SolutionCacheFile::find(Fingerprint const& problem,
+                                                             AMDGPU const&      hardware) const
+    {
+        if(m_header == nullptr)
+            return nullptr;
+
+        Record key  = MakeRecord(problem, hardware, -1, 0.0);
+        size_t mask = m_header->capacity - 1;
+
+        for(size_t i = Slot(key) & mask, probes = 0; probes <= mask; i = (i + 1) & mask, probes++)
+        {
+            Record const& record = m_records[i];
+
+            if(record.solutionIndex < 0)
+                return nullptr;
+
+            if(record.fingerprintLo == key.fingerprintLo
+               && record.fingerprintHi == key.fingerprintHi && record.processor == key.processor
+               && record.computeUnitCount == key.computeUnitCount)
+                return &record;
+        }
+
+        return nullptr;
+    }
+
+    std::vector<SolutionCacheFile::Record> SolutionCacheFile::records() const
+    {
+        std::vector<Record> rv;
+
+        if(m_header == nullptr)
+            return rv;
+
+        rv.reserve(m_header->count);
+        for(size_t i = 0; i < m_header->capacity; i++)
+        {
+            if(m_records[i].solutionIndex >= 0)
+                rv.push_back(m_records[i]);
+        }
+
+        return rv;
+    }
+
+    size_t SolutionCacheFile::size() const
+    {
+        return m_header ? m_header->count : 0;
+    }
+
+    bool SolutionCacheFile::Write(std::string const&         filename,
+                                  uint64_t                   libraryHash,
+                                  std::vector<Record> const& records)
+    {
+        size_t capacity = 16;
+        while(capacity < records.size() * 2)
+            capacity *= 2;
+
+        std::vector<Record> table(capacity, Record{0, 0, 0, 0, -1, 0.0, -1, 0});
+        size_t              mask = capacity - 1;
+
+        for(auto const& record : records)
+        {
+            size_t i = Slot(record) & mask;
+            while(table[i].solutionIndex >= 0)
+                i = (i + 1) & mask;
+
+            table[i] = record;
+        }
+
+        Header header;
+        std::memcpy(header.magic, SolutionCacheMagic, sizeof(SolutionCacheMagic));
+        header.version     = FormatVersion;
+        header.recordSize  = sizeof(Record);
+        header.libraryHash = libraryHash;
+        header.capacity    = capacity;
+        header.count       = records.size();
+
+        std::string tmpName
+            = concatenate(filename, ".", std::chrono::steady_clock::now().time_since_epoch().count());
+
+        {
+            std::ofstream out(tmpName, std::ios::out | std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+            out.write(reinterpret_cast<char const*>(table.data()), table.size() * sizeof(Record));
+
+            if(!out)
+            {
+                out.close();
+                std::remove(tmpName.c_str());
+                return false;
+            }
+        }
+
+        if(std::rename(tmpName.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(tmpName.c_str());
+            return false;
+        }
+
+        return true;
+    }
+} // namespace Tensile
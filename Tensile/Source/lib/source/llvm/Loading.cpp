@@ -45,6 +45,14 @@ namespace Tensile
         try
         {
             auto inputFile = llvm::MemoryBuffer::getFile(filename);
+            if(!inputFile)
+            {
+                if(Debug::Instance().printDataInit())
+                    std::cout << "Error loading " << filename << " (YAML):" << std::endl
+                              << inputFile.getError().message() << std::endl;
+
+                return nullptr;
+            }
 
             LibraryIOContext<MySolution> context{filename, preloaded, nullptr};
             llvm::yaml::Input            yin((*inputFile)->getMemBufferRef(), &context);
@@ -55,6 +63,8 @@ namespace Tensile
             {
                 return nullptr;
             }
+
+            rv->preload(context);
         }
         catch(std::runtime_error const& exc)
         {
@@ -86,6 +96,8 @@ namespace Tensile
             {
                 throw std::runtime_error(yin.error().message());
             }
+
+            rv->preload(context);
         }
         catch(std::runtime_error const& exc)
         {
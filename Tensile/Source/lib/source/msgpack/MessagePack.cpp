@@ -139,6 +139,8 @@ namespace Tensile
                 throw std::runtime_error(msg.str());
             }
 
+            rv->preload(context);
+
             return rv;
         }
         catch(std::runtime_error const& exc)
@@ -175,6 +177,8 @@ namespace Tensile
                 throw std::runtime_error(msg.str());
             }
 
+            rv->preload(context);
+
             return rv;
         }
         catch(std::runtime_error const& exc)